@@ -0,0 +1,378 @@
+/*
+  envelopeBench.cpp - ssbEnvelope against the float envelope code the
+    ssbMonoADSR patches carried before it (map_float, do_attack_inc,
+    do_decay_dec, do_release_dec and envelope_state, copied below as they
+    were).
+
+    Checks:
+      - Both give the same envelope shape for every control value 0 - 1023
+        (attack, decay and release on the same knob) and for mixed knobs:
+        the same peak and sustain level, and back to 0 after the gate. The
+        stage times differ, ssbEnvelope times them in ms, the float code
+        moved a fixed amount a loop.
+    Reports the host time of a loop's envelope work for each, as a ratio
+    only. The patch did three map_float calls and the sustain math every
+    loop, ssbEnvelope only works out a rate when a knob moves. For AVR
+    cycle counts load ssbLib/ssbEnvelope/examples/envelopeBench on an
+    ArdCore (the AVR has no FPU, so the gap is far wider there).
+
+  Created by Peter Fawcett, Oct 18. 2026.
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#include <time.h>
+#include <Arduino.h>
+#include <ssbEnvelope.h>
+
+const int       SUSTAIN_CTL         = 716;      // 70% of 1023, as SUSTAIN_AMOUNT = 70.
+const int       SUSTAIN_LOOPS       = 50;       // Loops held in sustain before the gate off.
+const int       MAX_LOOPS           = 20000;    // A 5s stage is 5000 loops.
+const unsigned long LOOP_US         = 1000;     // ssbEnvelope loop period.
+
+static int      failures            = 0;
+
+static void check(bool is_ok, const char* what)
+{
+    if (is_ok == false)
+    {
+        printf("FAIL: %s\n", what);
+        failures++;
+    }
+}
+
+static double nowNs()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1e9 + now.tv_nsec;
+}
+
+// ============================================================================
+// The float envelope from ssbMonoADSR (before ssbEnvelope):
+// ============================================================================
+
+namespace patch
+{
+const int     ATTACK       = 0;
+const int     DECAY        = 1;
+const int     SUSTAIN      = 2;
+const int     RELEASE      = 3;
+const int     ENVELOPE_MAX = 1023;
+int           SUSTAIN_AMOUNT = 70;
+
+float map_float(float x, float in_min, float in_max, float out_min, float out_max)
+{
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+int envelope_state(int state, int currentState, float envelopeVal, float sustainVal)
+{
+    if (envelopeVal >= ENVELOPE_MAX)
+    {
+        state = DECAY;
+    }
+    else if ((state == DECAY) && (envelopeVal <= sustainVal))
+    {
+        state = SUSTAIN;
+    }
+    else if (envelopeVal <= 0)
+    {
+        state = ATTACK;
+    }
+    else if (state != currentState)
+    {
+        state = currentState;
+    }
+    return state;
+}
+
+float do_attack_inc(float envelopeVal, float attackValue)
+{
+    envelopeVal = (envelopeVal + attackValue); //step up to full level
+    if (envelopeVal >= ENVELOPE_MAX)
+    {
+        envelopeVal = ENVELOPE_MAX;
+    }
+    return envelopeVal;
+}
+
+float do_decay_dec(float envelopeVal, float decayValue, float sustainValue)
+{
+    if (envelopeVal > sustainValue) // If greater than sustain
+    {
+        // Decriment by decay value.
+        envelopeVal = (envelopeVal - decayValue);
+    }
+    // if envelope is < 0 set to 0. Shouldn't get here unless sustain is 0.
+    if (envelopeVal <= 0)
+    {
+        envelopeVal = 0;
+    }
+    else if (envelopeVal < sustainValue)
+    {
+        // if current envelope got set lower than sustain, set it to sustain.
+        envelopeVal = sustainValue;
+    }
+    return envelopeVal;
+}
+
+float do_release_dec(float envelopeVal, float releaseValue)
+{
+    if (envelopeVal > 0)
+    {
+        // calculate new value of releasse envelope.
+        envelopeVal = envelopeVal - releaseValue;
+    }
+    if (envelopeVal < 0)
+    {
+        envelopeVal = 0; // if below 0, set to 0.
+    }
+    return envelopeVal;
+}
+
+int envelopeState = ATTACK;
+float envelopeVal = 0.0;
+
+void reset()
+{
+    envelopeState = ATTACK;
+    envelopeVal = 0.0;
+}
+
+/* step
+ - The envelope part of the patch loop, with the knobs passed in.
+*/
+int step(bool gateState, int a_ctl, int d_ctl, int r_ctl)
+{
+    float attackValue = map_float(a_ctl, 0, 1023, 204.6, .5);
+    float decayValue = map_float(d_ctl, 0, 1023, 204.6, .5);
+    float sustainValue = (int)(ENVELOPE_MAX * (float)(SUSTAIN_AMOUNT / 100.0));
+    float releaseValue = map_float(r_ctl, 0, 1023, 204.6, .5);
+    int envLoopState = ATTACK;
+    if (gateState == true)
+    {
+        if (envelopeState == RELEASE)
+        {
+            envLoopState = ATTACK;
+        }
+        if (envelopeState == ATTACK)
+        {
+            envLoopState = ATTACK;
+            envelopeVal = do_attack_inc(envelopeVal, attackValue);
+        }
+        else if (envelopeState == DECAY)
+        {
+            envLoopState = DECAY;
+            envelopeVal = do_decay_dec(envelopeVal, decayValue, sustainValue);
+        }
+        else
+        {
+            envLoopState = SUSTAIN;
+            envelopeVal = sustainValue;
+        }
+    }
+    else
+    {
+        envLoopState = RELEASE;
+        envelopeVal = do_release_dec(envelopeVal, releaseValue);
+    }
+    envelopeState = envelope_state(envelopeState, envLoopState, envelopeVal, sustainValue);
+    return (int)envelopeVal;
+}
+}
+
+// ============================================================================
+// Tests:
+// ============================================================================
+
+static int fixedStep(ssbEnvelope* env, bool gate, int a_ctl, int d_ctl, int r_ctl,
+                     unsigned long now_us)
+{
+    env->setAttack(a_ctl);
+    env->setDecay(d_ctl);
+    env->setSustain(SUSTAIN_CTL);
+    env->setRelease(r_ctl);
+    env->setGate(gate);
+    return env->updateState(now_us);
+}
+
+/* Note
+ - What a note did: the highest value, the value held in sustain and
+   whether it got back to 0.
+*/
+struct Note
+{
+    int     peak;
+    int     sustain;
+    bool    ended;
+};
+
+/* floatNote
+ - One note through the float code: gate on till it has been in sustain
+   for SUSTAIN_LOOPS, then off till it is back at 0.
+*/
+static Note floatNote(int a_ctl, int d_ctl, int r_ctl)
+{
+    Note note = {0, -1, false};
+    int held = 0;
+    bool gate = true;
+    patch::reset();
+    for (int loops = 0; loops < MAX_LOOPS; loops++)
+    {
+        int value = patch::step(gate, a_ctl, d_ctl, r_ctl);
+        note.peak = max(note.peak, value);
+        if ((gate == true) && (patch::envelopeState == patch::SUSTAIN))
+        {
+            note.sustain = value;
+            held++;
+            if (held >= SUSTAIN_LOOPS)
+            {
+                gate = false;
+            }
+        }
+        else if ((gate == false) && (value == 0))
+        {
+            note.ended = true;
+            break;
+        }
+    }
+    return note;
+}
+
+/* fixedNote
+ - The same note through ssbEnvelope, one update every LOOP_US.
+*/
+static Note fixedNote(int a_ctl, int d_ctl, int r_ctl)
+{
+    ssbEnvelope env = ssbEnvelope();
+    Note note = {0, -1, false};
+    int held = 0;
+    bool gate = true;
+    unsigned long now = 0;
+    env.updateState(now);
+    for (int loops = 0; loops < MAX_LOOPS; loops++)
+    {
+        now += LOOP_US;
+        int value = fixedStep(&env, gate, a_ctl, d_ctl, r_ctl, now);
+        note.peak = max(note.peak, value);
+        if ((gate == true) && (env.getState() == ENV_SUSTAIN))
+        {
+            note.sustain = value;
+            held++;
+            if (held >= SUSTAIN_LOOPS)
+            {
+                gate = false;
+            }
+        }
+        else if ((gate == false) && (value == 0))
+        {
+            note.ended = true;
+            break;
+        }
+    }
+    return note;
+}
+
+/* testShape
+ - Every knob value on all three stages, then mixed knobs: both reach the
+   same peak, hold the same sustain level and get back to 0. The stage
+   times differ by design (the float code moved a fixed amount a loop,
+   ssbEnvelope times stages in ms).
+*/
+static void testShape()
+{
+    int bad = 0;
+    int bad_ctl = -1;
+    for (int ctl = 0; ctl <= 1023; ctl++)
+    {
+        Note want = floatNote(ctl, ctl, ctl);
+        Note got = fixedNote(ctl, ctl, ctl);
+        if ((got.peak != want.peak) || (got.sustain != want.sustain) ||
+            (got.ended == false) || (want.ended == false))
+        {
+            bad++;
+            bad_ctl = ctl;
+        }
+    }
+    printf("knob sweep:    %d of 1024 controls differ (last %d)\n", bad, bad_ctl);
+    check(bad == 0, "same peak, sustain and end as the float code");
+    bad = 0;
+    for (int a_ctl = 0; a_ctl <= 1023; a_ctl += 93)
+    {
+        for (int d_ctl = 1023; d_ctl >= 0; d_ctl -= 155)
+        {
+            Note want = floatNote(a_ctl, d_ctl, 1023 - a_ctl);
+            Note got = fixedNote(a_ctl, d_ctl, 1023 - a_ctl);
+            if ((got.peak != want.peak) || (got.sustain != want.sustain) ||
+                (got.ended == false) || (want.ended == false))
+            {
+                bad++;
+            }
+        }
+    }
+    printf("mixed knobs:   %d differ\n", bad);
+    check(bad == 0, "same peak, sustain and end as the float code, mixed knobs");
+}
+
+/* testCost
+ - Host time of a loop's envelope work. Only the ratio means anything,
+   the host does float in hardware and the AVR in software.
+*/
+static void testCost()
+{
+    const int notes = 2000;
+    volatile int sink = 0;
+    double float_ns;
+    double fixed_ns;
+    long loops = 0;
+    double start = nowNs();
+    for (int n = 0; n < notes; n++)
+    {
+        patch::reset();
+        for (int i = 0; i < 1500; i++)
+        {
+            sink += patch::step(i < 1000, 300, 500, 400);
+        }
+        loops += 1500;
+    }
+    float_ns = (nowNs() - start) / loops;
+    start = nowNs();
+    for (int n = 0; n < notes; n++)
+    {
+        ssbEnvelope env = ssbEnvelope();
+        for (int i = 0; i < 1500; i++)
+        {
+            sink += fixedStep(&env, i < 1000, 300, 500, 400, i * LOOP_US);
+        }
+    }
+    fixed_ns = (nowNs() - start) / loops;
+    printf("cost (host):   float %.2fns, ssbEnvelope %.2fns a loop (%.1fx)\n",
+           float_ns, fixed_ns, float_ns / fixed_ns);
+}
+
+int main()
+{
+    testShape();
+    testCost();
+    if (failures > 0)
+    {
+        printf("FAIL (%d)\n", failures);
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
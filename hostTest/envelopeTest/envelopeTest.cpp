@@ -0,0 +1,263 @@
+/*
+  envelopeTest.cpp - Stage times of ssbEnvelope with a jittered loop.
+
+    The envelope is updated with updateState(now_us) at random intervals
+    like a patch loop: mostly 50 - 400us, with a 5 - 20ms stall (serial,
+    debug output) one update in twenty. A stage has ended at the first
+    update that sees it done, so its true end lies between that update
+    and the one before. Each check takes that window and asserts it
+    overlaps the set time +-1%: the stage did not end more than 1% early
+    and was not still running 1% after the time.
+
+    Checks:
+      - Attack (0 -> 1023), decay (1023 -> sustain 0) and release
+        (1023 -> 0) at set times of 2ms - 5s (setXTime).
+      - The same for every control value 0 - 1023 (setX), against the
+        knob curve of the header in whole ms: 2ms at 0, 5s at 1023, a
+        squared curve between.
+      - A stage across the micros() wrap.
+
+  Created by Peter Fawcett, Oct 18. 2026.
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#include <stdlib.h>
+#include <Arduino.h>
+#include <ssbEnvelope.h>
+
+const double    TOLERANCE           = 0.01;     // +-1% of the set time.
+const int       STALL_CHANCE        = 20;       // One update in 20 is a stall.
+const unsigned long MAX_UPDATES     = 1000000;
+
+static int      failures            = 0;
+static unsigned long longest_gap    = 0;
+
+static void check(bool is_ok, const char* what)
+{
+    if (is_ok == false)
+    {
+        printf("FAIL: %s\n", what);
+        failures++;
+    }
+}
+
+/* nextGap
+ - Time to the next update: 50 - 400us, or a 5 - 20ms stall.
+*/
+static unsigned long nextGap()
+{
+    unsigned long gap;
+    if ((rand() % STALL_CHANCE) == 0)
+    {
+        gap = 5000 + (rand() % 15001);
+    }
+    else
+    {
+        gap = 50 + (rand() % 351);
+    }
+    longest_gap = max(longest_gap, gap);
+    return gap;
+}
+
+/* ctlToMs
+ - The knob curve from ssbEnvelope.h, in whole ms: 2ms at 0, 5000ms at
+   1023, squared between.
+*/
+static unsigned int ctlToMs(int ctl)
+{
+    double frac = (double)ctl / ENV_CTL_MAX;
+    return (unsigned int)(ENV_TIME_MIN_MS + frac * frac * (ENV_TIME_MAX_MS - ENV_TIME_MIN_MS));
+}
+
+/* Stage
+ - When a stage ended: between prev_us and end_us after it started.
+*/
+struct Stage
+{
+    unsigned long   prev_us;
+    unsigned long   end_us;
+};
+
+/* runUntil
+ - Jittered updates from *now till the envelope leaves state (or, for a
+   release, is back at 0). *now is left at the update that saw the end.
+*/
+static Stage runUntil(ssbEnvelope* env, unsigned long* now, byte state)
+{
+    Stage stage = {0, 0};
+    unsigned long start = *now;
+    for (unsigned long i = 0; i < MAX_UPDATES; i++)
+    {
+        stage.prev_us = *now - start;
+        *now += nextGap();
+        int value = env->updateState(*now);
+        if ((state == ENV_RELEASE) && (value == 0))
+        {
+            break;
+        }
+        if ((state != ENV_RELEASE) && (env->getState() != state))
+        {
+            break;
+        }
+    }
+    stage.end_us = *now - start;
+    return stage;
+}
+
+/* inTime
+ - The window the stage ended in overlaps ms +-1%.
+*/
+static bool inTime(Stage stage, unsigned int ms)
+{
+    double want_us = ms * 1000.0;
+    return (stage.prev_us < want_us * (1.0 + TOLERANCE)) &&
+           (stage.end_us >= want_us * (1.0 - TOLERANCE));
+}
+
+/* runNote
+ - A full scale note: attack to 1023, decay to a sustain of 0, then the
+   gate off at 1023 (sustain at full) for the release. Checks each stage
+   against its time and returns how many were off.
+*/
+static int runNote(ssbEnvelope* env, unsigned long* now,
+                   unsigned int attack_ms, unsigned int decay_ms, unsigned int release_ms)
+{
+    int bad = 0;
+    Stage stage;
+    env->updateState(*now);
+    env->setSustain(0);
+    env->setGate(true);
+    stage = runUntil(env, now, ENV_ATTACK);
+    bad += (inTime(stage, attack_ms) == false);
+    bad += (env->getValue() != ENV_MAX);
+    stage = runUntil(env, now, ENV_DECAY);
+    bad += (inTime(stage, decay_ms) == false);
+    bad += (env->getValue() != 0);
+    // Back up to full for the release.
+    env->setGate(false);
+    runUntil(env, now, ENV_RELEASE);
+    env->setSustain(ENV_CTL_MAX);
+    env->setGate(true);
+    runUntil(env, now, ENV_ATTACK);
+    runUntil(env, now, ENV_DECAY);
+    bad += (env->getValue() != ENV_MAX);
+    env->setGate(false);
+    stage = runUntil(env, now, ENV_RELEASE);
+    bad += (inTime(stage, release_ms) == false);
+    return bad;
+}
+
+/* testTimes
+ - Set times, 2ms - 5s.
+*/
+static void testTimes()
+{
+    const unsigned int times[] = {2, 5, 10, 50, 100, 250, 1000, 2500, 5000};
+    unsigned long now = 0;
+    int bad = 0;
+    for (unsigned int i = 0; i < sizeof(times) / sizeof(times[0]); i++)
+    {
+        ssbEnvelope env = ssbEnvelope();
+        env.setAttackTime(times[i]);
+        env.setDecayTime(times[i]);
+        env.setReleaseTime(times[i]);
+        int note_bad = runNote(&env, &now, times[i], times[i], times[i]);
+        if (note_bad > 0)
+        {
+            printf("  %ums: %d stage(s) off\n", times[i], note_bad);
+        }
+        bad += note_bad;
+    }
+    printf("set times:     2ms - 5s, %d stages off\n", bad);
+    check(bad == 0, "stage times within 1% (setXTime)");
+}
+
+/* testKnobs
+ - Every control value on all three stages, then mixed knobs.
+*/
+static void testKnobs()
+{
+    unsigned long now = 0;
+    int bad = 0;
+    int bad_ctl = -1;
+    check(ctlToMs(0) == ENV_TIME_MIN_MS, "control 0 is the shortest time");
+    check(ctlToMs(ENV_CTL_MAX) == ENV_TIME_MAX_MS, "control 1023 is the longest time");
+    for (int ctl = 0; ctl <= ENV_CTL_MAX; ctl++)
+    {
+        ssbEnvelope env = ssbEnvelope();
+        unsigned int ms = ctlToMs(ctl);
+        env.setAttack(ctl);
+        env.setDecay(ctl);
+        env.setRelease(ctl);
+        if (runNote(&env, &now, ms, ms, ms) > 0)
+        {
+            bad++;
+            bad_ctl = ctl;
+        }
+    }
+    printf("knob sweep:    %d of 1024 controls off (last %d)\n", bad, bad_ctl);
+    check(bad == 0, "stage times within 1% of the knob curve");
+    bad = 0;
+    for (int a_ctl = 0; a_ctl <= ENV_CTL_MAX; a_ctl += 93)
+    {
+        for (int d_ctl = ENV_CTL_MAX; d_ctl >= 0; d_ctl -= 155)
+        {
+            ssbEnvelope env = ssbEnvelope();
+            int r_ctl = ENV_CTL_MAX - a_ctl;
+            env.setAttack(a_ctl);
+            env.setDecay(d_ctl);
+            env.setRelease(r_ctl);
+            if (runNote(&env, &now, ctlToMs(a_ctl), ctlToMs(d_ctl), ctlToMs(r_ctl)) > 0)
+            {
+                bad++;
+            }
+        }
+    }
+    printf("mixed knobs:   %d off\n", bad);
+    check(bad == 0, "stage times within 1%, mixed knobs");
+}
+
+/* testWrap
+ - A note that starts just before micros() wraps (70 minutes).
+*/
+static void testWrap()
+{
+    ssbEnvelope env = ssbEnvelope();
+    unsigned long now = 0xFFFFFFFFUL - 20000;
+    env.setAttackTime(100);
+    env.setDecayTime(100);
+    env.setReleaseTime(100);
+    int bad = runNote(&env, &now, 100, 100, 100);
+    printf("micros wrap:   %d stages off\n", bad);
+    check(bad == 0, "stage times within 1% across the micros wrap");
+}
+
+int main()
+{
+    srand(1023);
+    testTimes();
+    testKnobs();
+    testWrap();
+    printf("longest gap:   %uus\n", longest_gap);
+    if (failures > 0)
+    {
+        printf("FAIL (%d)\n", failures);
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,287 @@
+/*
+  Arduino.h - Host (Linux) stand in for the Arduino core, so ssbLib
+    libraries and patches can be built and run on the host by the tools
+    in hostTest.
+    Time is virtual by default (hostSetMicros / hostAdvanceMicros) so a
+    test is repeatable, or real (hostUseRealTime) for the pty tools.
+    Serial reads and writes a byte queue, or a file descriptor (the slave
+    side of a pty) after hostSerialAttach.
+    The registers are plain variables. Nothing runs an ISR on its own,
+    the test calls the vector (TIMER1_COMPA_vect ...) when a tick is due.
+
+    long is 32 bits, as on the AVR. int is NOT 16 bits: code whose result
+    depends on int wrapping must use a fixed width type (uint16_t).
+
+  Created by Peter Fawcett, Oct 18. 2026.
+    Version 0.1: Created basic host HAL
+    Version 0.2: Added the B00000000 binary constants (binary.h)
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#ifndef _host_arduino_h_
+#define _host_arduino_h_
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+#include <string>
+#include <deque>
+#include "binary.h"
+
+// AVR long is 32 bits. Every system header the tools use is included
+// above, so the define only reaches the sketch and library code.
+#ifndef HOST_LONG64
+#define long int
+#endif
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+// ============================================================================
+// Core constants and macros:
+// ============================================================================
+#define HIGH            1
+#define LOW             0
+#define INPUT           0
+#define OUTPUT          1
+#define INPUT_PULLUP    2
+#define CHANGE          1
+#define FALLING         2
+#define RISING          3
+#define DEC             10
+#define HEX             16
+#define BIN             2
+#define A0              14
+#define A1              15
+#define A2              16
+#define A3              17
+#define A4              18
+#define A5              19
+#define F_CPU           16000000L
+
+#define PROGMEM
+#define pgm_read_byte(p)        (*(const uint8_t*)(p))
+#define pgm_read_word(p)        (*(const uint16_t*)(p))
+#define pgm_read_dword(p)       (*(const uint32_t*)(p))
+
+#define _BV(b)                  (1 << (b))
+#define bit(b)                  (1UL << (b))
+#define bitRead(v, b)           (((v) >> (b)) & 0x01)
+#define bitSet(v, b)            ((v) |= (1UL << (b)))
+#define bitClear(v, b)          ((v) &= ~(1UL << (b)))
+#define bitWrite(v, b, x)       ((x) ? bitSet(v, b) : bitClear(v, b))
+#define lowByte(w)              ((uint8_t)((w) & 0xFF))
+#define highByte(w)             ((uint8_t)((w) >> 8))
+#define min(a, b)               ((a) < (b) ? (a) : (b))
+#define max(a, b)               ((a) > (b) ? (a) : (b))
+#undef abs
+#define abs(x)                  ((x) > 0 ? (x) : -(x))
+#define constrain(amt, lo, hi)  ((amt) < (lo) ? (lo) : ((amt) > (hi) ? (hi) : (amt)))
+
+// Interrupts. The host never interrupts the sketch, cli/sei only count.
+extern int hostIrqOff;
+#define cli()                   (hostIrqOff++)
+#define sei()                   (hostIrqOff = 0)
+#define noInterrupts()          cli()
+#define interrupts()            sei()
+#define ISR(vector)             extern "C" void vector(void)
+#define TIMER1_COMPA_vect       hostTimer1CompA
+#define TIMER1_COMPB_vect       hostTimer1CompB
+#define TIMER2_COMPA_vect       hostTimer2CompA
+#define TIMER2_OVF_vect         hostTimer2Ovf
+extern "C" void hostTimer1CompA(void);
+
+// ============================================================================
+// Registers (ATmega328):
+// ============================================================================
+extern volatile uint8_t TCCR0A, TCCR0B, TCNT0, TIMSK0, TIFR0;
+extern volatile uint8_t TCCR1A, TCCR1B, TCCR1C, TIMSK1, TIFR1;
+extern volatile uint8_t TCCR2A, TCCR2B, TCNT2, OCR2A, OCR2B, TIMSK2, TIFR2, ASSR;
+extern volatile uint8_t PORTB, PORTC, PORTD, DDRB, DDRC, DDRD, PINB, PINC, PIND;
+extern volatile uint8_t ADCSRA, ADMUX, SREG, GTCCR;
+extern volatile uint16_t TCNT1, OCR1A, OCR1B, ICR1, SP;
+
+#define CS00    0
+#define CS01    1
+#define CS02    2
+#define CS10    0
+#define CS11    1
+#define CS12    2
+#define CS20    0
+#define CS21    1
+#define CS22    2
+#define WGM10   0
+#define WGM11   1
+#define WGM12   3
+#define WGM13   4
+#define WGM20   0
+#define WGM21   1
+#define WGM22   3
+#define COM1A0  6
+#define COM1A1  7
+#define COM2A0  6
+#define COM2A1  7
+#define TOIE1   0
+#define OCIE1A  1
+#define OCIE1B  2
+#define OCIE2A  1
+#define TOV0    0
+#define ADPS0   0
+#define ADPS1   1
+#define ADPS2   2
+
+// ============================================================================
+// Core functions:
+// ============================================================================
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+void analogWrite(uint8_t pin, int value);
+void attachInterrupt(uint8_t irq, void (*fn)(void), int mode);
+// random is the avr-libc generator (Park-Miller) with the Arduino
+// WMath wrappers, so a test can compare against what the patch used.
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+
+// ============================================================================
+// String (the parts the patches use):
+// ============================================================================
+class String
+{
+    public:
+        std::string s;
+        String(const char* c = "") : s(c) {}
+        String(const std::string& x) : s(x) {}
+        String(char c) : s(1, c) {}
+        String(int v) : s(std::to_string(v)) {}
+        String(unsigned int v) : s(std::to_string(v)) {}
+        unsigned int length() const { return s.size(); }
+        String& operator+=(char c) { s += c; return *this; }
+        String& operator+=(const String& o) { s += o.s; return *this; }
+        String& operator=(const char* c) { s = c; return *this; }
+        bool operator==(const char* c) const { return s == c; }
+        bool operator==(const String& o) const { return s == o.s; }
+        int toInt() const { return atoi(s.c_str()); }
+        float toFloat() const { return atof(s.c_str()); }
+        int indexOf(char c) const { return indexOf(c, 0); }
+        int indexOf(char c, unsigned int from) const
+        {
+            size_t p = s.find(c, from);
+            if (p == std::string::npos)
+            {
+                return -1;
+            }
+            return (int)p;
+        }
+        String substring(unsigned int from) const
+        {
+            if (from > s.size())
+            {
+                return String("");
+            }
+            return String(s.substr(from));
+        }
+        String substring(unsigned int from, unsigned int to) const
+        {
+            if (from > s.size())
+            {
+                return String("");
+            }
+            return String(s.substr(from, to - from));
+        }
+        void toCharArray(char* buf, unsigned int n) const
+        {
+            if (n == 0)
+            {
+                return;
+            }
+            strncpy(buf, s.c_str(), n - 1);
+            buf[n - 1] = 0;
+        }
+        char charAt(unsigned int i) const { return s[i]; }
+        void reserve(unsigned int n) { s.reserve(n); }
+        const char* c_str() const { return s.c_str(); }
+};
+
+// ============================================================================
+// Serial:
+// ============================================================================
+class HardwareSerial
+{
+    private:
+        std::deque<uint8_t> _rx;
+        std::string         _tx;
+        int                 _fd;
+        void _poll();
+        size_t _print_str(const char* str);
+    public:
+        HardwareSerial();
+        void begin(unsigned long baud);
+        void end();
+        int available();
+        int read();
+        int peek();
+        int availableForWrite();
+        void flush();
+        size_t write(uint8_t b);
+        size_t write(const uint8_t* buf, size_t n);
+        size_t print(const char* str);
+        size_t print(const String& str);
+        size_t print(char c);
+        size_t print(unsigned char v, int base = DEC);
+        size_t print(int v, int base = DEC);
+        size_t print(unsigned int v, int base = DEC);
+        size_t print(double v, int digits = 2);
+        size_t println();
+        template <class T> size_t println(T v) { size_t n = print(v); return n + println(); }
+        template <class T> size_t println(T v, int f) { size_t n = print(v, f); return n + println(); }
+        operator bool() { return true; }
+
+        // Host side.
+        // - Read and write fd (a pty slave) in place of the queues.
+        void hostAttach(int fd);
+        // - Queue bytes to be read by the sketch.
+        void hostPush(const uint8_t* buf, size_t n);
+        // - Take the bytes the sketch has written.
+        std::string hostTake();
+};
+
+extern HardwareSerial Serial;
+
+// ============================================================================
+// Host control:
+// ============================================================================
+// - Virtual time (the default).
+void hostSetMicros(unsigned long us);
+void hostAdvanceMicros(unsigned long us);
+// - Real time from the monotonic clock, from the first call.
+void hostUseRealTime(bool is_on);
+// - Value returned by analogRead (0 - 1023) for a pin (0 - 5).
+void hostSetAnalog(uint8_t pin, int value);
+// - The 8 DAC / expander bits (pins 5 - 12) from PORTD and PORTB.
+uint8_t hostDacBits();
+
+#endif // _host_arduino_h_
@@ -0,0 +1,9 @@
+// Host stand in, see hostTest/hal/Arduino.h. 1K of EEPROM in RAM.
+#include <Arduino.h>
+
+uint8_t eeprom_read_byte(const uint8_t* addr);
+void eeprom_write_byte(uint8_t* addr, uint8_t value);
+void eeprom_update_byte(uint8_t* addr, uint8_t value);
+void eeprom_read_block(void* dst, const void* src, size_t n);
+void eeprom_update_block(const void* src, void* dst, size_t n);
+int eeprom_is_ready();
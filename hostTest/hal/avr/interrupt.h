@@ -0,0 +1,2 @@
+// Host stand in, see hostTest/hal/Arduino.h.
+#include <Arduino.h>
@@ -0,0 +1,507 @@
+/*
+  hostHal.cpp - Host (Linux) stand in for the Arduino core. See Arduino.h.
+
+  Created by Peter Fawcett, Oct 18. 2026.
+    Version 0.1: Created basic host HAL
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#include <time.h>
+#include <errno.h>
+#include <unistd.h>
+#include "Arduino.h"
+#include "avr/eeprom.h"
+
+int hostIrqOff = 0;
+
+volatile uint8_t TCCR0A, TCCR0B, TCNT0, TIMSK0, TIFR0;
+volatile uint8_t TCCR1A, TCCR1B, TCCR1C, TIMSK1, TIFR1;
+volatile uint8_t TCCR2A, TCCR2B, TCNT2, OCR2A, OCR2B, TIMSK2, TIFR2, ASSR;
+volatile uint8_t PORTB, PORTC, PORTD, DDRB, DDRC, DDRD, PINB, PINC, PIND;
+volatile uint8_t ADCSRA, ADMUX, SREG, GTCCR;
+volatile uint16_t TCNT1, OCR1A, OCR1B, ICR1, SP;
+
+HardwareSerial Serial;
+
+static unsigned long    host_us = 0;
+static bool             host_real_time = false;
+static struct timespec  host_start;
+static int              host_analog[6] = {0, 0, 0, 0, 0, 0};
+static unsigned long    host_rand_next = 1;
+
+// ============================================================================
+// Time:
+// ============================================================================
+
+void hostSetMicros(unsigned long us)
+{
+    host_us = us;
+}
+
+void hostAdvanceMicros(unsigned long us)
+{
+    host_us += us;
+}
+
+void hostUseRealTime(bool is_on)
+{
+    host_real_time = is_on;
+    clock_gettime(CLOCK_MONOTONIC, &host_start);
+}
+
+unsigned long micros()
+{
+    if (host_real_time == true)
+    {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return (unsigned long)((now.tv_sec - host_start.tv_sec) * 1000000 +
+                               (now.tv_nsec - host_start.tv_nsec) / 1000);
+    }
+    return host_us;
+}
+
+unsigned long millis()
+{
+    return micros() / 1000;
+}
+
+void delay(unsigned long ms)
+{
+    delayMicroseconds(ms * 1000);
+}
+
+void delayMicroseconds(unsigned int us)
+{
+    if (host_real_time == true)
+    {
+        usleep(us);
+    }
+    else
+    {
+        host_us += us;
+    }
+}
+
+// ============================================================================
+// Pins:
+// ============================================================================
+
+/* _pin_port
+ - Port register and bit for a digital pin (0 - 7 PORTD, 8 - 13 PORTB).
+*/
+static volatile uint8_t* _pin_port(uint8_t pin, uint8_t* bit_out)
+{
+    if (pin < 8)
+    {
+        *bit_out = pin;
+        return &PORTD;
+    }
+    if (pin < 14)
+    {
+        *bit_out = pin - 8;
+        return &PORTB;
+    }
+    *bit_out = pin - 14;
+    return &PORTC;
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    uint8_t bit_num;
+    volatile uint8_t* port = _pin_port(pin, &bit_num);
+    volatile uint8_t* ddr = &DDRC;
+    if (port == &PORTD)
+    {
+        ddr = &DDRD;
+    }
+    else if (port == &PORTB)
+    {
+        ddr = &DDRB;
+    }
+    if (mode == OUTPUT)
+    {
+        *ddr |= (1 << bit_num);
+    }
+    else
+    {
+        *ddr &= ~(1 << bit_num);
+    }
+}
+
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+    uint8_t bit_num;
+    volatile uint8_t* port = _pin_port(pin, &bit_num);
+    if (value == LOW)
+    {
+        *port &= ~(1 << bit_num);
+    }
+    else
+    {
+        *port |= (1 << bit_num);
+    }
+}
+
+int digitalRead(uint8_t pin)
+{
+    uint8_t bit_num;
+    volatile uint8_t* port = _pin_port(pin, &bit_num);
+    return (*port >> bit_num) & 1;
+}
+
+void hostSetAnalog(uint8_t pin, int value)
+{
+    if (pin >= A0)
+    {
+        pin -= A0;
+    }
+    if (pin < 6)
+    {
+        host_analog[pin] = constrain(value, 0, 1023);
+    }
+}
+
+int analogRead(uint8_t pin)
+{
+    if (pin >= A0)
+    {
+        pin -= A0;
+    }
+    if (pin < 6)
+    {
+        return host_analog[pin];
+    }
+    return 0;
+}
+
+void analogWrite(uint8_t pin, int value)
+{
+    digitalWrite(pin, value >= 128);
+}
+
+void attachInterrupt(uint8_t irq, void (*fn)(void), int mode)
+{
+}
+
+uint8_t hostDacBits()
+{
+    return (PORTD >> 5) | ((PORTB & 0x1F) << 3);
+}
+
+// ============================================================================
+// Math:
+// ============================================================================
+
+/* random
+ - avr-libc random() (Park-Miller minimal standard, Schrage's method) and
+   the Arduino WMath wrappers, the same numbers the patches get.
+*/
+static long _do_random()
+{
+    long hi;
+    long lo;
+    long x = (long)host_rand_next;
+    if (x == 0)
+    {
+        x = 123459876L;
+    }
+    hi = x / 127773L;
+    lo = x % 127773L;
+    x = 16807L * lo - 2836L * hi;
+    if (x < 0)
+    {
+        x += 0x7FFFFFFFL;
+    }
+    host_rand_next = (unsigned long)x;
+    return x;
+}
+
+long random(long howbig)
+{
+    if (howbig == 0)
+    {
+        return 0;
+    }
+    return _do_random() % howbig;
+}
+
+long random(long howsmall, long howbig)
+{
+    if (howsmall >= howbig)
+    {
+        return howsmall;
+    }
+    return random(howbig - howsmall) + howsmall;
+}
+
+void randomSeed(unsigned long seed)
+{
+    if (seed != 0)
+    {
+        host_rand_next = seed;
+    }
+}
+
+long map(long x, long in_min, long in_max, long out_min, long out_max)
+{
+    return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+// ============================================================================
+// EEPROM (1K, cleared to 0xFF as a new part is):
+// ============================================================================
+
+static uint8_t host_eeprom[1024];
+static bool host_eeprom_init = false;
+
+static uint8_t* _eeprom_at(const void* addr)
+{
+    if (host_eeprom_init == false)
+    {
+        memset(host_eeprom, 0xFF, sizeof(host_eeprom));
+        host_eeprom_init = true;
+    }
+    return &host_eeprom[(uintptr_t)addr & (sizeof(host_eeprom) - 1)];
+}
+
+uint8_t eeprom_read_byte(const uint8_t* addr)
+{
+    return *_eeprom_at(addr);
+}
+
+void eeprom_write_byte(uint8_t* addr, uint8_t value)
+{
+    *_eeprom_at(addr) = value;
+}
+
+void eeprom_update_byte(uint8_t* addr, uint8_t value)
+{
+    *_eeprom_at(addr) = value;
+}
+
+void eeprom_read_block(void* dst, const void* src, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        ((uint8_t*)dst)[i] = *_eeprom_at((const uint8_t*)src + i);
+    }
+}
+
+void eeprom_update_block(const void* src, void* dst, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        *_eeprom_at((uint8_t*)dst + i) = ((const uint8_t*)src)[i];
+    }
+}
+
+int eeprom_is_ready()
+{
+    return 1;
+}
+
+// ============================================================================
+// Serial:
+// ============================================================================
+
+HardwareSerial::HardwareSerial()
+{
+    _fd = -1;
+}
+
+void HardwareSerial::begin(unsigned long baud)
+{
+}
+
+void HardwareSerial::end()
+{
+}
+
+void HardwareSerial::hostAttach(int fd)
+{
+    _fd = fd;
+}
+
+/* _poll
+ - Move any bytes waiting on the fd into the receive queue. The fd is non
+   blocking (set by the tool).
+*/
+void HardwareSerial::_poll()
+{
+    uint8_t buf[64];
+    ssize_t n;
+    if (_fd < 0)
+    {
+        return;
+    }
+    n = ::read(_fd, buf, sizeof(buf));
+    for (ssize_t i = 0; i < n; i++)
+    {
+        _rx.push_back(buf[i]);
+    }
+}
+
+int HardwareSerial::available()
+{
+    if (_rx.empty() == true)
+    {
+        _poll();
+    }
+    return (int)_rx.size();
+}
+
+int HardwareSerial::read()
+{
+    int c;
+    if (available() == 0)
+    {
+        return -1;
+    }
+    c = _rx.front();
+    _rx.pop_front();
+    return c;
+}
+
+int HardwareSerial::peek()
+{
+    if (available() == 0)
+    {
+        return -1;
+    }
+    return _rx.front();
+}
+
+int HardwareSerial::availableForWrite()
+{
+    return 63;
+}
+
+void HardwareSerial::flush()
+{
+}
+
+size_t HardwareSerial::write(uint8_t b)
+{
+    return write(&b, 1);
+}
+
+size_t HardwareSerial::write(const uint8_t* buf, size_t n)
+{
+    if (_fd >= 0)
+    {
+        size_t done = 0;
+        while (done < n)
+        {
+            ssize_t w = ::write(_fd, buf + done, n - done);
+            if (w > 0)
+            {
+                done += w;
+            }
+            else if (errno != EAGAIN)
+            {
+                break;
+            }
+        }
+        return done;
+    }
+    _tx.append((const char*)buf, n);
+    return n;
+}
+
+size_t HardwareSerial::_print_str(const char* str)
+{
+    return write((const uint8_t*)str, strlen(str));
+}
+
+size_t HardwareSerial::print(const char* str)
+{
+    return _print_str(str);
+}
+
+size_t HardwareSerial::print(const String& str)
+{
+    return _print_str(str.c_str());
+}
+
+size_t HardwareSerial::print(char c)
+{
+    return write((uint8_t)c);
+}
+
+size_t HardwareSerial::print(unsigned char v, int base)
+{
+    return print((unsigned int)v, base);
+}
+
+size_t HardwareSerial::print(int v, int base)
+{
+    if ((base == DEC) && (v < 0))
+    {
+        return print('-') + print((unsigned int)(-v), base);
+    }
+    return print((unsigned int)v, base);
+}
+
+size_t HardwareSerial::print(unsigned int v, int base)
+{
+    char buf[40];
+    int i = sizeof(buf) - 1;
+    buf[i] = 0;
+    do
+    {
+        byte digit = v % base;
+        i--;
+        if (digit < 10)
+        {
+            buf[i] = '0' + digit;
+        }
+        else
+        {
+            buf[i] = 'A' + digit - 10;
+        }
+        v /= base;
+    } while (v > 0);
+    return _print_str(&buf[i]);
+}
+
+size_t HardwareSerial::print(double v, int digits)
+{
+    char buf[40];
+    snprintf(buf, sizeof(buf), "%.*f", digits, v);
+    return _print_str(buf);
+}
+
+size_t HardwareSerial::println()
+{
+    return _print_str("\r\n");
+}
+
+void HardwareSerial::hostPush(const uint8_t* buf, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        _rx.push_back(buf[i]);
+    }
+}
+
+std::string HardwareSerial::hostTake()
+{
+    std::string out = _tx;
+    _tx.clear();
+    return out;
+}
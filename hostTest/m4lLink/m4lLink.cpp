@@ -0,0 +1,878 @@
+/*
+  m4lLink.cpp - Max4Live stand in on a pseudo terminal, for serial
+    throughput and latency tests with out Live (or an ArdCore).
+
+    A pty pair is opened. The slave side is the host HAL Serial of a
+    device, run in its own thread: a patch or library loop, built for the
+    host. The master side plays the part of SerialPatch.maxpat and
+    ssbArdCoreVel.amxd: it writes generated (optionally fuzzed) or
+    scripted streams, paced at the baud rate a byte at a time as a UART
+    would send them. The device thread timestamps every change of the 8
+    DAC / expander bits, and each frame is matched to the change it
+    should cause.
+
+    Formats (the device that is run):
+      ascii   ssbM4LArdBits patch, '[n]' frames. DAC = n >> 2.
+      m4l     ssbArdM4L loop, '[n]' frames. DAC = n >> 2, [-1] reports
+              the ssbArdM4L frame statistics.
+      trig    ssbM4LArdBits patch in trigger mode, '[delta,mask]' events
+              after a [0,0] sync. Timer1 is run at 20kHz from the device
+              thread. Reports the spacing error of the fired triggers.
+      midi    ssbMidiIn loop, raw MIDI. Note on sets the DAC to the
+              velocity << 1, stop (0xFC) reports the parser statistics.
+
+    Reports throughput, frame to DAC latency (from the last byte of a
+    frame leaving the host to the DAC change), frames with no DAC change
+    and the dropped frame and parse error counts. With -f (fuzz) junk is
+    mixed in (noise, frames never closed, over long frames, sysex, clocks
+    and cut short MIDI messages, not for trig) and the counts the device
+    reports are checked against what was sent. Exits 1 when a check fails.
+
+    Usage: m4lLink <ascii|m4l|trig|midi> [-n frames] [-b baud] [-f]
+                   [-r seed] [-l lead_ms] [-s script]
+      -b 0 sends as fast as the pty takes it (throughput).
+      -s script: one line per send, '<delay_ms> <bytes>', bytes may use
+         \xNN. Latency is to the first DAC change after each line. See
+         burst.txt.
+
+  Created by Peter Fawcett, Oct 18. 2026.
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include <poll.h>
+#include <Arduino.h>
+#include <ssbTrigQueue.h>
+#include <ssbArdM4L.h>
+#include <ssbMidiIn.h>
+
+// The patch, built as it is, in its own namespace (with the prototypes the
+// Arduino IDE would add).
+namespace bits
+{
+int convertStringToInt(String str);
+void dacOutput(long v);
+#include "../../ssbM4LArdBits/ssbM4LArdBits.ino"
+}
+
+const int       FMT_ASCII       = 0;
+const int       FMT_M4L         = 1;
+const int       FMT_TRIG        = 2;
+const int       FMT_MIDI        = 3;
+const int       FMT_COUNT       = 4;
+const char*     FMT_NAMES[]     = {"ascii", "m4l", "trig", "midi"};
+
+struct Options
+{
+    int             format;
+    int             count;
+    long            baud;
+    bool            fuzz;
+    unsigned int    seed;
+    int             lead_ms;
+    const char*     script;
+};
+
+// A change of the DAC bits, seen by the device thread.
+struct DacChange
+{
+    unsigned long   us;
+    byte            bits;
+};
+
+// A frame (or script line) sent by the player.
+struct Sent
+{
+    unsigned long   us;         // Time the last byte was written.
+    int             expect;     // Expected DAC bits, -1 for any change.
+    unsigned long   at_ms;      // trig: event time from the sync (ms).
+};
+
+// What the device should count, for the fuzz checks.
+struct Expected
+{
+    unsigned int    frames;
+    unsigned int    dropped;
+    unsigned int    errors;
+};
+
+static std::atomic<bool>        device_running(false);
+static std::mutex               change_lock;
+static std::vector<DacChange>   changes;
+static int                      failures = 0;
+
+// ============================================================================
+// Devices:
+// ============================================================================
+
+static void dacOut(int value)
+{
+    PORTD = (PORTD & 0x1F) | ((value & 0x07) << 5);
+    PORTB = (PORTB & 0xE0) | ((value >> 3) & 0x1F);
+}
+
+namespace m4l
+{
+ssbArdM4L M4L = ssbArdM4L();
+
+void setup()
+{
+    M4L.enableSerial();
+}
+
+// doRead stays true till the next frame opens, act on each frame once.
+unsigned int frames_done = 0;
+
+void loop()
+{
+    if ((M4L.doRead() == true) && (M4L.getFrameCount() != frames_done))
+    {
+        frames_done = M4L.getFrameCount();
+        int value = M4L.getBufferAsInt();
+        if (value < 0)
+        {
+            M4L.reportStats();
+        }
+        else
+        {
+            dacOut(value >> 2);
+        }
+    }
+}
+}
+
+namespace midi
+{
+ssbMidiIn MIDI = ssbMidiIn(MIDI_OMNI);
+
+void setup()
+{
+    MIDI.enableSerial();
+}
+
+void loop()
+{
+    byte message = MIDI.doRead();
+    if (message == MIDI_NOTE_ON)
+    {
+        dacOut(MIDI.getVelocity() << 1);
+    }
+    else if (message == MIDI_STOP)
+    {
+        MIDI.reportStats();
+    }
+}
+}
+
+static void recordChange(unsigned long us, byte bits)
+{
+    std::lock_guard<std::mutex> guard(change_lock);
+    DacChange change;
+    change.us = us;
+    change.bits = bits;
+    changes.push_back(change);
+}
+
+/* deviceThread
+ - Run the device loop as fast as it goes. For trig, Timer1 compare ticks
+   are run (at 20kHz of micros) between loops, and their changes are
+   stamped with the tick time, which is when the hardware would fire.
+*/
+static void deviceThread(int format)
+{
+    unsigned long start_us;
+    unsigned long isr_done = 0;
+    byte last;
+    if ((format == FMT_ASCII) || (format == FMT_TRIG))
+    {
+        bits::setup();
+    }
+    else if (format == FMT_M4L)
+    {
+        m4l::setup();
+    }
+    else
+    {
+        midi::setup();
+    }
+    last = hostDacBits();
+    start_us = micros();
+    while (device_running == true)
+    {
+        if ((format == FMT_ASCII) || (format == FMT_TRIG))
+        {
+            bits::loop();
+        }
+        else if (format == FMT_M4L)
+        {
+            m4l::loop();
+        }
+        else
+        {
+            midi::loop();
+        }
+        // Changes made by the loop first, so a tick does not take them.
+        if (hostDacBits() != last)
+        {
+            last = hostDacBits();
+            recordChange(micros(), last);
+        }
+        if ((TIMSK1 & _BV(OCIE1A)) != 0)
+        {
+            unsigned long due = (micros() - start_us) / (1000000L / TRIGQ_TICK_RATE);
+            while (isr_done < due)
+            {
+                hostTimer1CompA();
+                isr_done++;
+                if (hostDacBits() != last)
+                {
+                    last = hostDacBits();
+                    recordChange(start_us + isr_done * (1000000L / TRIGQ_TICK_RATE), last);
+                }
+            }
+        }
+    }
+}
+
+// ============================================================================
+// Player:
+// ============================================================================
+
+static void sleepUntil(unsigned long us)
+{
+    while ((long)(us - micros()) > 0)
+    {
+        unsigned long left = us - micros();
+        if ((long)left > 300)
+        {
+            usleep(left - 200);
+        }
+    }
+}
+
+/* sendBytes
+ - Write bytes to the master side, paced at the baud rate (10 bits a
+   byte) like a UART, or all at once for baud 0. Returns the time just
+   before the last byte was written.
+*/
+static unsigned long sendBytes(int fd, const std::string& data, long baud)
+{
+    static unsigned long link_free = 0;
+    unsigned long stamp = micros();
+    if (baud == 0)
+    {
+        size_t done = 0;
+        while (done < data.size())
+        {
+            ssize_t n = write(fd, data.data() + done, data.size() - done);
+            if (n > 0)
+            {
+                done += n;
+            }
+        }
+        return stamp;
+    }
+    unsigned long byte_us = 10000000L / baud;
+    if ((long)(micros() - link_free) > 0)
+    {
+        link_free = micros();
+    }
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        sleepUntil(link_free);
+        stamp = micros();
+        while (write(fd, &data[i], 1) != 1)
+        {
+        }
+        link_free += byte_us;
+    }
+    return stamp;
+}
+
+/* readReply
+ - Read the master side till a '[...]' line arrives (or the time out).
+*/
+static std::string readReply(int fd, int timeout_ms)
+{
+    std::string reply;
+    unsigned long end = millis() + timeout_ms;
+    while ((long)(end - millis()) > 0)
+    {
+        struct pollfd p;
+        char buf[64];
+        p.fd = fd;
+        p.events = POLLIN;
+        if (poll(&p, 1, 10) > 0)
+        {
+            ssize_t n = read(fd, buf, sizeof(buf));
+            if (n > 0)
+            {
+                reply.append(buf, n);
+            }
+        }
+        size_t close_at = reply.find(']');
+        if ((reply.find('[') != std::string::npos) && (close_at != std::string::npos))
+        {
+            return reply.substr(reply.find('['), close_at - reply.find('[') + 1);
+        }
+    }
+    return reply;
+}
+
+static int randomRange(int low, int high)
+{
+    return low + (rand() % (high - low + 1));
+}
+
+static std::string numberFrame(int value)
+{
+    return "[" + std::to_string(value) + "]";
+}
+
+/* fuzzFrame
+ - Junk to send before a good '[n]' frame, and what ssbArdM4L will count
+   for it. The ascii patch ignores all of it (its sample restarts at '[').
+*/
+static std::string fuzzFrame(int format, Expected* expect)
+{
+    int kind = randomRange(0, 2);
+    std::string junk;
+    if (kind == 0)
+    {
+        // Noise outside a frame.
+        int len = randomRange(1, 6);
+        for (int i = 0; i < len; i++)
+        {
+            junk += (char)randomRange('a', 'z');
+        }
+        expect->errors += len;
+    }
+    else if (kind == 1)
+    {
+        // A frame never closed, the next open drops it.
+        junk = "[" + std::to_string(randomRange(0, 1023));
+        expect->dropped++;
+    }
+    else
+    {
+        // Over long: dropped at M4L_MAX_FRAME_LEN, the rest and the close
+        // are chars outside a frame.
+        int len = randomRange(M4L_MAX_FRAME_LEN + 1, M4L_MAX_FRAME_LEN + 20);
+        junk = "[" + std::string(len, 'x') + "]";
+        expect->dropped++;
+        expect->errors += len - M4L_MAX_FRAME_LEN;
+        if (format == FMT_ASCII)
+        {
+            // The patch would take it as 0.
+            junk = "[" + std::string(8, 'x');
+        }
+    }
+    return junk;
+}
+
+static void playNumbers(int fd, const Options& opt, std::vector<Sent>* sent, Expected* expect)
+{
+    int last = 0;
+    for (int i = 0; i < opt.count; i++)
+    {
+        int value;
+        do
+        {
+            value = randomRange(0, 1023);
+        } while ((value >> 2) == (last >> 2));
+        last = value;
+        std::string data;
+        if ((opt.fuzz == true) && (randomRange(0, 4) == 0))
+        {
+            data = fuzzFrame(opt.format, expect);
+        }
+        data += numberFrame(value);
+        Sent frame;
+        frame.us = sendBytes(fd, data, opt.baud);
+        frame.expect = (value >> 2) & 0xFF;
+        frame.at_ms = 0;
+        sent->push_back(frame);
+        expect->frames++;
+    }
+}
+
+static void playMidi(int fd, const Options& opt, std::vector<Sent>* sent, Expected* expect)
+{
+    byte wire_status = 0;
+    int last = 0;
+    for (int i = 0; i < opt.count; i++)
+    {
+        std::string data;
+        int note = randomRange(36, 84);
+        int velocity;
+        do
+        {
+            velocity = randomRange(1, 127);
+        } while (velocity == last);
+        last = velocity;
+        if ((opt.fuzz == true) && (randomRange(0, 3) == 0))
+        {
+            int kind = randomRange(0, 2);
+            if (kind == 0)
+            {
+                // Sysex, skipped with no errors. Ends running status.
+                data += (char)0xF0;
+                for (int j = randomRange(1, 20); j > 0; j--)
+                {
+                    data += (char)randomRange(0, 0x7F);
+                }
+                data += (char)0xF7;
+                wire_status = 0;
+            }
+            else if (kind == 1)
+            {
+                // Note on cut short, an error when the next status comes.
+                data += (char)0x90;
+                data += (char)note;
+                expect->errors++;
+                wire_status = 0;
+            }
+            else
+            {
+                data += (char)0xF8;
+            }
+        }
+        if (wire_status != 0x90)
+        {
+            data += (char)0x90;
+            wire_status = 0x90;
+        }
+        data += (char)note;
+        if ((opt.fuzz == true) && (randomRange(0, 3) == 0))
+        {
+            // Clock in the middle of the message.
+            data += (char)0xF8;
+        }
+        data += (char)velocity;
+        Sent frame;
+        frame.us = sendBytes(fd, data, opt.baud);
+        frame.expect = (velocity << 1) & 0xFF;
+        frame.at_ms = 0;
+        sent->push_back(frame);
+        // Note off as a velocity 0 note on (running status).
+        data = std::string(1, (char)note) + std::string(1, (char)0);
+        sendBytes(fd, data, opt.baud);
+        expect->frames += 2;
+    }
+}
+
+static void playTrig(int fd, const Options& opt, std::vector<Sent>* sent, Expected* expect)
+{
+    unsigned long sync_us;
+    unsigned long at_ms = 0;
+    sendBytes(fd, "[0,0]", opt.baud);
+    sync_us = micros();
+    for (int i = 0; i < opt.count; i++)
+    {
+        int delta = randomRange(8, 40);
+        int mask = randomRange(1, 255);
+        at_ms += delta;
+        // Send lead_ms before the event is due.
+        sleepUntil(sync_us + (at_ms * 1000) - (opt.lead_ms * 1000));
+        Sent frame;
+        frame.us = sendBytes(fd, "[" + std::to_string(delta) + "," + std::to_string(mask) + "]", opt.baud);
+        frame.expect = mask;
+        frame.at_ms = at_ms;
+        sent->push_back(frame);
+        expect->frames++;
+    }
+    sleepUntil(sync_us + (at_ms * 1000) + 50000);
+}
+
+static std::string unescape(const std::string& text)
+{
+    std::string out;
+    for (size_t i = 0; i < text.size(); i++)
+    {
+        if ((text[i] == '\\') && (i + 3 < text.size() + 0) && (text[i + 1] == 'x'))
+        {
+            out += (char)strtol(text.substr(i + 2, 2).c_str(), 0, 16);
+            i += 3;
+        }
+        else
+        {
+            out += text[i];
+        }
+    }
+    return out;
+}
+
+static bool playScript(int fd, const Options& opt, std::vector<Sent>* sent)
+{
+    FILE* file = fopen(opt.script, "r");
+    char line[512];
+    if (file == 0)
+    {
+        printf("can not open %s\n", opt.script);
+        return false;
+    }
+    while (fgets(line, sizeof(line), file) != 0)
+    {
+        char* text;
+        long delay_ms = strtol(line, &text, 10);
+        std::string bytes;
+        if ((line[0] == '#') || (text == line))
+        {
+            continue;
+        }
+        while (*text == ' ')
+        {
+            text++;
+        }
+        bytes = unescape(std::string(text, strcspn(text, "\r\n")));
+        usleep(delay_ms * 1000);
+        Sent frame;
+        frame.us = sendBytes(fd, bytes, opt.baud);
+        frame.expect = -1;
+        frame.at_ms = 0;
+        sent->push_back(frame);
+    }
+    fclose(file);
+    usleep(100000);
+    return true;
+}
+
+// ============================================================================
+// Report:
+// ============================================================================
+
+static void check(bool is_ok, const char* what)
+{
+    if (is_ok == false)
+    {
+        printf("FAIL: %s\n", what);
+        failures++;
+    }
+}
+
+static void printSpread(const char* label, std::vector<long>& values)
+{
+    if (values.empty() == true)
+    {
+        printf("%s: none\n", label);
+        return;
+    }
+    std::sort(values.begin(), values.end());
+    double sum = 0;
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        sum += values[i];
+    }
+    // long is int on the host HAL.
+    printf("%s: min %d  mean %.0f  p50 %d  p99 %d  max %d\n", label,
+           values.front(), sum / values.size(), values[values.size() / 2],
+           values[(values.size() * 99) / 100], values.back());
+}
+
+/* matchLatency
+ - Each frame to the first later change to its expected bits (or any
+   change before the next frame, for a script).
+*/
+static void matchLatency(const std::vector<Sent>& sent, std::vector<long>* latency, int* missing)
+{
+    size_t next = 0;
+    for (size_t i = 0; i < sent.size(); i++)
+    {
+        size_t look = next;
+        bool found = false;
+        while (look < changes.size())
+        {
+            const DacChange& change = changes[look];
+            if ((sent[i].expect < 0) && (i + 1 < sent.size()) && ((long)(change.us - sent[i + 1].us) >= 0))
+            {
+                break;
+            }
+            if (((long)(change.us - sent[i].us) >= 0) &&
+                ((sent[i].expect < 0) || (change.bits == sent[i].expect)))
+            {
+                found = true;
+                break;
+            }
+            look++;
+        }
+        if (found == true)
+        {
+            latency->push_back((long)(changes[look].us - sent[i].us));
+            next = look + 1;
+        }
+        else
+        {
+            (*missing)++;
+        }
+    }
+}
+
+/* reportTrig
+ - Rising edges are the fired events. The spacing of each pair against
+   its delta is the timing error (the interrupt fires on 50us ticks).
+*/
+static void reportTrig(const std::vector<Sent>& sent)
+{
+    std::vector<long> spacing;
+    std::vector<long> lead;
+    std::vector<DacChange> fires;
+    byte last = 0;
+    int wrong_mask = 0;
+    for (size_t i = 0; i < changes.size(); i++)
+    {
+        byte rising = changes[i].bits & ~last;
+        if (rising != 0)
+        {
+            DacChange fire;
+            fire.us = changes[i].us;
+            fire.bits = rising;
+            fires.push_back(fire);
+        }
+        last = changes[i].bits;
+    }
+    for (size_t i = 0; (i < fires.size()) && (i < sent.size()); i++)
+    {
+        if (fires[i].bits != sent[i].expect)
+        {
+            wrong_mask++;
+        }
+        lead.push_back((long)(fires[i].us - sent[i].us));
+        if (i > 0)
+        {
+            long want = (long)(sent[i].at_ms - sent[i - 1].at_ms) * 1000;
+            spacing.push_back(labs((long)(fires[i].us - fires[i - 1].us) - want));
+        }
+    }
+    printf("events sent %u, fired %u, wrong mask %d, late %u, queue full %u\n",
+           (unsigned int)sent.size(), (unsigned int)fires.size(), wrong_mask,
+           bits::trigQueue.getLateCount(), bits::trigQueue.getFullCount());
+    printSpread("spacing error (us)", spacing);
+    printSpread("frame to fire (us)", lead);
+    check(fires.size() == sent.size(), "every event fired once");
+    check(wrong_mask == 0, "fired masks match");
+}
+
+static void reportStats(const Options& opt, const std::string& reply, const Expected& expect)
+{
+    int values[3] = {-1, -1, -1};
+    int got = sscanf(reply.c_str(), "[%d,%d,%d]", &values[0], &values[1], &values[2]);
+    if (opt.format == FMT_M4L)
+    {
+        printf("device stats: frames %d  dropped %d  errors %d  (sent: %u, %u, %u)\n",
+               values[0], values[1], values[2], expect.frames, expect.dropped, expect.errors);
+        check(got == 3, "stats reply");
+        check(values[0] == (int)expect.frames, "frame count");
+        check(values[1] == (int)expect.dropped, "dropped count");
+        check(values[2] == (int)expect.errors, "error count");
+    }
+    else
+    {
+        printf("device stats: messages %d  errors %d  (sent: %u, %u)\n",
+               values[0], values[1], expect.frames, expect.errors);
+        check(got == 2, "stats reply");
+        check(values[0] == (int)expect.frames, "message count");
+        check(values[1] == (int)expect.errors, "error count");
+    }
+}
+
+static bool parseOptions(int argc, char** argv, Options* opt)
+{
+    opt->format = -1;
+    opt->count = 200;
+    opt->baud = -1;
+    opt->fuzz = false;
+    opt->seed = 1;
+    opt->lead_ms = 30;
+    opt->script = 0;
+    for (int f = 0; (argc > 1) && (f < FMT_COUNT); f++)
+    {
+        if (strcmp(argv[1], FMT_NAMES[f]) == 0)
+        {
+            opt->format = f;
+        }
+    }
+    for (int i = 2; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-f") == 0)
+        {
+            opt->fuzz = true;
+        }
+        else if ((i + 1 < argc) && (argv[i][0] == '-'))
+        {
+            switch (argv[i][1])
+            {
+                case 'n':
+                    opt->count = atoi(argv[++i]);
+                    break;
+                case 'b':
+                    opt->baud = atol(argv[++i]);
+                    break;
+                case 'r':
+                    opt->seed = atoi(argv[++i]);
+                    break;
+                case 'l':
+                    opt->lead_ms = atoi(argv[++i]);
+                    break;
+                case 's':
+                    opt->script = argv[++i];
+                    break;
+                default:
+                    return false;
+            }
+        }
+        else
+        {
+            return false;
+        }
+    }
+    if (opt->baud < 0)
+    {
+        opt->baud = 9600;
+        if (opt->format == FMT_MIDI)
+        {
+            opt->baud = MIDI_BAUD;
+        }
+    }
+    return (opt->format >= 0);
+}
+
+int main(int argc, char** argv)
+{
+    Options opt;
+    std::vector<Sent> sent;
+    Expected expect = {0, 0, 0};
+    unsigned long start_us;
+    unsigned long end_us;
+    if (parseOptions(argc, argv, &opt) == false)
+    {
+        printf("usage: m4lLink <ascii|m4l|trig|midi> [-n frames] [-b baud] [-f] [-r seed] [-l lead_ms] [-s script]\n");
+        return 2;
+    }
+    srand(opt.seed);
+
+    // The pty pair. The slave is raw (no echo, no line editing) and non
+    // blocking, as the device polls it.
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if ((master < 0) || (grantpt(master) != 0) || (unlockpt(master) != 0))
+    {
+        printf("can not open a pty\n");
+        return 2;
+    }
+    int slave = open(ptsname(master), O_RDWR | O_NOCTTY | O_NONBLOCK);
+    struct termios tio;
+    tcgetattr(slave, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(slave, TCSANOW, &tio);
+    Serial.hostAttach(slave);
+    hostUseRealTime(true);
+
+    device_running = true;
+    std::thread device(deviceThread, opt.format);
+    usleep(20000);
+
+    start_us = micros();
+    if (opt.script != 0)
+    {
+        if (playScript(master, opt, &sent) == false)
+        {
+            failures++;
+        }
+    }
+    else if (opt.format == FMT_TRIG)
+    {
+        playTrig(master, opt, &sent, &expect);
+    }
+    else if (opt.format == FMT_MIDI)
+    {
+        playMidi(master, opt, &sent, &expect);
+    }
+    else
+    {
+        playNumbers(master, opt, &sent, &expect);
+    }
+    end_us = micros();
+    std::string reply;
+    if ((opt.script == 0) && (opt.format == FMT_M4L))
+    {
+        sendBytes(master, "[-1]", opt.baud);
+        expect.frames++;
+        reply = readReply(master, 1000);
+    }
+    else if ((opt.script == 0) && (opt.format == FMT_MIDI))
+    {
+        sendBytes(master, std::string(1, (char)0xFC), opt.baud);
+        reply = readReply(master, 1000);
+    }
+    else
+    {
+        usleep(100000);
+    }
+    device_running = false;
+    device.join();
+
+    double seconds = (end_us - start_us) / 1000000.0;
+    printf("m4lLink %s: %u frames at %d baud", FMT_NAMES[opt.format],
+           (unsigned int)sent.size(), opt.baud);
+    if (opt.baud == 0)
+    {
+        printf(" (unpaced)");
+    }
+    if (opt.fuzz == true)
+    {
+        printf(", fuzzed");
+    }
+    printf("\n");
+    printf("sent in %.3fs, %.1f frames/s, %u DAC changes\n", seconds,
+           sent.size() / seconds, (unsigned int)changes.size());
+    if ((opt.format == FMT_TRIG) && (opt.script == 0))
+    {
+        reportTrig(sent);
+    }
+    else
+    {
+        std::vector<long> latency;
+        int missing = 0;
+        matchLatency(sent, &latency, &missing);
+        printSpread("frame to DAC latency (us)", latency);
+        printf("frames with no DAC change: %d\n", missing);
+        if (opt.script == 0)
+        {
+            check(missing == 0, "every frame changed the DAC");
+        }
+    }
+    if ((opt.script == 0) && ((opt.format == FMT_M4L) || (opt.format == FMT_MIDI)))
+    {
+        reportStats(opt, reply, expect);
+    }
+    close(slave);
+    close(master);
+    if (failures > 0)
+    {
+        printf("FAIL (%d)\n", failures);
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,137 @@
+#!/usr/bin/env python3
+"""
+makeFixtures.py - Writes the Standard MIDI Files used by midiFileTest.
+
+    legato.mid  Format 0. Overlapping (legato) notes, note off as note on
+                with velocity 0 under running status, a repeated note and
+                more held notes than ssbMidiIn keeps.
+    sysex.mid   Format 1, two tracks. A GM reset, a long dump and a dump
+                split into an F0 packet and an F7 continuation, between
+                notes that are held across them.
+    mixed.mid   Format 0. Several channels, CC, program change, channel and
+                poly pressure, pitch bend and All Notes Off with notes held.
+
+    Run from this folder: python3 makeFixtures.py
+
+  Created by Peter Fawcett, Oct 18. 2026.
+"""
+
+import struct
+
+PPQ = 480
+
+
+def vlq(value):
+    out = [value & 0x7F]
+    value >>= 7
+    while value > 0:
+        out.insert(0, 0x80 | (value & 0x7F))
+        value >>= 7
+    return bytes(out)
+
+
+def track(events):
+    """events: list of (abs_tick, bytes). Bytes are written as given, so
+    running status is up to the caller."""
+    data = b""
+    last = 0
+    for tick, raw in sorted(events, key=lambda e: e[0]):
+        data += vlq(tick - last) + raw
+        last = tick
+    data += vlq(0) + b"\xFF\x2F\x00"
+    return b"MTrk" + struct.pack(">I", len(data)) + data
+
+
+def smf(fmt, tracks):
+    head = b"MThd" + struct.pack(">IHHH", 6, fmt, len(tracks), PPQ)
+    return head + b"".join(tracks)
+
+
+def meta(kind, payload):
+    return bytes([0xFF, kind]) + vlq(len(payload)) + payload
+
+
+def sysex(payload, first=True):
+    lead = 0xF0
+    if first is False:
+        lead = 0xF7
+    return bytes([lead]) + vlq(len(payload)) + payload
+
+
+def legato():
+    ev = []
+    ev.append((0, meta(0x03, b"legato")))
+    ev.append((0, meta(0x51, b"\x07\xA1\x20")))
+    # A held, B played over it and let go: the gate stays on A.
+    ev.append((0, b"\x90\x3C\x64"))
+    ev.append((240, b"\x40\x5A"))           # running status note on
+    ev.append((480, b"\x40\x00"))           # running status, velocity 0 off
+    ev.append((600, b"\x43\x50"))
+    ev.append((720, b"\x80\x3C\x40"))
+    ev.append((960, b"\x80\x43\x40"))
+    # Repeated note.
+    ev.append((1200, b"\x90\x3E\x70"))
+    ev.append((1300, b"\x3E\x71"))
+    ev.append((1400, b"\x80\x3E\x00"))
+    # Ten notes held, more than MIDI_HELD_MAX, let go lowest first.
+    tick = 1600
+    ev.append((tick, b"\x90\x30\x60"))
+    for note in range(0x31, 0x3A):
+        tick += 10
+        ev.append((tick, bytes([note, 0x60])))
+    for note in range(0x30, 0x3A):
+        tick += 20
+        ev.append((tick, bytes([note, 0x00])))
+    return smf(0, [track(ev)])
+
+
+def sysex_file():
+    tempo = []
+    tempo.append((0, meta(0x51, b"\x07\xA1\x20")))
+    tempo.append((0, meta(0x58, b"\x04\x02\x18\x08")))
+    tempo.append((0, sysex(b"\x7E\x7F\x09\x01\xF7")))
+    notes = []
+    notes.append((0, meta(0x03, b"notes")))
+    notes.append((10, b"\x90\x30\x7F"))
+    dump = bytes([0x43, 0x00, 0x09, 0x20, 0x00]) + bytes((i * 7) & 0x7F for i in range(120)) + b"\xF7"
+    notes.append((100, sysex(dump)))
+    notes.append((200, b"\x90\x34\x50"))
+    notes.append((300, sysex(bytes([0x41, 0x10, 0x42, 0x12]) + bytes(range(0x20, 0x50)))))
+    notes.append((310, sysex(bytes(range(0x50, 0x70)) + b"\xF7", False)))
+    notes.append((400, b"\x90\x34\x00"))
+    notes.append((500, b"\x80\x30\x00"))
+    notes.append((600, sysex(b"\x7E\x7F\x09\x01\xF7")))
+    notes.append((700, b"\x90\x3C\x40"))
+    notes.append((900, b"\x80\x3C\x40"))
+    return smf(1, [track(tempo), track(notes)])
+
+
+def mixed():
+    ev = []
+    ev.append((0, b"\xC0\x05"))
+    ev.append((0, b"\xB0\x01\x00"))
+    ev.append((10, b"\x90\x40\x60"))
+    ev.append((20, b"\xB0\x01\x10"))
+    for i in range(1, 12):
+        ev.append((20 + i * 5, bytes([0x01, 0x10 + i * 8])))
+    ev.append((100, b"\xE0\x00\x40"))
+    ev.append((110, b"\x00\x50"))
+    ev.append((120, b"\xD0\x30"))
+    ev.append((130, b"\x20"))
+    ev.append((140, b"\xA0\x40\x22"))
+    ev.append((150, b"\x91\x45\x30"))
+    ev.append((160, b"\x99\x24\x7F"))
+    ev.append((170, b"\x89\x24\x00"))
+    ev.append((180, b"\x90\x43\x55"))
+    ev.append((200, b"\xB0\x7B\x00"))         # All notes off, two held.
+    ev.append((300, b"\x90\x48\x40"))
+    ev.append((400, b"\x80\x48\x40"))
+    ev.append((410, b"\x81\x45\x40"))
+    return smf(0, [track(ev)])
+
+
+if __name__ == "__main__":
+    for name, data in (("legato.mid", legato()), ("sysex.mid", sysex_file()), ("mixed.mid", mixed())):
+        with open("fixtures/" + name, "wb") as f:
+            f.write(data)
+        print(name, len(data), "bytes")
@@ -0,0 +1,458 @@
+/*
+  midiFileTest.cpp - Feeds Standard MIDI Files to ssbMidiIn.parseByte a
+    byte at a time, as a USB-MIDI to serial bridge would send them, and
+    checks every message against a reference model of the file.
+
+    The file events are sent as wire bytes: running status is used where
+    the status repeats, sysex packets are sent raw, meta events are not
+    sent, and a clock (0xF8) is sent every 24th of a beat. Each clock is
+    put in the middle of the next message (after its first byte), to
+    check real time bytes do not break a message or running status.
+    After each message the type, note, velocity, CC, gate and gate note
+    are checked, and at the end the message count, the clock count and
+    that there were no errors.
+
+    A few hand made streams check the cases a file does not (data with
+    no status, a message cut short, an exclusive never closed).
+
+    Usage: midiFileTest [file.mid ...]   (default: the fixtures folder)
+
+  Created by Peter Fawcett, Oct 18. 2026.
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#include <vector>
+#include <algorithm>
+#include <Arduino.h>
+#include <ssbMidiIn.h>
+
+// One event from a MIDI file, with the bytes to send for it.
+struct FileEvent
+{
+    unsigned long   tick;       // Absolute time (ticks).
+    int             track;      // Track and index keep the file order
+    int             index;      // for events at the same tick.
+    bool            is_sysex;
+    std::vector<byte> bytes;    // Full channel message or sysex packet.
+};
+
+static int failures = 0;
+
+static void check(bool is_ok, const char* what, const char* file, int event)
+{
+    if (is_ok == false)
+    {
+        printf("  FAIL %s: %s (event %d)\n", file, what, event);
+        failures++;
+    }
+}
+
+static bool eventOrder(const FileEvent& a, const FileEvent& b)
+{
+    if (a.tick != b.tick)
+    {
+        return (a.tick < b.tick);
+    }
+    if (a.track != b.track)
+    {
+        return (a.track < b.track);
+    }
+    return (a.index < b.index);
+}
+
+// ============================================================================
+// Standard MIDI File reader:
+// ============================================================================
+
+static unsigned long readVlq(const std::vector<byte>& data, size_t* pos)
+{
+    unsigned long value = 0;
+    byte b;
+    do
+    {
+        b = data[(*pos)++];
+        value = (value << 7) | (b & 0x7F);
+    } while ((b & 0x80) != 0);
+    return value;
+}
+
+static unsigned long readBig(const std::vector<byte>& data, size_t pos, int len)
+{
+    unsigned long value = 0;
+    for (int i = 0; i < len; i++)
+    {
+        value = (value << 8) | data[pos + i];
+    }
+    return value;
+}
+
+/* readMidiFile
+ - All channel and sysex events of all tracks, merged in time order.
+   Returns the ticks per quarter note, or 0 if the file can not be read.
+*/
+static int readMidiFile(const char* path, std::vector<FileEvent>* events)
+{
+    std::vector<byte> data;
+    FILE* file = fopen(path, "rb");
+    int c;
+    if (file == 0)
+    {
+        return 0;
+    }
+    while ((c = fgetc(file)) != EOF)
+    {
+        data.push_back((byte)c);
+    }
+    fclose(file);
+    if ((data.size() < 14) || (memcmp(&data[0], "MThd", 4) != 0))
+    {
+        return 0;
+    }
+    int tracks = readBig(data, 10, 2);
+    int ppq = readBig(data, 12, 2);
+    size_t pos = 8 + readBig(data, 4, 4);
+    for (int track = 0; track < tracks; track++)
+    {
+        if ((pos + 8 > data.size()) || (memcmp(&data[pos], "MTrk", 4) != 0))
+        {
+            return 0;
+        }
+        size_t end = pos + 8 + readBig(data, pos + 4, 4);
+        unsigned long tick = 0;
+        byte status = 0;
+        int index = 0;
+        pos += 8;
+        while (pos < end)
+        {
+            tick += readVlq(data, &pos);
+            byte lead = data[pos];
+            FileEvent event;
+            event.tick = tick;
+            event.track = track;
+            event.index = index++;
+            event.is_sysex = false;
+            if (lead == 0xFF)
+            {
+                // Meta event, not sent on the wire.
+                pos += 2;
+                pos += readVlq(data, &pos);
+                status = 0;
+                continue;
+            }
+            if ((lead == 0xF0) || (lead == 0xF7))
+            {
+                // An F0 packet is sent with its F0, an F7 packet (a
+                // continuation) is sent as it is stored.
+                pos++;
+                unsigned long len = readVlq(data, &pos);
+                if (lead == 0xF0)
+                {
+                    event.bytes.push_back(0xF0);
+                }
+                event.bytes.insert(event.bytes.end(), data.begin() + pos, data.begin() + pos + len);
+                event.is_sysex = true;
+                pos += len;
+                status = 0;
+                events->push_back(event);
+                continue;
+            }
+            if ((lead & 0x80) != 0)
+            {
+                status = lead;
+                pos++;
+            }
+            event.bytes.push_back(status);
+            event.bytes.push_back(data[pos++]);
+            if (((status & 0xF0) != 0xC0) && ((status & 0xF0) != 0xD0))
+            {
+                event.bytes.push_back(data[pos++]);
+            }
+            events->push_back(event);
+        }
+        pos = end;
+    }
+    std::sort(events->begin(), events->end(), eventOrder);
+    return ppq;
+}
+
+// ============================================================================
+// Reference model (what ssbMidiIn should report):
+// ============================================================================
+
+struct Model
+{
+    std::vector<byte>   held;
+    byte                note;
+    byte                velocity;
+    byte                cc_number;
+    byte                cc_value;
+
+    Model() : note(0), velocity(0), cc_number(0), cc_value(0) {}
+
+    void release(byte n)
+    {
+        std::vector<byte>::iterator it = std::find(held.begin(), held.end(), n);
+        if (it != held.end())
+        {
+            held.erase(it);
+        }
+    }
+
+    byte apply(const std::vector<byte>& msg)
+    {
+        byte type = msg[0] & 0xF0;
+        if ((type == 0x90) && (msg[2] > 0))
+        {
+            note = msg[1];
+            velocity = msg[2];
+            release(note);
+            if (held.size() >= MIDI_HELD_MAX)
+            {
+                held.erase(held.begin());
+            }
+            held.push_back(note);
+            return MIDI_NOTE_ON;
+        }
+        if ((type == 0x90) || (type == 0x80))
+        {
+            note = msg[1];
+            velocity = msg[2];
+            release(note);
+            return MIDI_NOTE_OFF;
+        }
+        if (type == 0xB0)
+        {
+            cc_number = msg[1];
+            cc_value = msg[2];
+            if ((cc_number == 120) || (cc_number == 123))
+            {
+                held.clear();
+            }
+            return MIDI_CC;
+        }
+        return MIDI_NONE;
+    }
+
+    byte gateNote()
+    {
+        if (held.empty() == true)
+        {
+            return note;
+        }
+        return held.back();
+    }
+};
+
+// ============================================================================
+// File test:
+// ============================================================================
+
+static void testFile(const char* path)
+{
+    std::vector<FileEvent> events;
+    int ppq = readMidiFile(path, &events);
+    if (ppq == 0)
+    {
+        printf("  FAIL %s: can not read the file\n", path);
+        failures++;
+        return;
+    }
+    ssbMidiIn midi = ssbMidiIn(MIDI_OMNI);
+    Model model;
+    unsigned long clock_ticks = ppq / 24;
+    unsigned long next_clock = 0;
+    unsigned int clocks_due = 0;
+    unsigned int clocks_read = 0;
+    unsigned int messages = 0;
+    unsigned int wire_bytes = 0;
+    byte wire_status = 0;
+    for (size_t e = 0; e < events.size(); e++)
+    {
+        FileEvent& event = events[e];
+        std::vector<byte> wire = event.bytes;
+        while (next_clock <= event.tick)
+        {
+            clocks_due++;
+            next_clock += clock_ticks;
+        }
+        if (event.is_sysex == true)
+        {
+            wire_status = 0;
+        }
+        else if (event.bytes[0] == wire_status)
+        {
+            // Running status on the wire.
+            wire.erase(wire.begin());
+        }
+        else
+        {
+            wire_status = event.bytes[0];
+        }
+        byte result = MIDI_NONE;
+        for (size_t i = 0; i < wire.size(); i++)
+        {
+            byte got = midi.parseByte(wire[i]);
+            wire_bytes++;
+            if (got != MIDI_NONE)
+            {
+                result = got;
+            }
+            if (i == 0)
+            {
+                while (clocks_due > 0)
+                {
+                    check(midi.parseByte(0xF8) == MIDI_CLOCK, "clock mid message", path, e);
+                    clocks_due--;
+                    clocks_read++;
+                    wire_bytes++;
+                }
+            }
+            else
+            {
+                check(got == MIDI_NONE || i == wire.size() - 1, "message ended early", path, e);
+            }
+        }
+        if (event.is_sysex == true)
+        {
+            check(result == MIDI_NONE, "sysex returned a message", path, e);
+            continue;
+        }
+        messages++;
+        byte expect = model.apply(event.bytes);
+        check(result == expect, "message type", path, e);
+        if ((expect == MIDI_NOTE_ON) || (expect == MIDI_NOTE_OFF))
+        {
+            check(midi.getNote() == model.note, "note", path, e);
+            check(midi.getVelocity() == model.velocity, "velocity", path, e);
+        }
+        if (expect == MIDI_CC)
+        {
+            check(midi.getCCNumber() == model.cc_number, "cc number", path, e);
+            check(midi.getCCValue() == model.cc_value, "cc value", path, e);
+        }
+        check(midi.getGate() == (model.held.empty() == false), "gate", path, e);
+        check(midi.getGateNote() == model.gateNote(), "gate note", path, e);
+    }
+    check(midi.getMessageCount() == messages, "message count", path, -1);
+    check(midi.getErrorCount() == 0, "error count", path, -1);
+    check(midi.getGate() == false, "gate left on at the end", path, -1);
+    printf("  %s: %u events, %u wire bytes, %u messages, %u clocks, %u errors\n",
+           path, (unsigned int)events.size(), wire_bytes, midi.getMessageCount(),
+           clocks_read, midi.getErrorCount());
+}
+
+// ============================================================================
+// Hand made streams:
+// ============================================================================
+
+static byte feed(ssbMidiIn* midi, const byte* bytes, int len)
+{
+    byte last = MIDI_NONE;
+    for (int i = 0; i < len; i++)
+    {
+        byte got = midi->parseByte(bytes[i]);
+        if (got != MIDI_NONE)
+        {
+            last = got;
+        }
+    }
+    return last;
+}
+
+static void testStreams()
+{
+    const char* name = "streams";
+    {
+        // Exclusive data is skipped, a clock inside it still comes out.
+        ssbMidiIn midi = ssbMidiIn(MIDI_OMNI);
+        const byte s1[] = {0xF0, 0x43, 0x10, 0x4C, 0x00, 0x00, 0x7E, 0x00};
+        const byte s2[] = {0x11, 0x22, 0xF7, 0x90, 0x3C, 0x40};
+        check(feed(&midi, s1, sizeof(s1)) == MIDI_NONE, "sysex data", name, 1);
+        check(midi.parseByte(0xF8) == MIDI_CLOCK, "clock in sysex", name, 1);
+        check(feed(&midi, s2, sizeof(s2)) == MIDI_NOTE_ON, "note after sysex", name, 1);
+        check(midi.getErrorCount() == 0, "sysex counted as errors", name, 1);
+    }
+    {
+        // An exclusive never closed ends at the next status byte.
+        ssbMidiIn midi = ssbMidiIn(MIDI_OMNI);
+        const byte s[] = {0xF0, 0x01, 0x02, 0x03, 0x90, 0x3C, 0x40};
+        check(feed(&midi, s, sizeof(s)) == MIDI_NOTE_ON, "note after open sysex", name, 2);
+        check(midi.getErrorCount() == 0, "open sysex errors", name, 2);
+    }
+    {
+        // System common data (song position) is skipped as well.
+        ssbMidiIn midi = ssbMidiIn(MIDI_OMNI);
+        const byte s[] = {0xF2, 0x10, 0x20, 0xB0, 0x07, 0x64};
+        check(feed(&midi, s, sizeof(s)) == MIDI_CC, "cc after song position", name, 3);
+        check(midi.getErrorCount() == 0, "song position errors", name, 3);
+    }
+    {
+        // Data with no status, and a message cut short, are errors.
+        ssbMidiIn midi = ssbMidiIn(MIDI_OMNI);
+        const byte s[] = {0x3C, 0x40, 0x90, 0x3C, 0x80, 0x3C, 0x40};
+        check(feed(&midi, s, sizeof(s)) == MIDI_NOTE_OFF, "note off after errors", name, 4);
+        check(midi.getErrorCount() == 3, "error count", name, 4);
+    }
+    {
+        // A held, B played and let go: the gate stays on, back on A.
+        ssbMidiIn midi = ssbMidiIn(MIDI_OMNI);
+        const byte s1[] = {0x90, 0x3C, 0x40, 0x40, 0x40, 0x80, 0x40, 0x00};
+        const byte s2[] = {0x80, 0x3C, 0x00};
+        feed(&midi, s1, sizeof(s1));
+        check(midi.getGate() == true, "gate with A held", name, 5);
+        check(midi.getGateNote() == 0x3C, "gate back on A", name, 5);
+        feed(&midi, s2, sizeof(s2));
+        check(midi.getGate() == false, "gate after A", name, 5);
+    }
+    {
+        // Other channels are parsed (and counted) but do not gate.
+        ssbMidiIn midi = ssbMidiIn(2);
+        const byte s[] = {0x91, 0x3C, 0x40, 0x92, 0x3E, 0x40};
+        check(feed(&midi, s, sizeof(s)) == MIDI_NOTE_ON, "channel filter", name, 6);
+        check(midi.getGateNote() == 0x3E, "channel 2 ignored", name, 6);
+        check(midi.getMessageCount() == 2, "channel message count", name, 6);
+    }
+    printf("  streams: done\n");
+}
+
+int main(int argc, char** argv)
+{
+    static const char* fixtures[] = {"fixtures/legato.mid", "fixtures/sysex.mid", "fixtures/mixed.mid"};
+    printf("midiFileTest\n");
+    testStreams();
+    if (argc > 1)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            testFile(argv[i]);
+        }
+    }
+    else
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            testFile(fixtures[i]);
+        }
+    }
+    if (failures > 0)
+    {
+        printf("FAIL (%d)\n", failures);
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
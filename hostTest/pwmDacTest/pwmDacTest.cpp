@@ -0,0 +1,295 @@
+/*
+  pwmDacTest.cpp - Duty resolution and update cost of ssbPwmDac, and the
+    ssbMonoADSR_PWM patch that uses it.
+
+    Timer2 is modelled from the ATmega328 data sheet (fast PWM, 8 bit):
+    the counter runs 0 - 255, OCR2A is double buffered (a write takes
+    effect at the next BOTTOM), and the pin
+      COM2A1 (non inverting): set at BOTTOM, cleared after the compare
+                              match: high for counts 0 - OCR2A. OCR2A of
+                              0 is a one count spike, 255 is steady high.
+      COM2A1 and COM2A0:      the opposite, high for counts OCR2A+1 - 255.
+                              255 is steady low.
+      neither:                the PORTB bit (pin 11 is PB3).
+
+    Library checks:
+      - Timer2 set up for fast PWM, no prescale (carrier F_CPU / 256).
+      - Every value 0 - 1023: duty is exactly (value >> 2) / 256, 256
+        levels, monotonic, 0 is a steady low.
+      - output only writes OCR2A (no other Timer2 or port register).
+      - Time to take effect: up to one PWM cycle (256 clocks, 16us).
+      - end stops the timer and leaves the pin to PORTB.
+    Patch checks (ssbMonoADSR_PWM, built as it is, on virtual time):
+      - Through a gate on / off, the pin 11 duty follows the envelope
+        (and the inverted envelope with A5 up).
+      - DAC bit 6 (PB3) is never written high, the stage bits match the
+        envelope state.
+
+  Created by Peter Fawcett, Oct 18. 2026.
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#include <time.h>
+#include <Arduino.h>
+#include <ssbEnvelope.h>
+#include <ssbPwmDac.h>
+
+// The patch, built as it is, in its own namespace (with the prototypes the
+// Arduino IDE would add).
+namespace adsr
+{
+boolean gate_state(boolean gate, int currentGate);
+byte stage_bits(boolean gate, byte state, int value);
+void dacOutput(byte v);
+#include "../../ssbMonoADSR_PWM/ssbMonoADSR_PWM.ino"
+}
+
+const int   CLOCKS_PER_CYCLE    = 256;      // Fast PWM, no prescale.
+
+static int  failures            = 0;
+
+static void check(bool is_ok, const char* what, int value)
+{
+    if (is_ok == false)
+    {
+        if (failures < 20)
+        {
+            printf("FAIL: %s (%d)\n", what, value);
+        }
+        failures++;
+    }
+}
+
+// ============================================================================
+// Timer2 model:
+// ============================================================================
+
+/* pinHigh
+ - Pin 11 during a count of the PWM cycle, from the registers.
+*/
+static bool pinHigh(byte count)
+{
+    byte com = TCCR2A & (_BV(COM2A1) | _BV(COM2A0));
+    if (com == _BV(COM2A1))
+    {
+        return (count <= OCR2A);
+    }
+    if (com == (_BV(COM2A1) | _BV(COM2A0)))
+    {
+        return (count > OCR2A);
+    }
+    return ((PORTB & _BV(3)) != 0);
+}
+
+/* highCounts
+ - Clocks of a PWM cycle the pin is high (duty * 256).
+*/
+static int highCounts()
+{
+    int high = 0;
+    for (int count = 0; count < CLOCKS_PER_CYCLE; count++)
+    {
+        if (pinHigh((byte)count) == true)
+        {
+            high++;
+        }
+    }
+    return high;
+}
+
+// ============================================================================
+// Library:
+// ============================================================================
+
+static void testSetup(ssbPwmDac& pwm)
+{
+    pwm.begin();
+    check((TCCR2A & (_BV(WGM21) | _BV(WGM20))) == (_BV(WGM21) | _BV(WGM20)), "fast PWM mode", TCCR2A);
+    check((TCCR2B & _BV(WGM22)) == 0, "top is 255 (WGM22 clear)", TCCR2B);
+    check((TCCR2B & 0x07) == _BV(CS20), "no prescale", TCCR2B);
+    check((DDRB & _BV(3)) != 0, "pin 11 is an output", DDRB);
+    check(highCounts() == 0, "begin starts at 0", highCounts());
+    printf("carrier %d Hz, %d steps\n", (int)PWM_DAC_CARRIER_HZ, PWM_DAC_STEPS);
+}
+
+static void testResolution(ssbPwmDac& pwm)
+{
+    int last = -1;
+    int levels = 0;
+    for (int value = 0; value <= 1023; value++)
+    {
+        pwm.output(value);
+        int high = highCounts();
+        check(high == (value >> 2), "duty is value / 1024", value);
+        check(high >= last, "monotonic", value);
+        check(pwm.getValue() == (value >> 2), "getValue", value);
+        if (high != last)
+        {
+            levels++;
+        }
+        last = high;
+    }
+    pwm.output(0);
+    check(highCounts() == 0, "0 is a steady low", highCounts());
+    pwm.output(-50);
+    check(highCounts() == 0, "below 0 is 0", highCounts());
+    pwm.output(5000);
+    check(highCounts() == 255, "above 1023 is 255 / 256", highCounts());
+    check(levels == PWM_DAC_STEPS, "256 levels", levels);
+    pwm.output(1023);
+    printf("resolution: %d levels, 0 -> 0 / 256, 1023 -> %d / 256\n", levels, highCounts());
+
+    // What non inverting PWM would give: no 0, a spike at the bottom.
+    byte mode = TCCR2A;
+    int spike;
+    TCCR2A = _BV(COM2A1) | _BV(WGM21) | _BV(WGM20);
+    OCR2A = 0;
+    spike = highCounts();
+    OCR2A = 255;
+    printf("  (non inverting: OCR2A 0 -> %d / 256, OCR2A 255 -> %d / 256)\n", spike, highCounts());
+    TCCR2A = mode;
+}
+
+/* testCost
+ - output writes OCR2A and nothing else. OCR2A is double buffered, so a
+   write lands at the next BOTTOM: each cycle is all old or all new duty,
+   and the wait is the rest of the cycle the write was made in.
+*/
+static void testCost(ssbPwmDac& pwm)
+{
+    pwm.output(100);
+    byte tccr2a = TCCR2A;
+    byte tccr2b = TCCR2B;
+    byte timsk2 = TIMSK2;
+    byte portb = PORTB;
+    byte ddrb = DDRB;
+    byte ocr2a = OCR2A;
+    pwm.output(900);
+    check(TCCR2A == tccr2a, "output leaves TCCR2A", TCCR2A);
+    check(TCCR2B == tccr2b, "output leaves TCCR2B", TCCR2B);
+    check(TIMSK2 == timsk2, "output leaves TIMSK2", TIMSK2);
+    check(PORTB == portb, "output leaves PORTB", PORTB);
+    check(DDRB == ddrb, "output leaves DDRB", DDRB);
+    check(OCR2A != ocr2a, "output writes OCR2A", OCR2A);
+
+    // A write just after BOTTOM waits the whole cycle.
+    int worst = CLOCKS_PER_CYCLE;
+    printf("update: 1 register write (OCR2A), takes effect in up to %d clocks (%.1fus)\n",
+           worst, worst * 1000000.0 / F_CPU);
+
+    struct timespec start;
+    struct timespec end;
+    const int calls = 1000000;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (int i = 0; i < calls; i++)
+    {
+        pwm.output(i & 1023);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double ns = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / calls;
+    printf("  host: %.1fns a call (two compares, a shift and one store)\n", ns);
+}
+
+static void testEnd(ssbPwmDac& pwm)
+{
+    pwm.output(512);
+    pwm.end();
+    check(TCCR2A == 0, "end disconnects OC2A", TCCR2A);
+    check((TCCR2B & 0x07) == 0, "end stops Timer2", TCCR2B);
+    check(highCounts() == 0, "after end the pin is PORTB", highCounts());
+}
+
+// ============================================================================
+// Patch:
+// ============================================================================
+
+static unsigned long patch_ms = 0;
+
+static void runPatch(unsigned long ms, bool invert, int* peak)
+{
+    patch_ms += ms;
+    for (unsigned long i = 0; i < ms; i++)
+    {
+        hostAdvanceMicros(1000);
+        adsr::loop();
+        int env = adsr::envelopeVal;
+        int want = env >> 2;
+        if (invert == true)
+        {
+            want = (ENV_MAX - env) >> 2;
+        }
+        check(highCounts() == want, "pin 11 duty follows the envelope", env);
+        check((PORTB & _BV(3)) == 0, "DAC bit 6 is masked", PORTB);
+        byte bits = hostDacBits();
+        byte state = adsr::ENVELOPE.getState();
+        check(((bits & adsr::BIT_GATE) != 0) == (adsr::gateState == adsr::ON), "gate bit", bits);
+        check(((bits & adsr::BIT_ATTACK) != 0) == (state == ENV_ATTACK), "attack bit", bits);
+        check(((bits & adsr::BIT_SUSTAIN) != 0) == (state == ENV_SUSTAIN), "sustain bit", bits);
+        check(((bits & adsr::BIT_ACTIVE) != 0) == (env > 0), "active bit", bits);
+        if (env > *peak)
+        {
+            *peak = env;
+        }
+    }
+}
+
+static void testPatch()
+{
+    int peak = 0;
+    hostSetMicros(0);
+    hostSetAnalog(0, 100);          // Attack
+    hostSetAnalog(1, 150);          // Decay
+    hostSetAnalog(2, 700);          // Sustain
+    hostSetAnalog(3, 150);          // Release
+    hostSetAnalog(4, 0);            // Gate off
+    hostSetAnalog(5, 0);            // Not inverted
+    TCCR2A = 0;
+    TCCR2B = 0;
+    adsr::setup();
+    runPatch(20, false, &peak);
+    hostSetAnalog(4, 1023);
+    runPatch(1500, false, &peak);
+    check(adsr::ENVELOPE.getState() == ENV_SUSTAIN, "sustain reached", adsr::ENVELOPE.getState());
+    check(peak == ENV_MAX, "peak reached", peak);
+    hostSetAnalog(4, 0);
+    runPatch(1500, false, &peak);
+    check(adsr::envelopeVal == 0, "released to 0", adsr::envelopeVal);
+    hostSetAnalog(5, 1023);
+    hostSetAnalog(4, 1023);
+    runPatch(600, true, &peak);
+    hostSetAnalog(4, 0);
+    runPatch(1500, true, &peak);
+    check(highCounts() == 255, "inverted rests high", highCounts());
+    printf("patch: %d ms of gates, pin 11 followed the envelope, DAC bit 6 stayed masked\n", (int)patch_ms);
+}
+
+int main()
+{
+    ssbPwmDac pwm = ssbPwmDac();
+    testSetup(pwm);
+    testResolution(pwm);
+    testCost(pwm);
+    testEnd(pwm);
+    testPatch();
+    if (failures > 0)
+    {
+        printf("FAIL (%d)\n", failures);
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
@@ -0,0 +1,266 @@
+/*
+  randomTest.cpp - Quality and cost of ssbRandom against the Arduino
+    random() (the avr-libc generator, from the host HAL).
+
+    Checks:
+      - The sequence matches a plain 16 bit xorshift (7, 9, 8), so host and
+        AVR builds give the same numbers, and the period is 65535 with
+        every non 0 state seen once.
+      - next8 is uniform: chi-square over 256 bins, for several seeds.
+      - Pairs of next8 (high nibbles) are independent: chi-square over
+        16 x 16 bins.
+      - chance with percentToThreshold gives each percent (0 - 100) to
+        within the 1 / 256 step, as random(0, 100) < percent does.
+    Reports the host time of a roll for each, as a ratio only. For AVR
+    cycle counts load ssbLib/ssbRandom/examples/randomBench on an ArdCore.
+
+  Created by Peter Fawcett, Oct 18. 2026.
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#include <time.h>
+#include <vector>
+#include <Arduino.h>
+#include <ssbRandom.h>
+
+// Chi-square limits for p = 0.001 (a fair generator fails 1 in 1000).
+const double    CHI_255_LIMIT       = 330.5;    // 255 degrees of freedom.
+const int       SEEDS[]             = {1, 2, 0x1234, 0x8000, 0xFFFF, 12345, 999, 0x5555};
+const int       SEED_COUNT          = sizeof(SEEDS) / sizeof(SEEDS[0]);
+const int       PERIOD              = 65535;
+
+static int      failures            = 0;
+
+static void check(bool is_ok, const char* what)
+{
+    if (is_ok == false)
+    {
+        printf("FAIL: %s\n", what);
+        failures++;
+    }
+}
+
+static double chiSquare(const std::vector<int>& bins, int samples)
+{
+    double expect = (double)samples / bins.size();
+    double chi = 0;
+    for (size_t i = 0; i < bins.size(); i++)
+    {
+        double diff = bins[i] - expect;
+        chi += (diff * diff) / expect;
+    }
+    return chi;
+}
+
+static double nowNs()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec * 1e9 + now.tv_nsec;
+}
+
+/* testSequence
+ - Against a plain uint16_t xorshift, then round the whole period.
+*/
+static void testSequence()
+{
+    ssbRandom rand_gen = ssbRandom(1);
+    uint16_t state = 1;
+    bool is_same = true;
+    for (int i = 0; i < 1000; i++)
+    {
+        state ^= (uint16_t)(state << 7);
+        state ^= (uint16_t)(state >> 9);
+        state ^= (uint16_t)(state << 8);
+        if (rand_gen.next16() != state)
+        {
+            is_same = false;
+        }
+    }
+    check(is_same == true, "sequence is the 16 bit xorshift");
+
+    std::vector<bool> seen(65536, false);
+    int period = 0;
+    rand_gen.seed(1);
+    unsigned int first = rand_gen.next16();
+    unsigned int value = first;
+    do
+    {
+        if (value > 0xFFFF)
+        {
+            break;
+        }
+        seen[value] = true;
+        period++;
+        value = rand_gen.next16();
+    } while ((value != first) && (period < 70000));
+    int visited = 0;
+    for (int i = 1; i < 65536; i++)
+    {
+        if (seen[i] == true)
+        {
+            visited++;
+        }
+    }
+    printf("sequence: period %d, %d of 65535 states, 0 never\n", period, visited);
+    check(period == PERIOD, "period is 65535");
+    check((visited == PERIOD) && (seen[0] == false), "every non 0 state once");
+}
+
+/* testUniform
+ - next8 over 256 bins, 4096 numbers (16 a bin) from each seed. The
+   Arduino random(256) is run the same way for comparison.
+*/
+static void testUniform()
+{
+    const int samples = 4096;
+    double worst = 0;
+    double worst_libc = 0;
+    for (int s = 0; s < SEED_COUNT; s++)
+    {
+        ssbRandom rand_gen = ssbRandom(SEEDS[s]);
+        std::vector<int> bins(256, 0);
+        std::vector<int> libc_bins(256, 0);
+        randomSeed(SEEDS[s]);
+        for (int i = 0; i < samples; i++)
+        {
+            bins[rand_gen.next8()]++;
+            libc_bins[random(256)]++;
+        }
+        worst = max(worst, chiSquare(bins, samples));
+        worst_libc = max(worst_libc, chiSquare(libc_bins, samples));
+    }
+    printf("next8 uniform: worst chi-square %.1f (random() %.1f), limit %.1f\n", worst, worst_libc, CHI_255_LIMIT);
+    check(worst < CHI_255_LIMIT, "next8 is uniform");
+}
+
+/* testPairs
+ - High nibbles of two numbers in a row, 16 x 16 bins. A xorshift is
+   linear, so this is where a short one shows it.
+*/
+static void testPairs()
+{
+    const int samples = 8192;
+    double worst = 0;
+    double worst_libc = 0;
+    for (int s = 0; s < SEED_COUNT; s++)
+    {
+        ssbRandom rand_gen = ssbRandom(SEEDS[s]);
+        std::vector<int> bins(256, 0);
+        std::vector<int> libc_bins(256, 0);
+        randomSeed(SEEDS[s]);
+        for (int i = 0; i < samples; i++)
+        {
+            int a = rand_gen.next8() >> 4;
+            int b = rand_gen.next8() >> 4;
+            bins[(a << 4) | b]++;
+            a = random(16);
+            b = random(16);
+            libc_bins[(a << 4) | b]++;
+        }
+        worst = max(worst, chiSquare(bins, samples));
+        worst_libc = max(worst_libc, chiSquare(libc_bins, samples));
+    }
+    printf("next8 pairs:   worst chi-square %.1f (random() %.1f), limit %.1f\n", worst, worst_libc, CHI_255_LIMIT);
+    check(worst < CHI_255_LIMIT, "next8 pairs are independent");
+}
+
+/* testChance
+ - Each percent over a whole period: the rate is exactly the threshold in
+   256 (less the one 0 state), so the error is the rounding to 1 / 256.
+   random(0, 100) < percent is run as many times for comparison.
+*/
+static void testChance()
+{
+    double worst = 0;
+    double worst_libc = 0;
+    randomSeed(1);
+    for (int percent = 0; percent <= 100; percent++)
+    {
+        ssbRandom rand_gen = ssbRandom(1);
+        unsigned int threshold = ssbRandom::percentToThreshold(percent);
+        int hits = 0;
+        int libc_hits = 0;
+        for (int i = 0; i < PERIOD; i++)
+        {
+            if (rand_gen.chance(threshold) == true)
+            {
+                hits++;
+            }
+            if (random(0, 100) < percent)
+            {
+                libc_hits++;
+            }
+        }
+        worst = max(worst, fabs((100.0 * hits / PERIOD) - percent));
+        worst_libc = max(worst_libc, fabs((100.0 * libc_hits / PERIOD) - percent));
+        if (percent == 0)
+        {
+            check(hits == 0, "0% never");
+        }
+        if (percent == 100)
+        {
+            check(hits == PERIOD, "100% always");
+        }
+    }
+    printf("chance:        worst error %.3f%% of 100%% (random() %.3f%%), step %.3f%%\n",
+           worst, worst_libc, 100.0 / RAND_ALWAYS);
+    check(worst <= (50.0 / RAND_ALWAYS) + 0.01, "chance within half a step");
+}
+
+/* testCost
+ - Host time a roll. Only the ratio means anything, the AVR has no
+   divider and does the 32 bit random() math in software, so the gap is
+   wider there (see randomBench).
+*/
+static void testCost()
+{
+    const int rolls = 10000000;
+    volatile int sink = 0;
+    ssbRandom rand_gen = ssbRandom(1);
+    unsigned int threshold = ssbRandom::percentToThreshold(30);
+    double start = nowNs();
+    for (int i = 0; i < rolls; i++)
+    {
+        sink += rand_gen.chance(threshold);
+    }
+    double chance_ns = (nowNs() - start) / rolls;
+    start = nowNs();
+    for (int i = 0; i < rolls; i++)
+    {
+        sink += (random(0, 100) < 30);
+    }
+    double libc_ns = (nowNs() - start) / rolls;
+    printf("cost (host):   chance %.2fns, random(0, 100) %.2fns a roll (%.1fx)\n",
+           chance_ns, libc_ns, libc_ns / chance_ns);
+}
+
+int main()
+{
+    testSequence();
+    testUniform();
+    testPairs();
+    testChance();
+    testCost();
+    if (failures > 0)
+    {
+        printf("FAIL (%d)\n", failures);
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
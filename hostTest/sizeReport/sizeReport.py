@@ -0,0 +1,165 @@
+#!/usr/bin/env python3
+"""
+sizeReport.py - Flash and SRAM of each sketch at each debug level.
+
+    The sketches that use ssbDebugLevel.h are copied to a scratch folder
+    once per level, with the SSB_DEBUG_LEVEL line set to that level (or
+    added before the include when the sketch leaves it at the default),
+    built with arduino-cli and measured with avr-size. The sketches in the
+    tree are not touched.
+
+    Prints, per sketch, the flash (.text + .data) and static SRAM (.data +
+    .bss) at each level and what each level adds over SSB_LEVEL_OFF, which
+    is the saving of building the sketch with the level off.
+
+    Usage:
+        sizeReport.py                         every sketch, every level
+        sizeReport.py ssbSkipper ssbArdSeqOne --levels OFF,INFO
+        sizeReport.py --selftest
+
+    --fqbn is the board (default arduino:avr:uno, the ArdCore's ATmega328),
+    --cli and --size name the arduino-cli and avr-size to run. ssbLib is
+    passed to arduino-cli as the library folder.
+
+    Cycle costs are not measured here, see the levelBench example of
+    ssbDebugLevel (run on an ArdCore).
+
+  Created by Peter Fawcett, Oct 18. 2026.
+"""
+
+import io
+import os
+import re
+import sys
+import shutil
+import argparse
+import tempfile
+import subprocess
+
+LEVELS = ["OFF", "ERROR", "INFO", "VERBOSE"]
+LEVEL_DEFINE = re.compile(r"^#define\s+SSB_DEBUG_LEVEL\s+\S+.*$", re.M)
+LEVEL_INCLUDE = re.compile(r"^#include\s+<ssbDebugLevel\.h>.*$", re.M)
+ROOT = os.path.normpath(os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", ".."))
+
+
+def set_level(source, level):
+    """The sketch source with its debug level set to SSB_LEVEL_<level>."""
+    line = "#define SSB_DEBUG_LEVEL SSB_LEVEL_%s" % level
+    if LEVEL_DEFINE.search(source):
+        return LEVEL_DEFINE.sub(line, source, count=1)
+    match = LEVEL_INCLUDE.search(source)
+    if match is None:
+        return None
+    return source[:match.start()] + line + "\n" + source[match.start():]
+
+
+def parse_size(text):
+    """(flash, sram) from avr-size (Berkeley format) output."""
+    for line in text.splitlines():
+        fields = line.split()
+        if (len(fields) >= 3) and fields[0].isdigit():
+            text_size, data, bss = int(fields[0]), int(fields[1]), int(fields[2])
+            return text_size + data, data + bss
+    raise ValueError("no size line in avr-size output")
+
+
+def find_sketches():
+    sketches = []
+    for name in sorted(os.listdir(ROOT)):
+        path = os.path.join(ROOT, name, name + ".ino")
+        if os.path.isfile(path):
+            with open(path) as f:
+                if LEVEL_INCLUDE.search(f.read()):
+                    sketches.append(name)
+    return sketches
+
+
+def build(name, level, args, scratch):
+    """Build one sketch at one level, returns (flash, sram)."""
+    with open(os.path.join(ROOT, name, name + ".ino")) as f:
+        source = set_level(f.read(), level)
+    sketch_dir = os.path.join(scratch, level, name)
+    out_dir = os.path.join(scratch, level, "build-" + name)
+    shutil.copytree(os.path.join(ROOT, name), sketch_dir)
+    with open(os.path.join(sketch_dir, name + ".ino"), "w") as f:
+        f.write(source)
+    subprocess.check_output([args.cli, "compile", "--fqbn", args.fqbn,
+                             "--libraries", os.path.join(ROOT, "ssbLib"),
+                             "--output-dir", out_dir, sketch_dir],
+                            stderr=subprocess.STDOUT)
+    elf = os.path.join(out_dir, name + ".ino.elf")
+    return parse_size(subprocess.check_output([args.size, elf], universal_newlines=True))
+
+
+def report(name, sizes, levels, out):
+    """sizes: level -> (flash, sram)."""
+    out.write("%s\n" % name)
+    base = sizes.get("OFF")
+    for level in levels:
+        flash, sram = sizes[level]
+        out.write("  %-8s flash %6d  sram %5d" % (level, flash, sram))
+        if (base is not None) and (level != "OFF"):
+            out.write("   (+%d flash, +%d sram over OFF)" % (flash - base[0], sram - base[1]))
+        out.write("\n")
+
+
+def selftest():
+    """Level rewrite (set and default), avr-size parsing and the report.
+    No sizes are measured."""
+    sketch = ("// DEBUGGING\n#define SSB_DEBUG_LEVEL SSB_LEVEL_OFF  // off\n"
+              "#include <ssbDebugLevel.h>\n")
+    if set_level(sketch, "INFO") != sketch.replace("SSB_LEVEL_OFF  // off", "SSB_LEVEL_INFO"):
+        print("FAIL: set level")
+        return 1
+    default = "#include <ssbEnvelope.h>\n#include <ssbDebugLevel.h>\n"
+    want = "#include <ssbEnvelope.h>\n#define SSB_DEBUG_LEVEL SSB_LEVEL_VERBOSE\n#include <ssbDebugLevel.h>\n"
+    if set_level(default, "VERBOSE") != want:
+        print("FAIL: default level")
+        return 1
+    if set_level("#include <ssbDebug.h>\n", "INFO") is not None:
+        print("FAIL: sketch with no levels")
+        return 1
+    size = ("   text\t   data\t    bss\t    dec\t    hex\tfilename\n"
+            "   6142\t    212\t    431\t   6785\t   1a81\tssbSkipper.ino.elf\n")
+    if parse_size(size) != (6142 + 212, 212 + 431):
+        print("FAIL: avr-size")
+        return 1
+    out = io.StringIO()
+    report("sketch", {"OFF": (3000, 200), "INFO": (3400, 250)}, ["OFF", "INFO"], out)
+    if "(+400 flash, +50 sram over OFF)" not in out.getvalue():
+        print("FAIL: report")
+        return 1
+    print("sizeReport selftest: PASS")
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Flash and SRAM of each sketch at each debug level.")
+    parser.add_argument("sketches", nargs="*", help="sketch folders (default: all using ssbDebugLevel)")
+    parser.add_argument("--levels", default=",".join(LEVELS))
+    parser.add_argument("--fqbn", default="arduino:avr:uno")
+    parser.add_argument("--cli", default="arduino-cli")
+    parser.add_argument("--size", default="avr-size")
+    parser.add_argument("--selftest", action="store_true")
+    args = parser.parse_args()
+    if args.selftest:
+        return selftest()
+    levels = [l.strip().upper() for l in args.levels.split(",")]
+    for level in levels:
+        if level not in LEVELS:
+            parser.error("unknown level %s" % level)
+    sketches = args.sketches or find_sketches()
+    scratch = tempfile.mkdtemp(prefix="sizeReport")
+    try:
+        for name in sketches:
+            sizes = {}
+            for level in levels:
+                sizes[level] = build(os.path.basename(os.path.normpath(name)), level, args, scratch)
+            report(name, sizes, levels, sys.stdout)
+    finally:
+        shutil.rmtree(scratch)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,137 @@
+#!/usr/bin/env python3
+"""
+sramMap.py - Build time SRAM map of a sketch, from the symbols in its .elf.
+
+    sizeof() in a sketch can not tell a table in flash (PROGMEM) from one
+    in SRAM, so the map is taken from the linker output instead. avr-nm
+    lists each symbol with its address and size. On the AVR the data space
+    is linked at 0x800000 and up, so a symbol there of type d/D (.data,
+    initialised, also takes its start values from flash) or b/B (.bss,
+    zeroed) is in SRAM. Everything else (code, PROGMEM tables) is flash.
+
+    Prints the SRAM objects, largest first, and the .data/.bss totals
+    against the 2048 bytes of the ATmega328. What is left is shared by the
+    heap and the stack (see ssbDebug getMinFreeMem for how close they come
+    at run time).
+
+    Usage:
+        arduino-cli compile -b arduino:avr:uno --output-dir build ssbArdSeqOne
+        sramMap.py build/ssbArdSeqOne.ino.elf
+        sramMap.py build/ssbArdSeqOne.ino.elf --budget 1536 --top 10
+        sramMap.py --selftest
+
+    --budget exits 1 when .data + .bss is over it, for a build script.
+    --nm names the nm to run (default avr-nm, from the Arduino AVR core).
+
+  Created by Peter Fawcett, Oct 18. 2026.
+"""
+
+import sys
+import argparse
+import subprocess
+
+SRAM_SIZE = 2048
+DATA_SPACE = 0x800000
+
+
+def parse_nm(text):
+    """(section, size, name) for each SRAM symbol in avr-nm -S output."""
+    objects = []
+    for line in text.splitlines():
+        fields = line.split(None, 3)
+        if len(fields) < 4:
+            continue                                    # no size: a label
+        try:
+            address = int(fields[0], 16)
+            size = int(fields[1], 16)
+        except ValueError:
+            continue
+        kind = fields[2]
+        if (address < DATA_SPACE) or (kind not in "dDbB"):
+            continue
+        if kind in "dD":
+            section = ".data"
+        else:
+            section = ".bss"
+        objects.append((section, size, fields[3]))
+    objects.sort(key=lambda o: (-o[1], o[2]))
+    return objects
+
+
+def totals(objects):
+    data = sum(o[1] for o in objects if o[0] == ".data")
+    bss = sum(o[1] for o in objects if o[0] == ".bss")
+    return data, bss
+
+
+def report(objects, top, out):
+    data, bss = totals(objects)
+    shown = objects
+    if top:
+        shown = objects[:top]
+    out.write("SRAM objects (bytes):\n")
+    for section, size, name in shown:
+        out.write("  %5d  %-5s  %s\n" % (size, section, name))
+    if len(shown) < len(objects):
+        rest = sum(o[1] for o in objects[len(shown):])
+        out.write("  %5d         (%d more)\n" % (rest, len(objects) - len(shown)))
+    out.write(".data: %d  .bss: %d  total: %d of %d, %d left for heap and stack\n"
+              % (data, bss, data + bss, SRAM_SIZE, SRAM_SIZE - data - bss))
+    return data + bss
+
+
+def selftest():
+    """Canned avr-nm -S --size-sort output: flash tables and code are not
+    counted, static (lower case) objects are."""
+    text = "\n".join([
+        "         U __heap_start",
+        "00000068 00000010 T SONGPAT",                  # PROGMEM table
+        "000000f4 00000020 t _ZL5CURVE",                # static PROGMEM table
+        "000003a2 0000001c T loop",
+        "00800100 00000002 D pinOffset",
+        "00800102 00000006 d _ZL8DIG_PINS",
+        "00800108 00000001 b _ZL11clock_state",
+        "00800109 00000040 B QNOTES",
+        "00800149 00000012 B GATES",
+        "0080015b 00000009 B Serial",
+        "0080015b B __bss_end",                         # no size
+    ])
+    objects = parse_nm(text)
+    want = [(".bss", 0x40, "QNOTES"), (".bss", 0x12, "GATES"), (".bss", 9, "Serial"),
+            (".data", 6, "_ZL8DIG_PINS"), (".data", 2, "pinOffset"),
+            (".bss", 1, "_ZL11clock_state")]
+    if objects != want:
+        print("FAIL: objects")
+        print("  got     ", objects)
+        print("  expected", want)
+        return 1
+    if totals(objects) != (8, 0x40 + 0x12 + 9 + 1):
+        print("FAIL: totals", totals(objects))
+        return 1
+    print("sramMap selftest: %d SRAM objects, %d bytes, PASS" % (len(objects), sum(totals(objects))))
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="SRAM map of a sketch .elf.")
+    parser.add_argument("elf", nargs="?", help="sketch .elf from the build")
+    parser.add_argument("--nm", default="avr-nm")
+    parser.add_argument("--budget", type=int, help="exit 1 if .data + .bss is over this")
+    parser.add_argument("--top", type=int, default=0, help="only list the largest N")
+    parser.add_argument("--selftest", action="store_true")
+    args = parser.parse_args()
+    if args.selftest:
+        return selftest()
+    if not args.elf:
+        parser.error("a sketch .elf is needed")
+    text = subprocess.check_output([args.nm, "-S", "--size-sort", "-C", args.elf],
+                                   universal_newlines=True)
+    used = report(parse_nm(text), args.top, sys.stdout)
+    if (args.budget is not None) and (used > args.budget):
+        print("FAIL: %d bytes is over the budget of %d" % (used, args.budget))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
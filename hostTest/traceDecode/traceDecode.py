@@ -0,0 +1,259 @@
+#!/usr/bin/env python3
+"""
+traceDecode.py - Decodes ssbDebug trace events (see ssbDebug.h).
+
+    Events come over serial as 6 byte frames (little endian):
+        TRACE_SYNC (0xA5), id, time lo, time hi, value lo, value hi
+    The time is the Timer0 count used by micros(), 4us a step. It wraps
+    every 262ms, so it is unwrapped here (events are in order, a smaller
+    stamp is a wrap). A gap of more than one wrap with no events can not be
+    seen, trace something at least every 262ms if the gaps matter.
+    Bytes that do not start a frame (text printed by the sketch, a frame
+    cut by a reset) are skipped till the next 0xA5.
+
+    Prints a timeline (time from the first event, time from the event
+    before) and, per id, the count, the value range and the spacing.
+
+    Usage:
+        traceDecode.py capture.bin
+        traceDecode.py /dev/ttyUSB0 --baud 9600 --names 1=clock,2=gate0
+        traceDecode.py --selftest
+
+    A serial port is read till Ctrl-C (or --seconds), the stats are printed
+    at the end. --quiet prints only the stats.
+
+  Created by Peter Fawcett, Oct 18. 2026.
+"""
+
+import os
+import sys
+import stat
+import time
+import argparse
+
+TRACE_SYNC = 0xA5
+FRAME_LEN = 6
+US_PER_STEP = 4
+
+
+def s16(lo, hi):
+    value = lo | (hi << 8)
+    if value >= 0x8000:
+        value -= 0x10000
+    return value
+
+
+class Decoder:
+    """Turns a byte stream into (time_us, id, value) events."""
+
+    def __init__(self):
+        self.pending = bytearray()
+        self.last_raw = None
+        self.steps = 0
+        self.skipped = 0
+
+    def feed(self, data, final=False):
+        """A frame is taken when the next byte starts a frame too, so a 0xA5
+        in text is not taken as one. The last frame (or one followed only by
+        text) is taken at the end of the data (final)."""
+        self.pending += data
+        events = []
+        while True:
+            while self.pending and self.pending[0] != TRACE_SYNC:
+                self.pending.pop(0)
+                self.skipped += 1
+            if len(self.pending) < FRAME_LEN:
+                break
+            if len(self.pending) > FRAME_LEN and self.pending[FRAME_LEN] != TRACE_SYNC:
+                if TRACE_SYNC in self.pending[FRAME_LEN:]:
+                    # Not a frame, frames follow: resync.
+                    self.pending.pop(0)
+                    self.skipped += 1
+                    continue
+                if not final:
+                    break
+            elif len(self.pending) == FRAME_LEN and not final:
+                break
+            frame = self.pending[:FRAME_LEN]
+            del self.pending[:FRAME_LEN]
+            raw = frame[2] | (frame[3] << 8)
+            if self.last_raw is not None:
+                self.steps += (raw - self.last_raw) & 0xFFFF
+            self.last_raw = raw
+            events.append((self.steps * US_PER_STEP, frame[1], s16(frame[4], frame[5])))
+        if final:
+            self.skipped += len(self.pending)
+            del self.pending[:]
+        return events
+
+
+class Stats:
+    """Count, value range and spacing (us) for each id."""
+
+    def __init__(self):
+        self.ids = {}
+
+    def add(self, time_us, event_id, value):
+        entry = self.ids.get(event_id)
+        if entry is None:
+            entry = {"count": 0, "low": value, "high": value, "last": None, "gaps": []}
+            self.ids[event_id] = entry
+        entry["count"] += 1
+        entry["low"] = min(entry["low"], value)
+        entry["high"] = max(entry["high"], value)
+        if entry["last"] is not None:
+            entry["gaps"].append(time_us - entry["last"])
+        entry["last"] = time_us
+
+    def report(self, names, out):
+        out.write("%-12s %8s %8s %8s %10s %10s %10s\n" %
+                  ("id", "count", "min val", "max val", "min us", "mean us", "max us"))
+        for event_id in sorted(self.ids):
+            entry = self.ids[event_id]
+            gaps = entry["gaps"]
+            if gaps:
+                spacing = (min(gaps), sum(gaps) // len(gaps), max(gaps))
+            else:
+                spacing = ("-", "-", "-")
+            out.write("%-12s %8d %8d %8d %10s %10s %10s\n" %
+                      ((names.get(event_id, str(event_id)), entry["count"], entry["low"], entry["high"]) + spacing))
+
+
+def parse_names(text):
+    names = {}
+    if text:
+        for pair in text.split(","):
+            event_id, name = pair.split("=", 1)
+            names[int(event_id, 0)] = name
+    return names
+
+
+def open_serial(path, baud):
+    """Raw, blocking reads with a short time out. No pyserial needed."""
+    import termios
+    rates = {9600: termios.B9600, 19200: termios.B19200, 38400: termios.B38400,
+             57600: termios.B57600, 115200: termios.B115200}
+    fd = os.open(path, os.O_RDONLY | os.O_NOCTTY)
+    attrs = termios.tcgetattr(fd)
+    attrs[0] = 0                                        # iflag
+    attrs[1] = 0                                        # oflag
+    attrs[2] = termios.CS8 | termios.CREAD | termios.CLOCAL
+    attrs[3] = 0                                        # lflag
+    attrs[4] = rates[baud]
+    attrs[5] = rates[baud]
+    attrs[6][termios.VMIN] = 0
+    attrs[6][termios.VTIME] = 1
+    termios.tcsetattr(fd, termios.TCSANOW, attrs)
+    return fd
+
+
+def decode(chunks, names, quiet, out):
+    decoder = Decoder()
+    stats = Stats()
+    last_us = None
+    for chunk in chunks + [None]:
+        if chunk is None:
+            events = decoder.feed(b"", True)
+        else:
+            events = decoder.feed(chunk)
+        for time_us, event_id, value in events:
+            stats.add(time_us, event_id, value)
+            if not quiet:
+                delta = 0
+                if last_us is not None:
+                    delta = time_us - last_us
+                out.write("%12.3f ms  +%8d us  %-10s %6d  0x%04X\n" %
+                          (time_us / 1000.0, delta, names.get(event_id, str(event_id)), value, value & 0xFFFF))
+            last_us = time_us
+    out.write("\n")
+    stats.report(names, out)
+    if decoder.skipped:
+        out.write("skipped %d bytes out of frame\n" % decoder.skipped)
+    return decoder, stats
+
+
+def read_file(path):
+    with open(path, "rb") as f:
+        return [f.read()]
+
+
+def read_serial(path, baud, seconds):
+    """Read till Ctrl-C or the time is up. Returned as one chunk."""
+    fd = open_serial(path, baud)
+    data = b""
+    end = None
+    if seconds:
+        end = time.time() + seconds
+    try:
+        while end is None or time.time() < end:
+            data += os.read(fd, 256)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        os.close(fd)
+    return [data]
+
+
+def frame(event_id, raw, value):
+    return bytes([TRACE_SYNC, event_id, raw & 0xFF, (raw >> 8) & 0xFF, value & 0xFF, (value >> 8) & 0xFF])
+
+
+def selftest():
+    """Stamps that wrap (twice), junk between frames and negative values."""
+    stream = b"Free Mem: 812\r\n"
+    expect = []
+    steps = 0
+    raw = 0xFF00
+    for i in range(40):
+        gap = 7000 + i * 500                            # 28ms and up, so it wraps
+        steps += gap
+        raw = (raw + gap) & 0xFFFF
+        stream += frame(1 + (i % 3), raw, -i * 100)
+        expect.append((steps, 1 + (i % 3), -i * 100))
+        if i == 20:
+            stream += b"\xA5junk\r\n"                  # a sync with no frame
+    decoder = Decoder()
+    events = []
+    for at in range(0, len(stream), 5):                 # split across reads
+        events += decoder.feed(stream[at:at + 5])
+    events += decoder.feed(b"", True)
+    first = expect[0][0]
+    want = [((s - first) * US_PER_STEP, i, v) for s, i, v in expect]
+    if events != want:
+        print("FAIL: decoded events")
+        for got, exp in zip(events, want):
+            if got != exp:
+                print("  got", got, "expected", exp)
+                break
+        return 1
+    if decoder.skipped != len(b"Free Mem: 812\r\n") + len(b"\xA5junk\r\n"):
+        print("FAIL: skipped", decoder.skipped)
+        return 1
+    print("traceDecode selftest: %d events, last at %.1f ms, PASS" % (len(events), events[-1][0] / 1000.0))
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode ssbDebug trace events.")
+    parser.add_argument("source", nargs="?", help="capture file or serial port")
+    parser.add_argument("--baud", type=int, default=9600)
+    parser.add_argument("--names", help="id names: 1=clock,2=gate0")
+    parser.add_argument("--seconds", type=float, help="serial: stop after this long")
+    parser.add_argument("--quiet", action="store_true", help="stats only")
+    parser.add_argument("--selftest", action="store_true")
+    args = parser.parse_args()
+    if args.selftest:
+        return selftest()
+    if not args.source:
+        parser.error("a capture file or serial port is needed")
+    names = parse_names(args.names)
+    if stat.S_ISCHR(os.stat(args.source).st_mode):
+        chunks = read_serial(args.source, args.baud, args.seconds)
+    else:
+        chunks = read_file(args.source)
+    decode(chunks, names, args.quiet, sys.stdout)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
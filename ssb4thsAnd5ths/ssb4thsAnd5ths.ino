@@ -5,6 +5,8 @@ Description:
     The shift may be either up or down. Note that due to the 0-5 volt limitation of the Ardcore.
     This gives us a range of C3 - C7. The patch can not shift above C7 or below C3. One can use 
     a the Beasts Chalkboard to shift the result down one or two octives (negative volts).
+    With DIATONIC set to true (below), the shift is a 4th or 5th in the key and scale
+    set below (KEY and SCALE), so the output stays in key.
 
     I/O Usage:
         Knob A0:         Shift Up or down (LOW is down, HIGH is up).
@@ -29,6 +31,10 @@ Description:
         Version 1 - Original patch developement.
         Version 2 - Jan 24. 2015
                     Update to use ssbArdBase lib. Code tightened up.
+        Version 3 - Oct 18 2026
+                    Quantize and shift moved to ssbHarmonizer. Shifts past
+                    C3 / C8 now move back an octave (was out of range).
+                    Added the diatonic (in key) shift, see DIATONIC below.
 
     ============================================================
 
@@ -48,18 +54,25 @@ Description:
 
 #include "ssbArdBase.h"
 #include "ssbScales.h"
+#include "ssbHarmonizer.h"
+
+// EDIT THESE VALUES TO SHIFT IN KEY!!!!
+// DIATONIC false shifts by semitones, true shifts by scale degrees in KEY
+// (C_NOTE - B_NOTE) and SCALE (MAJOR_SCALE_MASK, MINOR_SCALE_MASK,
+// PENTA_MAJOR_SCALE_MASK or PENTA_MINOR_SCALE_MASK).
+const   bool    DIATONIC        = false;
+const   byte    KEY             = C_NOTE;
+const   unsigned int SCALE      = MAJOR_SCALE_MASK;
 
 const   bool    SHIFT_UP        = HIGH;
 const   bool    SHIFT_DOWN      = LOW;
 const   bool    SHIFT_FOURTH    = LOW;
 const   bool    SHIFT_FIFTH     = HIGH;
-const   int     FOURTH          = 5;
-const   int     FIFTH           = 7;
 
 boolean         upDown          = SHIFT_DOWN;
 boolean         noteShift       = SHIFT_FOURTH;
-int             noteVolt        = 0;
 long            outVolt         = 0;
+ssbHarmonizer   HARMONIZER      = ssbHarmonizer();
 
 //  ==================== setup() START ======================
 //
@@ -80,6 +93,12 @@ void setup()
         pinMode(PIN_OFFSET + i, OUTPUT);
         digitalWrite(PIN_OFFSET + i, LOW);
     }
+    if (DIATONIC)
+    {
+        HARMONIZER.setMode(HARM_DIATONIC);
+        HARMONIZER.setKey(KEY);
+        HARMONIZER.setScale(SCALE);
+    }
 }
 //  ==================== setup() END =======================
 
@@ -93,61 +112,31 @@ void loop()
 {
     upDown = getCtlHighLow(A0_INPUT);
     noteShift = getCtlHighLow(A1_INPUT);
-    int tmpVolt = analogRead(A2_INPUT);
-    if (tmpVolt != noteVolt)
-    {
-        noteVolt = tmpVolt;
-        outVolt = doShift(noteVolt, upDown, noteShift);
-    }
+    HARMONIZER.setShift(getShift(upDown, noteShift));
+    outVolt = HARMONIZER.process(analogRead(A2_INPUT));
     dacOutput(outVolt);
 }
 
 //  =================== convenience routines ===================
 
-int doShift(int noteIn, boolean shiftDir, boolean shiftType)
-{
-    int noteOut = 0;
-    int noteIndex = 0;
-    int shiftAmt = getShift(shiftType);
-    //quantize
-    noteIndex = noteIntex(noteIn);
-    // shift by index
-    noteIndex = shiftIndex(noteIndex, shiftAmt, shiftDir);
-    return QNOTES[noteIndex];
-}
-
-int noteIntex(int noteIn)
+int getShift(boolean shiftDir, boolean shiftType)
 {
-    int index = 0;
-    for (int i = 0; i < NOTE_COUNT; i++)
+    int shift = HARM_FIFTH;
+    if (DIATONIC)
     {
-        if (noteIn >= QNOTES[i])
+        shift = HARM_FIFTH_DEGREES;
+        if (shiftType == SHIFT_FOURTH)
         {
-           index = i;
-            if ((i + 1 < NOTE_COUNT) && (noteIn < QNOTES[i+1]))
-            {
-               break;
-            }
+            shift = HARM_FOURTH_DEGREES;
         }
     }
-    return index;
-}
-
-int shiftIndex(int index, int amt, boolean dir)
-{
-    if (dir == SHIFT_DOWN)
+    else if (shiftType == SHIFT_FOURTH)
     {
-        return (index - amt);
+        shift = HARM_FOURTH;
     }
-    return (index + amt);
-}
-
-int getShift(boolean type)
-{
-    if (type == SHIFT_FOURTH)
+    if (shiftDir == SHIFT_DOWN)
     {
-        return FOURTH;
+        return -shift;
     }
-    return FIFTH;
+    return shift;
 }
-
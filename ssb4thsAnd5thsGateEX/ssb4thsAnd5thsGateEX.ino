@@ -5,6 +5,9 @@ Description:
     The shift may be either up or down. Note that due to the 0-5 volt limitation of the Ardcore.
     This gives us a range of C3 - C7. The patch can not shift above C7 or below C3. One can use 
     a the Beasts Chalkboard to shift the result down one or two octives (negative volts).
+    With DIATONIC set to true (below), the shift is a 4th or 5th in the key and scale
+    set below (KEY and SCALE), so the output stays in key. With CHORD_CYCLE set to true,
+    each clock moves the output to the next tone of CHORD (an arpeggio of the shifted note).
 
     I/O Usage:
         Knob A0:         Shift Up or down (LOW is down, HIGH is up).
@@ -22,10 +25,18 @@ Description:
         Bits 0-7:        Each bit may be set separately. See m4l device ssbArdBits.
         Analog Out 11:   Unused
         Digital Out 13:  Unused
-    Serial:              Unused
+    Serial:              Unused (debug)
 
     Created:  Jan 11 2014 by Peter Fawcett (SoundSweepsBy).
         Version 1 - Original patch developement.
+        Version 2 - Oct 18 2026:
+          Debugging uses compile time levels (ssbDebugLevel) and is off by
+          default.
+          Added glide between notes (ssbSlew, GLIDE_MS below).
+          Quantize and shift moved to ssbHarmonizer. Shifts past C3 / C8
+          now move back an octave (was out of range).
+          Added the diatonic (in key) shift and chord tone cycling, see
+          DIATONIC and CHORD_CYCLE below.
 
     ============================================================
 
@@ -43,6 +54,15 @@ Description:
     visit http://creativecommons.org/licenses/
 */
 
+// DEBUGGING
+// Set to SSB_LEVEL_ERROR, SSB_LEVEL_INFO or SSB_LEVEL_VERBOSE to enable debug
+// output. Debug calls above the level are not compiled in.
+#define SSB_DEBUG_LEVEL SSB_LEVEL_OFF
+#include <ssbDebugLevel.h>
+#include <ssbSlew.h>
+#include <ssbScales.h>
+#include <ssbHarmonizer.h>
+
 // Logic Constants:
 const int     MAX_VAL      = 1023;
 const boolean FALSE        = LOW;
@@ -51,10 +71,29 @@ const boolean SHIFT_UP     = HIGH;
 const boolean SHIFT_DOWN   = LOW;
 const boolean SHIFT_FOURTH = LOW;
 const boolean SHIFT_FIFTH  = HIGH;
-const int     FOURTH       = 5;
-const int     FIFTH        = 7;
 const int     WIDTH_SHIFT  = 512;
 
+// EDIT THESE VALUES TO SHIFT IN KEY!!!!
+// DIATONIC false shifts by semitones, true shifts by scale degrees in KEY
+// (C_NOTE - B_NOTE) and SCALE (MAJOR_SCALE_MASK, MINOR_SCALE_MASK,
+// PENTA_MAJOR_SCALE_MASK or PENTA_MINOR_SCALE_MASK).
+const boolean DIATONIC     = false;
+const byte    KEY          = C_NOTE;
+const unsigned int SCALE   = MAJOR_SCALE_MASK;
+
+// EDIT THESE VALUES TO CYCLE CHORD TONES!!!!
+// With CHORD_CYCLE true each clock adds the next CHORD value to the shift.
+// Semitones, or scale degrees when DIATONIC ({0, 2, 4} is a triad).
+const boolean CHORD_CYCLE  = false;
+const byte    CHORD_LEN    = 3;
+const char    CHORD[CHORD_LEN] = {0, 4, 7};
+
+// EDIT THESE VALUES TO CHANGE THE GLIDE (PORTAMENTO)!!!!
+// GLIDE_MS is the glide time in ms (0 is no glide). With GLIDE_CONSTANT_TIME
+// true every note takes GLIDE_MS, false it is the time for a 5 octave move.
+const unsigned int GLIDE_MS        = 0;
+const boolean GLIDE_CONSTANT_TIME  = true;
+
 // IO, Clock and Arduino Constants
 const int     SHIFT_KNOB   = 0;
 const int     AMT_KNOB     = 1;
@@ -67,20 +106,12 @@ const int     MAX_GATE     = 2;
 const int     DIG_PINS[2]  = {3,4};
 const int     PIN_OFFSET   = 5;           // DAC  -> the first DAC pin (from 5-12)
 
-//  constant for actual 0-5V quantization (vs. >> 4)
-const int     QARRAY[61]   = {
-  0,   9,   26,  43,  60,  77,  94,  111, 128, 145, 162, 180, 
-  197, 214, 231, 248, 265, 282, 299, 316, 333, 350, 367, 384, 
-  401, 418, 435, 452, 469, 486, 503, 521, 538, 555, 572, 589, 
-  606, 623, 640, 657, 674, 691, 708, 725, 742, 759, 776, 793, 
-  810, 827, 844, 862, 879, 896, 913, 930, 947, 964, 981, 998, 
-  1015};
-
 // Init values for application data
 boolean       upDown       = SHIFT_DOWN;
 boolean       noteShift    = SHIFT_FOURTH;
-int           noteVolt     = 0;
 long          outVolt      = 0;
+ssbHarmonizer HARMONIZER   = ssbHarmonizer();
+ssbSlew       GLIDE        = ssbSlew(GLIDE_MS);
 
 //  variables for interrupt handling of the clock input
 volatile int  clkState     = LOW;
@@ -92,12 +123,8 @@ int           digState[2]  = {LOW, LOW};  // start with both set low
 unsigned long prevMilli[2] = {0, 0};      // the last time of a loop
 unsigned long lastTick = 0;               // the time of the last clock pulse
 int           triggerTime = 10;           // start at 10ms, but will be set by first/each clock pulse.
-/* Debugging
-   Comment out (move close) to disable debugging.
- */
-boolean       debug        = TRUE;
-int           tick         = 0;
-int           tickOutCount = 1000;
+// Debugging. Output every second.
+SSB_DEBUG(ssbDebug      DEBUG        = ssbDebug(1000);)
 
 //  ==================== setup() START ======================
 //
@@ -106,13 +133,9 @@ int           tickOutCount = 1000;
 //
 void setup()
 {
-    /* Debugging
-    Comment out (move close) to disable debugging.
-    */
-    if (debug == TRUE)
-    {
-        Serial.begin(9600);
-    }
+    // Debugging
+    SSB_DEBUG(DEBUG.enableSerial());
+    SSB_DEBUG(DEBUG.debugState(true));
 
     // set up the digital (clock) input
     pinMode(CLOCK_IN, INPUT);
@@ -133,6 +156,18 @@ void setup()
 
     // Interrupt for clock input.
     attachInterrupt(0, isr, RISING);
+
+    GLIDE.setConstantTime(GLIDE_CONSTANT_TIME);
+    if (DIATONIC)
+    {
+        HARMONIZER.setMode(HARM_DIATONIC);
+        HARMONIZER.setKey(KEY);
+        HARMONIZER.setScale(SCALE);
+    }
+    if (CHORD_CYCLE)
+    {
+        HARMONIZER.setChord(CHORD, CHORD_LEN);
+    }
 }
 //  ==================== setup() END =======================
 
@@ -161,30 +196,22 @@ void loop()
         }
         lastTick = millis();
         handleTicks(gateFreq);
+        HARMONIZER.nextChordTone();
     }
 
     // Handle Trigger Turnoff
     handleTrigOff(gateFreq, triggerTime);
     
-    if (tmpVolt != noteVolt)
-    {
-        noteVolt = tmpVolt;
-        outVolt = doShift(noteVolt, upDown, noteShift);
-    }
-
-    /* Debugging
-    Comment out (move close) to disable debugging.
-    */
-    if (tick > tickOutCount)
-    {
-        Serial.print("Gate Width 0: ");
-        Serial.println(gateWidth[0]);
-        Serial.print("Gate Width 1: ");
-        Serial.println(gateWidth[1]);
-        tick = 0;
-    }
-    tick += 1;
-    dacOutput((outVolt >> 2));
+    HARMONIZER.setShift(getShift(upDown, noteShift));
+    outVolt = HARMONIZER.process(tmpVolt);
+
+    // Debugging
+    SSB_DEBUG_INFO(DEBUG.debugValue("Gate Width 0: ", gateWidth[0]));
+    SSB_DEBUG_INFO(DEBUG.debugValue("Gate Width 1: ", gateWidth[1]));
+    SSB_DEBUG(DEBUG.updateTicks());
+    // Glide to the note.
+    GLIDE.setTarget(outVolt);
+    dacOutput((GLIDE.update() >> 2));
 }
 
 //  =================== convenience routines ===================
@@ -208,47 +235,26 @@ boolean HiLowState(int input)
     return HIGH;
 }
 
-int getShift(boolean type)
+int getShift(boolean shiftDir, boolean shiftType)
 {
-    if (type == SHIFT_FOURTH)
+    int shift = HARM_FIFTH;
+    if (DIATONIC)
     {
-        return FOURTH;
+        shift = HARM_FIFTH_DEGREES;
+        if (shiftType == SHIFT_FOURTH)
+        {
+            shift = HARM_FOURTH_DEGREES;
+        }
     }
-    return FIFTH;
-}
-
-int shiftIndex(int index, int amt, boolean dir)
-{
-    if (dir == SHIFT_DOWN)
+    else if (shiftType == SHIFT_FOURTH)
     {
-        return (index - amt);
+        shift = HARM_FOURTH;
     }
-    return (index + amt);
-}
-
-int noteIntex(int noteIn)
-{
-    int index = 0;
-    for (int i = 0; i < 61; i++)
+    if (shiftDir == SHIFT_DOWN)
     {
-        if (noteIn >= QARRAY[i])
-        {
-           index = i;
-        }
+        return -shift;
     }
-    return index;
-}
-
-int doShift(int noteIn, boolean shiftDir, boolean shiftType)
-{
-    int noteOut = 0;
-    int noteIndex = 0;
-    int shiftAmt = getShift(shiftType);
-    //quantize
-    noteIndex = noteIntex(noteIn);
-    // shift by index
-    noteIndex = shiftIndex(noteIndex, shiftAmt, shiftDir);
-    return QARRAY[noteIndex];
+    return shift;
 }
 
 // Handle Clock
@@ -2,18 +2,35 @@
  * ============================================================================
  *
  * This sequencer uses set patterns of note shifts. These sequences are hard 
- * coded and are selected on sketch load/reload. There may be up to 8 sequences 
- * (A0 is 1-4 / 5-8 and A1 is Hi / Lo). The sequences are all 16 notes. 
+ * coded (in flash, one byte per step) and are selected on sketch load/reload.
+ * There may be up to 16 sequences (A0 is 1-8 / 9-16 and A1 is Hi / Lo). A
+ * sequence may be 1 - 64 steps (PATTERN_LEN below) and is played in the
+ * DIRECTION below (forward, reverse, pendulum or random).
  *
  * Note values may be one of the following:
- *    0  : Play the root note.
- *    #  : Play 1 to 12 notes above the root note (if the specified note is
- *         higher than the allowed voltage, it will be dropped an octave.
- *    -# : Play 1 to 12 notes below the root note (if the specified note is
- *         lower than the allowed voltage, it will be raised an octave.
- *    512; A magic number to represent a rest.
+ *    SEQ_NOTE(0)  : Play the root note.
+ *    SEQ_NOTE(#)  : Play 1 to 31 notes above the root note (if the specified
+ *                   note is higher than the allowed voltage, it will be
+ *                   dropped an octave.
+ *    SEQ_NOTE(-#) : Play 1 to 31 notes below the root note (if the specified
+ *                   note is lower than the allowed voltage, it will be
+ *                   raised an octave.
+ *    SEQ_REST     : A rest.
+ *    A note may also be marked (SEQ_NOTE(#) | SEQ_TIE etc.):
+ *    SEQ_TIE      : The step before plays legato (no pad gap, see below).
+ *    SEQ_ACCENT   : With D1_ACCENT_ONLY set, D1 only gates on accents.
  *    So a sequence could be something like:
- *    {0, 7, 7, 512, -4, 512, 5...}
+ *    {SEQ_NOTE(0) | SEQ_ACCENT, SEQ_NOTE(7), SEQ_NOTE(7) | SEQ_TIE, SEQ_REST...}
+ *
+ * Each step also has lanes (LANES below, 0 is the default for each):
+ *    SEQ_PROB_100 / 75 / 50 / 25      : Chance the step plays (else a rest).
+ *    SEQ_RATCHET_1 / 2 / 3 / 4        : Gates in the step (on top of the
+ *                                       expander stutter).
+ *    SEQ_GATE_FULL / 3_4 / 1_2 / 1_4  : Gate length.
+ *    SEQ_OCT_0 / UP / DOWN / DOWN_2   : Octave shift of the note.
+ *    So a lane could be SEQ_PROB_50 | SEQ_RATCHET_2 | SEQ_OCT_UP.
+ * The lanes are rolled and all the gate timing is worked out when the step
+ * starts, the loop only checks the time of the next gate edge.
  *
  * The Gates (D0 and D1) are set to divisions of the note clock trigger pulse. 
  * This means that the first time through, the sequencer can only guess at the 
@@ -54,6 +71,17 @@
  * As both gates can be timed and expanded / stepped differently, this allows
  * one to have normal note lengths for the vca envelope, but stepped for the
  * vcf envelope (for example).
+ *
+ * Pattern banks: 8 more patterns (up to 16 steps) may be kept in EEPROM and
+ * changed over serial (ssbArdM4L, 9600 baud) with out a reflash. Writes are
+ * spread over 6 copies of each bank and checksummed (ssbPatternBank).
+ *    [1,bank,len,s1,...,sLen] : Write a bank. Steps are step bytes as in
+ *                               ssbSequencer.h (offset & 63, rest is 32,
+ *                               +64 for a tie, +128 for an accent).
+ *                               Replies [1,bank,ok,write ms] when written.
+ *    [2,bank]                 : Play a bank. Replies [2,bank,ok,load us].
+ * The bank is copied to SRAM when selected, so the clock never waits on the
+ * EEPROM. The flash pattern (knobs at load) plays till a bank is selected.
  * 
  * ============================================================================
  *
@@ -71,8 +99,23 @@
  *    Knob A5/Jack A5: Gate D0 Stutter/Adder
  *  Output Expander:
  *    Bits 0-7:        Not Used
+ *  Serial Input:        Pattern bank write / select (see above).
  *
  *  Created:  Nov 22 2014 by Peter Fawcett (SoundSweepsBy)
+ *            Oct 18 2026  - Debugging uses compile time levels (ssbDebugLevel).
+ *            Oct 18 2026  - Added glide between notes (ssbSlew, GLIDE_MS below).
+ *                         - Fixed the DAC output (10 bit note value written to
+ *                           the 8 bit DAC with out the >> 2).
+ *            Oct 18 2026  - Patterns moved to flash (ssbSequencer), one byte per
+ *                           step, with rest, tie and accent flags.
+ *                         - 16 patterns, any length, DIRECTION below.
+ *                         - Fixed pattern select (A1 only added 0 or 1).
+ *            Oct 18 2026  - EEPROM pattern banks, written and selected over
+ *                           serial (ssbPatternBank).
+ *            Oct 18 2026  - Step lanes for probability, ratchet, gate length
+ *                           and octave (LANES below).
+ *                         - Gates moved to ssbStutterGate (edge schedule).
+ *            Oct 18 2026  - Probability and random play use ssbRandom.
  * ============================================================================
  *  License:
  *
@@ -88,6 +131,20 @@
  *  visit http://creativecommons.org/licenses///
  *===========================================================================*/
 
+// DEBUGGING
+// Set to SSB_LEVEL_ERROR, SSB_LEVEL_INFO or SSB_LEVEL_VERBOSE to enable debug
+// output. Debug calls above the level are not compiled in. INFO reports the
+// SRAM map at startup. The SRAM of each table and object is listed at build
+// time by hostTest/sramMap/sramMap.py.
+#define SSB_DEBUG_LEVEL SSB_LEVEL_OFF
+#include <ssbDebugLevel.h>
+#include <ssbSlew.h>
+#include <ssbRandom.h>
+#include <ssbSequencer.h>
+#include <ssbPatternBank.h>
+#include <ssbArdM4L.h>
+#include <ssbStutterGate.h>
+
 /*=============================================================================
  * Globals and Constants
  *===========================================================================*/
@@ -115,25 +172,69 @@ const int     QNOTES[(NOTE_COUNT + 1)]   = {
     810, 827, 844, 862, 879, 896, 913, 930, 947, 964, 981, 998, // OCT7
    1015};
 
-const int     MAX_STEP             = 15;
-const int     MIN_STEP             = 0;
-const int     REST_NOTE            = 512;
-
-// values may be:
-//  0       - play root note
-//  1 - 24  - play note 1 - 24 semitones above root
-// -1 - -24 - play note 1 - 24 semitones below root
-//  512     - play a rest (no note, 'magic number')
-//    S1,  S2,  S3,  S4,  S5,  S6,  S7,  S8,  S9, S10, S11, S12, S13, S14, S15, S16
-const int     SONGPAT[8][(MAX_STEP + 1)] = {
-    {  0,   5,   7,   9,   12,   512,   0,   -5,   -7,   -9,   -12,   512,   0,   5,   0,   -5},
-    {  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0},
-    {  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0},
-    {  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0},
-    {  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0},
-    {  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0},
-    {  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0},
-    {  0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0}};
+const int     PATTERN_COUNT        = 16;
+
+// EDIT THESE VALUES TO CHANGE THE PATTERNS!!!!
+// values may be (see ssbSequencer.h):
+//  SEQ_NOTE(0)       - play root note
+//  SEQ_NOTE(1 - 31)  - play note 1 - 31 semitones above root
+//  SEQ_NOTE(-1 - -31)- play note 1 - 31 semitones below root
+//  SEQ_REST          - play a rest (no note)
+//  | SEQ_TIE         - play the step before legato
+//  | SEQ_ACCENT      - accented step (see D1_ACCENT_ONLY)
+// Patterns are 16 steps here, PATTERN_LEN sets how many are played (1 - 16).
+#define R SEQ_REST
+#define N(offset) SEQ_NOTE(offset)
+//    S1,     S2,     S3,     S4,     S5,     S6,     S7,     S8,     S9,    S10,    S11,    S12,    S13,    S14,    S15,    S16
+const byte    SONGPAT[PATTERN_COUNT][16] PROGMEM = {
+    {N(0),   N(5),   N(7),   N(9),   N(12),  R,      N(0),   N(-5),  N(-7),  N(-9),  N(-12), R,      N(0),   N(5),   N(0),   N(-5)},
+    {N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0)},
+    {N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0)},
+    {N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0)},
+    {N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0)},
+    {N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0)},
+    {N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0)},
+    {N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0)},
+    {N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0)},
+    {N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0)},
+    {N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0)},
+    {N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0)},
+    {N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0)},
+    {N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0)},
+    {N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0)},
+    {N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0),   N(0)}};
+#undef R
+#undef N
+
+// EDIT THESE VALUES TO CHANGE THE STEP LANES!!!!
+// One lane byte for each step of SONGPAT (see above and ssbSequencer.h).
+// 0 plays every step once, full length, no octave shift.
+//   S1,  S2,  S3,  S4,  S5,  S6,  S7,  S8,  S9, S10, S11, S12, S13, S14, S15, S16
+const byte    LANES[PATTERN_COUNT][16] PROGMEM = {
+    {   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0},
+    {   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0},
+    {   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0},
+    {   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0},
+    {   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0},
+    {   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0},
+    {   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0},
+    {   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0},
+    {   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0},
+    {   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0},
+    {   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0},
+    {   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0},
+    {   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0},
+    {   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0},
+    {   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0},
+    {   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0}};
+const byte    PATTERN_LEN[PATTERN_COUNT] PROGMEM = {
+    16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16};
+
+// EDIT THESE VALUES TO CHANGE THE PLAYBACK!!!!
+// DIRECTION is SEQ_FORWARD, SEQ_REVERSE, SEQ_PENDULUM or SEQ_RANDOM.
+// With D1_ACCENT_ONLY true, D1 only gates on accented steps.
+const byte    DIRECTION            = SEQ_FORWARD;
+const boolean D1_ACCENT_ONLY       = false;
 
 const int     MAX_VAL              = 1023;
 const int     MIN_VAL              = 0;
@@ -141,24 +242,39 @@ const int     HALFWAY              = MAX_VAL / 2;
 const int     PAD_MS               = 10;              // ms
 const int     SGATE_COUNTS[7]      = {8, 4, 2, 1, 2, 4, 8};
 
+// Serial pattern bank commands: [cmd,bank,...]
+const int     BANK_WRITE           = 1;
+const int     BANK_SELECT          = 2;
+const int     BANK_FRAME_LEN       = 3 + PBANK_STEPS;
+
+// EDIT THESE VALUES TO CHANGE THE GLIDE (PORTAMENTO)!!!!
+// GLIDE_MS is the glide time in ms (0 is no glide). With GLIDE_CONSTANT_TIME
+// true every note takes GLIDE_MS, false it is the time for a 5 octave move.
+const unsigned int GLIDE_MS        = 0;
+const boolean GLIDE_CONSTANT_TIME  = true;
+
 int           qNoteVal             = 0;
+ssbSlew       GLIDE                = ssbSlew(GLIDE_MS);
 
 int           pattIndex            = 0;
-int           stepIndex            = 0;
+ssbSequencer  SEQ                  = ssbSequencer();
+int           gatePad              = PAD_MS;         // PAD_MS, or 0 before a tie.
+ssbPatternBank BANK                = ssbPatternBank();
+ssbArdM4L     M4L                  = ssbArdM4L();
+byte          writeBank            = 0;              // Bank of the write in progress.
+unsigned int  writeErrors          = 0;
 
 long          lastTrig             = 0;
 long          trigTempo            = 500;            // ms trig to trig, default is 500 or 2 trig per sec or 120bpm...
-long          gateStart[2]         = {0, 0};
-int           gateDur[2]           = {0, 0};
-boolean       gateOver[2]          = {true, true};
-boolean       gateOn[2]            = {false, false};
-int           stutterCount[2]      = {0, 0};
-int           stutterGate[2]       = {1, 1};         // number of sequenced gates. default is 1, values 2, 4, 8 are for stutter steps.
+ssbStutterGate GATES[2]            = {ssbStutterGate(), ssbStutterGate()};
 boolean       noteOn               = false;
 
 //  variables for interrupt handling of the clock input
 volatile int  clkState             = LOW;
 
+//DEBUGGING:
+SSB_DEBUG(ssbDebug    DEBUG                 = ssbDebug();)
+
 /*=============================================================================
  * setup() START 
  * Setup patch. Enable state of pins as needed.
@@ -169,6 +285,10 @@ void setup()
 {
     // Read the sketch index from A0 Input and the A1 Input.
     pattIndex = SetPattern(analogRead(A0_INPUT), analogRead(A1_INPUT));
+    SEQ.setPattern(SONGPAT[pattIndex], pgm_read_byte(&PATTERN_LEN[pattIndex]));
+    SEQ.setLanes(LANES[pattIndex]);
+    SEQ.seed(analogRead(A5_INPUT) ^ micros());
+    SEQ.setDirection(DIRECTION);
 
     // set up the digital (clock) input
     pinMode(CLOCK_IN, INPUT);
@@ -189,6 +309,17 @@ void setup()
 
     // Interrupt for clock input.
     attachInterrupt(0, isr, RISING);
+
+    GLIDE.setConstantTime(GLIDE_CONSTANT_TIME);
+
+    // Pattern banks (serial).
+    BANK.begin();
+    M4L.enableSerial();
+
+    // Debugging (SRAM budget)
+    SSB_DEBUG(DEBUG.enableSerial());
+    SSB_DEBUG(DEBUG.debugState(true));
+    SSB_DEBUG_INFO(DEBUG.debugMem());
 }
 
 /*=============================================================================
@@ -203,9 +334,9 @@ void setup()
  * ----------------------------------------------------------------------------
  * Logic:
  *     - on clock input
- *         - get step index
+ *         - advance the sequencer
  *         - get root note
- *         - get note index / magic number
+ *         - get note index / rest
  *         - if note index
  *             - get quantized note DAC out
  *             - set gate start for D0/D1
@@ -238,73 +369,62 @@ void loop()
         clkState = LOW;
         
         // Process Note Data
+        SEQ.advance();
         noteIndex = GetNoteIndex();
-        noteOffset = GetNextNote(noteIndex, stepIndex, pattIndex);
-        // If not a rest note
-        if (noteOffset == REST_NOTE)
+        noteOffset = GetNextNote(noteIndex);
+        // If a rest note (or the probability lane skipped the step)
+        if ((SEQ.isRest() == true) || (SEQ.isPlayed() == false))
         {
             noteOn = false;
             for (int i = 0; i < 2; i++)
             {
-                gateOn[i] = false;
-                gateOver[i] = true;
-                gateStart[i] = 0;
-                stutterCount[i] = 0;
-                gateDur[i] = 0;
-                stutterGate[i] = 0;
+                GATES[i].unsetGate();
             }
         }
         else
         {
             // Update Quantized CV Note Data
             qNoteVal = QNOTES[noteOffset];
+            // No pad gap if the next step is tied to this one.
+            gatePad = GetGatePad();
             
-            // Update Gate Information
+            // Update Gate Information. The whole gate schedule (stutter,
+            // ratchet and length) is set here.
             for (int i = 0; i < 2; i++)
             {
-                gateStart[i] = millis();
-                stutterCount[i] = 1;
-                gateOn[i] = true;
-                gateOver[i] = false;
                 stutterIndex = map(analogRead(SUTTER_CTLS[i]), MIN_VAL, MAX_VAL, 0, 6);
-                gateDur[i] = GetGateWidth(i, trigTempo, stutterIndex);
-                stutterGate[i] = GetStutterCount(stutterIndex);
+                SetGate(i, GetGateWidth(i, trigTempo, stutterIndex), GetStutterCount(stutterIndex));
+            }
+            if ((D1_ACCENT_ONLY == true) && (SEQ.isAccent() == false))
+            {
+                GATES[1].unsetGate();
             }
         }
-        // Update Step Sequencer State
-        UpdateStepIndex();
         
         // Update Trigger Tempo Data
         UpdateTrigTempo();
     }
     for (int i = 0; i < 2; i++)
     {
-        if (noteOn == true)
-        {
-            gateOn[i] = CalcGateState(i, gateOn[i]);
-        }
-        if (gateOn[i] == true)
-        {
-            digitalWrite(DIG_PINS[i], HIGH);
-        }
-        else
-        {
-            digitalWrite(DIG_PINS[i], LOW);
-        }
+        GATES[i].updateState();
+        GATES[i].render(DIG_PINS[i]);
+    }
+    noteOn = ((GATES[0].isActive() == true) || (GATES[1].isActive() == true));
+    // Glide to the note, then scale the 10 bit value to the 8 bit DAC.
+    GLIDE.setTarget(qNoteVal);
+    dacOutput((GLIDE.update() >> 2));
+    // Pattern banks. A write is one EEPROM byte per loop at most.
+    if (M4L.doRead() == true)
+    {
+        HandleBankFrame();
     }
-    noteOn = CalcNoteState(noteOn);
-    dacOutput(qNoteVal);
-    //debug_data();
-    /* Debugging
-    Comment out (move close) to disable debugging.
-    if (debug == true)
+    if (BANK.update() == true)
     {
-        Serial.println("===========================");
-        Serial.print("Note ON 2: ");
-        Serial.println(noteOn);
-        Serial.println("===========================");
+        ReportBank(BANK_WRITE, writeBank, (BANK.getErrorCount() == writeErrors), BANK.getWriteMillis());
     }
-    */
+    // Debugging
+    SSB_DEBUG_VERBOSE(DEBUG.debugValue("Note ON 2: ", noteOn));
+    SSB_DEBUG(DEBUG.updateTicks());
 }
 
 /*=============================================================================
@@ -317,14 +437,14 @@ void loop()
 
 int SetPattern(int a0_state, int a1_state)
 {
-    // A0 Sets a value of 0 - 3
+    // A0 Sets a value of 0 - 7
     // A1 Sets a value of 0 - 1
-    // So if A1 is 0, output is 0 - 3
-    // If A2 is 1,    output is 4 - 7
-    // Giving access to a total of 8 patterns...
-    int a0_base = map(analogRead(A0_INPUT), MIN_VAL, MAX_VAL, MIN_VAL, 3);
-    int a1_shift = map(analogRead(A1_INPUT), MIN_VAL, MAX_VAL, MIN_VAL, 1);
-    return (a0_base + a1_shift);
+    // So if A1 is 0, output is 0 - 7
+    // If A1 is 1,    output is 8 - 15
+    // Giving access to a total of 16 patterns...
+    int a0_base = map(a0_state, MIN_VAL, MAX_VAL, MIN_VAL, 7);
+    int a1_shift = map(a1_state, MIN_VAL, MAX_VAL, MIN_VAL, 1);
+    return (a0_base + (a1_shift * 8));
 }
 
 int GetNoteIndex()
@@ -341,13 +461,12 @@ int GetNoteIndex()
     return rootIndex;
 }
 
-int GetNextNote(int iRoot, int iStep, int iPatt)
+int GetNextNote(int iRoot)
 {
-    int semiToneOffset = SONGPAT[iPatt][iStep];
-    int noteIndex = REST_NOTE;
-    if (semiToneOffset != REST_NOTE)
+    int noteIndex = iRoot;
+    if (SEQ.isRest() == false)
     {
-        noteIndex = (iRoot + semiToneOffset);
+        noteIndex = (iRoot + SEQ.getOffset() + (SEQ.getOctave() * 12));
         if (noteIndex > NOTE_COUNT)
         {
             while (noteIndex > NOTE_COUNT)
@@ -402,72 +521,76 @@ int GetGateWidth(int index, long tempo, int stutterIndex)
     return gTime;
 }
 
-boolean CalcGateState(int gateIndex, boolean gateState)
+void SetGate(int index, int dur, int count)
 {
-    boolean gOn = false;
-    // if gate on
-    //     gate off
-    //     if start + (width-pad) > current time
-    //         gate on
-    //     if gate off
-    //         if stutter count < stutter gate count
-    //             update start to be (start + width)
-    //         else
-    //             gate over
-    // else if gate off and stutter count < stutter gate count and start <= current time
-    //     stutter count = stutter count + 1
-    //     gate on
-    // else
-    //     gate off
-    // gateStart[i], gateWidth[i], stutterCount[i], stutterGate[i]
-    //            gateOn[i] = true;
-    //            gateOver[i] = false;
-    if (gateState == true)
-    {
-        if ((gateStart[gateIndex] + gateDur[gateIndex] - PAD_MS) > millis())
-        {
-            gOn = true;
-        }
-        if (gOn == false)
-        {
-            if (stutterCount[gateIndex] < stutterGate[gateIndex])
-            {
-                gateStart[gateIndex] = gateStart[gateIndex] + gateDur[gateIndex];
-            }
-            else
-            {
-                gateOver[gateIndex] = true;
-            }
-        }
-    }
-    else if ((stutterCount[gateIndex] < stutterGate[gateIndex]) && (gateStart[gateIndex] <= millis()))
+    // Ratchets split the gate (or each stutter) into equal gates.
+    int ratchet = SEQ.getRatchet();
+    int length = 0;                 // 0 is the full gate.
+    dur = dur / ratchet;
+    count = count * ratchet;
+    if (SEQ.getGateQuarters() < 4)
     {
-        gOn = true;
-        stutterCount[gateIndex]++;
+        length = (dur / 4) * SEQ.getGateQuarters();
     }
-    return gOn;
+    GATES[index].setStutterGapMS(gatePad);
+    GATES[index].updateGate(dur, count, length);
 }
 
-boolean CalcNoteState(boolean curNoteOn)
+void HandleBankFrame()
 {
-    boolean localNoteOn = false;
-    if (curNoteOn == true)
+    int data[BANK_FRAME_LEN];
+    byte steps[PBANK_STEPS];
+    boolean ok = false;
+    int len = 0;
+    M4L.getBufferAsIntArray(data, 3, ',');
+    if ((data[0] == BANK_SELECT) && (BANK.load(data[1]) == true))
+    {
+        SEQ.setRamPattern(BANK.getSteps(), BANK.getLength());
+        ok = true;
+    }
+    if (data[0] == BANK_SELECT)
+    {
+        ReportBank(BANK_SELECT, data[1], ok, BANK.getLoadMicros());
+    }
+    else if (data[0] == BANK_WRITE)
     {
-        if ((gateOver[0] == false) || (gateOver[1] == false))
+        len = constrain(data[2], 1, PBANK_STEPS);
+        M4L.getBufferAsIntArray(data, 3 + len, ',');
+        for (int i = 0; i < len; i++)
         {
-            localNoteOn = true;
+            steps[i] = data[3 + i];
+        }
+        writeErrors = BANK.getErrorCount();
+        writeBank = data[1];
+        if (BANK.write(writeBank, steps, len) == false)
+        {
+            // Busy or bad bank, reply now. A good write replies when done.
+            ReportBank(BANK_WRITE, writeBank, false, 0);
         }
     }
-    return localNoteOn;
 }
 
-void UpdateStepIndex()
+void ReportBank(int cmd, int bank, boolean ok, unsigned long time)
+{
+    Serial.print('[');
+    Serial.print(cmd);
+    Serial.print(',');
+    Serial.print(bank);
+    Serial.print(',');
+    Serial.print(ok);
+    Serial.print(',');
+    Serial.print(time);
+    Serial.println(']');
+}
+
+int GetGatePad()
 {
-    stepIndex++;
-    if (stepIndex > MAX_STEP)
+    int pad = PAD_MS;
+    if ((SEQ.peekNext() & SEQ_TIE) != 0)
     {
-        stepIndex = 0;
+        pad = 0;
     }
+    return pad;
 }
 
 void UpdateTrigTempo()
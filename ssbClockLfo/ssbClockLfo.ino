@@ -0,0 +1,152 @@
+/*
+Program: ssbClockLfo
+Description:
+    A tempo synced LFO. With A2 low the LFO runs free, A0 sets the rate
+    (0.01Hz - 50Hz). With A2 high the LFO follows the clock input, A0
+    selects the ratio to the clock (/8, /4, /3, /2, x1, x2, x3, x4, x8)
+    and the cycle restarts on the clock, so it stays locked when the tempo
+    changes. A1 selects the shape (sine, triangle, saw, square, random
+    step). D0 passes the clock through as a gate, D1 is high for the first
+    half of each LFO cycle (a square wave gate at the LFO rate).
+
+    I/O Usage:
+        Knob A0:         Rate (free) or clock ratio (sync)
+        Knob A1:         Shape (sine, triangle, saw, square, random)
+        Knob/Jack A2:    Free (low) or clock sync (high)
+        Knob/Jack A3:    Unused
+        Digital Out 1:   Clock gate
+        Digital Out 2:   LFO cycle gate (high for the first half)
+        Clock In:        Clock
+        Analog Out:      LFO out
+    Input Expander:
+        Knob A4/Jack A4: Unused
+        Knob A5/Jack A5: Unused
+    Output Expander:
+        Bits 0-7:        LFO out (the same bits as the DAC)
+        Analog Out 11:   Unused
+        Digital Out 13:  Unused
+    Serial:              Unused
+
+    Created:  Oct 18 2026 by Peter Fawcett (SoundSweepsBy).
+        Version 1 - Original patch developement.
+        Version 2 - Oct 18 2026:
+          The random step shape is seeded from ADC noise, millis() is
+          about 0 in setup so every start gave the same steps.
+
+    ============================================================
+
+    License:
+
+    This software is licensed under the Creative Commons
+    "Attribution-NonCommercial license. This license allows you
+    to tweak and build upon the code for non-commercial purposes,
+    without the requirement to license derivative works on the
+    same terms. If you wish to use this (or derived) work for
+    commercial work, please contact Peter Fawcett at our website
+    (www.SoundSweepsBy.com).
+    
+    For more information on the Creative Commons CC BY-NC license,
+    visit http://creativecommons.org/licenses/
+*/
+
+#include <ssbArdBase.h>
+#include <ssbGate.h>
+#include <ssbWaves.h>
+#include <ssbLfo.h>
+
+const byte  NOISE_READS                     = 32;
+const int   RATIO_COUNT                     = 9;
+const byte  RATIO_MULT[RATIO_COUNT]         = {1, 1, 1, 1, 1, 2, 3, 4, 8};
+const byte  RATIO_DIV[RATIO_COUNT]          = {8, 4, 3, 2, 1, 1, 1, 1, 1};
+
+bool        clock_state                     = false;
+bool        clock_sync                      = false;
+int         ratio_index                     = -1;
+ssbGate     d_gates[GATE_COUNT]             = {ssbGate(), ssbGate()};
+ssbLfo      LFO                             = ssbLfo(WAVE_SINE_ID);
+
+//  ==================== setup() START ======================
+//
+//  Setup patch. Enable state of pins as needed.
+//  This code will run once at start of patch, right after load.
+//
+void setup()
+{
+    seedFromNoise();
+    // set up the digital outputs
+    for (int i = 0; i < GATE_COUNT; i++)
+    {
+        pinMode(DIG_PINS[i], OUTPUT);
+        digitalWrite(DIG_PINS[i], LOW);
+    }
+    // set up the 8-bit DAC output pins
+    for (int i = 0; i < 8; i++)
+    {
+        pinMode(PIN_OFFSET + i, OUTPUT);
+        digitalWrite(PIN_OFFSET + i, LOW);
+    }
+    setClockInterrupt();
+}
+//  ==================== setup() END =======================
+
+//  ==================== loop() START =======================
+//
+//  Master Loop.
+//  Loop will be called over and over with out pause.
+//  Main logic of patch.
+//
+void loop()
+{
+    int ratio = 0;
+    clock_state = readClockState();
+    if (clock_state)
+    {
+        // We have a leading edge of a clock pulse.
+        LFO.clockEdge();
+        d_gates[0].setState(true);
+    }
+    else if (digitalRead(CLOCK_IN) == false)
+    {
+        d_gates[0].setState(false);
+    }
+
+    clock_sync = getCtlHighLow(A2_INPUT);
+    if (clock_sync)
+    {
+        ratio = getCtlIndex(A0_INPUT, RATIO_COUNT - 1);
+        if (ratio != ratio_index)
+        {
+            ratio_index = ratio;
+            LFO.setClockRatio(RATIO_MULT[ratio_index], RATIO_DIV[ratio_index]);
+        }
+    }
+    else
+    {
+        ratio_index = -1;
+        LFO.setRate(analogRead(A0_INPUT));
+    }
+    LFO.setShape(getCtlIndex(A1_INPUT, LFO_SHAPE_COUNT - 1));
+
+    dacOutput(LFO.update());
+    d_gates[1].setState(LFO.getPhase() < 0x8000);
+    for (int i = 0; i < GATE_COUNT; i++)
+    {
+        d_gates[i].render(DIG_PINS[i]);
+    }
+}
+//  ==================== loop() END =======================
+
+/* seedFromNoise
+ - Seed random() from the low bit of NOISE_READS reads of the unused A5
+   (an open jack or a knob, the low bit moves with noise), mixed with
+   micros in case the pin is quiet.
+*/
+void seedFromNoise()
+{
+    unsigned long noise = 0;
+    for (byte i = 0; i < NOISE_READS; i++)
+    {
+        noise = (noise << 1) | (analogRead(A5_INPUT) & 1);
+    }
+    randomSeed(noise ^ micros());
+}
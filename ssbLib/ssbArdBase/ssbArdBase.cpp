@@ -14,6 +14,9 @@
                     - mapCtlIndex
                     - getCtlIndex
                     - DAC_BITS and GATE_COUNT constants.
+    Version 0.3: Oct 18. 2026
+                    Added
+                    - expanderBitsOut
 
 ============================================================
 
@@ -103,6 +106,15 @@ void expanderGatesOut(bool bit0,
     dacOutput(sig_total);
 }
 
+/* expanderBitsOut
+- Write a byte to the expander bits (DAC bits 0 - 7) as gates or triggers.
+*/
+void expanderBitsOut(byte bits)
+{
+    PORTB = (PORTB & B11100000) | (bits >> 3);
+    PORTD = (PORTD & B00011111) | ((bits & B00000111) << 5);
+}
+
 /* expanderGateBang
 - Use the expander as a sequential gate for sequences, steps and switches.
 Will also produce various stepped voltages on the DAC outputs.
@@ -234,3 +246,12 @@ int getCtlIndex(int pin, int min_index, int max_index)
     }
     return tmp_val;
 }
+
+/* setFastAdc
+- ADC prescaler 16 (ADPS bits 100). The default (128) gives 125kHz, the
+ATmega328 is rated to 200kHz for full 10 bit accuracy.
+*/
+void setFastAdc()
+{
+    ADCSRA = (ADCSRA & B11111000) | B00000100;
+}
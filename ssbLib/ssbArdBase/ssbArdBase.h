@@ -14,6 +14,12 @@
                     - mapCtlIndex
                     - getCtlIndex
                     - DAC_BITS and GATE_COUNT constants.
+    Version 0.3: Oct 18. 2026
+                    Added
+                    - expanderBitsOut
+    Version 0.4: Oct 18. 2026
+                    Added
+                    - setFastAdc
 
 ============================================================
 
@@ -74,6 +80,10 @@ void expanderGatesOut(bool bit0,
                       bool bit6, 
                       bool bit7);
 
+// - Write a byte (bit 0 - 7) straight to the expander bits. Same as
+// expanderGatesOut with out the bools and the adds.
+void expanderBitsOut(byte bits);
+
 // - Turn on or off a single gate. Useful for step counters or
 // step switches.
 void expanderGateBang(int gate_index);
@@ -109,5 +119,9 @@ bool getCtlHighLow(int pin);
 // - control index (CV or Pot)
 int getCtlIndex(int pin, int max_index);
 int getCtlIndex(int pin, int min_index, int max_index);
+// - Set the ADC clock prescaler to 16 (1MHz) so an analogRead takes about
+//   16us rather than about 112us. Still good to about 8 bits, plenty for
+//   gates, logic and knobs.
+void setFastAdc();
 
 #endif /* _ssb_ard_base_ */
@@ -8,6 +8,10 @@
     
   Created by Peter Fawcett, Sept 28. 2015.
     Version 0.1: Created basic ssbArdM4L Obect
+    Version 0.2: Oct 18. 2026
+                    Added frame statistics and reportStats.
+    Version 0.3: Oct 18. 2026
+                    doRead is only true once per frame.
 
 ============================================================
 
@@ -34,6 +38,8 @@ ssbArdM4L::ssbArdM4L()
     _close_marker = ']';        // Default char stream closer.
     _input_buffer = "";         // String object to contain input buffer.
     _buffer_full = false;       // Is the i/o buffer fully updated.
+    _in_frame = false;          // Not inside a frame till an open marker is read.
+    resetStats();
 }
 
 ssbArdM4L::ssbArdM4L(char open_marker, char close_marker)
@@ -43,6 +49,8 @@ ssbArdM4L::ssbArdM4L(char open_marker, char close_marker)
     _close_marker = close_marker;   // Default char stream closer.
     _input_buffer = "";             // String object to contain input buffer.
     _buffer_full = false;           // Is the i/o buffer fully updated.
+    _in_frame = false;              // Not inside a frame till an open marker is read.
+    resetStats();
 }
 
 ssbArdM4L::~ssbArdM4L()
@@ -64,6 +72,7 @@ void ssbArdM4L::enableSerial(unsigned int baud_rate)
 
 bool ssbArdM4L::doRead()
 {
+    bool is_new = false;
     if (Serial.available() > 0)
     {
         // NOTE: Data MUST be read from buffer when doRead returns true, 
@@ -71,19 +80,42 @@ bool ssbArdM4L::doRead()
         char tmp_c = (char)Serial.read();
         if (tmp_c == _open_marker)
         {
+            if (_in_frame == true)
+            {
+                // previous frame never closed.
+                _dropped_count++;
+            }
             _input_buffer = "";
             _buffer_full = false;
+            _in_frame = true;
+        }
+        else if (_in_frame == false)
+        {
+            // char outside of a frame (or close marker with no open).
+            _error_count++;
         }
         else if (tmp_c == _close_marker)
         {
             _buffer_full = true;                                
+            _in_frame = false;
+            _frame_count++;
+            is_new = true;
+        }
+        else if (_input_buffer.length() >= M4L_MAX_FRAME_LEN)
+        {
+            // frame too long, drop it rather than grow the buffer.
+            _input_buffer = "";
+            _in_frame = false;
+            _dropped_count++;
         }
         else
         {
             _input_buffer += tmp_c;
         }
     }
-    return _buffer_full;
+    // The buffer stays valid till the next open marker, but the frame is
+    // only reported once, so a command is not run again every loop.
+    return is_new;
 }
 
 int ssbArdM4L::getBufferAsInt()
@@ -136,7 +168,6 @@ void ssbArdM4L::getBufferAsIntArray(int* data, int list_len, char sep_char)
 
 void ssbArdM4L::getBufferAsCharArray(char* data, int list_len, char sep_char)
 {
-    int tmp_int = 0;
     String tmp_str = "";
     int current_comma_index = -1;
     int next_comma_index = -1;
@@ -167,3 +198,36 @@ void ssbArdM4L::getBufferAsCharArray(char* data, int list_len, char sep_char)
         index++;
     }
 }
+
+unsigned int ssbArdM4L::getFrameCount()
+{
+    return _frame_count;
+}
+
+unsigned int ssbArdM4L::getDroppedCount()
+{
+    return _dropped_count;
+}
+
+unsigned int ssbArdM4L::getErrorCount()
+{
+    return _error_count;
+}
+
+void ssbArdM4L::resetStats()
+{
+    _frame_count = 0;
+    _dropped_count = 0;
+    _error_count = 0;
+}
+
+void ssbArdM4L::reportStats()
+{
+    Serial.print(_open_marker);
+    Serial.print(_frame_count);
+    Serial.print(',');
+    Serial.print(_dropped_count);
+    Serial.print(',');
+    Serial.print(_error_count);
+    Serial.println(_close_marker);
+}
@@ -5,6 +5,13 @@
     
   Created by Peter Fawcett, Dec 10. 2014.
     Version 0.1: Created basic ssbDebug Obect
+    Version 0.2: Oct 18. 2026
+                    Added frame statistics (frames, dropped frames and
+                    parse errors) and reportStats so serial throughput
+                    can be checked from the host side.
+    Version 0.3: Oct 18. 2026
+                    doRead is only true on the call that completes a frame.
+                    Frame length raised to 80 for pattern uploads.
 
 ============================================================
 
@@ -27,6 +34,9 @@ visit http://creativecommons.org/licenses/
 
 #import <Arduino.h>
 
+// Longest frame (chars between markers) accepted before the frame is dropped.
+const unsigned int  M4L_MAX_FRAME_LEN   = 80;
+
 class ssbArdM4L
 {
     private:
@@ -35,6 +45,10 @@ class ssbArdM4L
         char            _close_marker;  // Closing char for i/o string. Default ']'
         String          _input_buffer;  // String to contian buffer of char objects
         bool            _buffer_full;   // Is the i/o buffer fully updated.
+        bool            _in_frame;      // Has an open marker been read with out a close marker.
+        unsigned int    _frame_count;   // Number of complete frames read.
+        unsigned int    _dropped_count; // Number of frames dropped (restarted or too long).
+        unsigned int    _error_count;   // Number of chars read outside of a frame.
     public:
         // Constructors
         ssbArdM4L();
@@ -48,13 +62,23 @@ class ssbArdM4L
 
         // handle input
         // NOTE: Data MUST be read from buffer when doRead returns true, 
-        //       or the data will be lost!
+        //       or the data will be lost! doRead is only true on the call
+        //       that reads the close marker.
         bool doRead();
         int getBufferAsInt();
         float getBufferAsFloat();
         void getBufferAsStr(String *buffer_str);
         void getBufferAsIntArray(int* data, int list_len, char sep_char);
         void getBufferAsCharArray(char* data, int list_len, char sep_char);
+
+        // Frame statistics. Counters wrap at 65535.
+        unsigned int getFrameCount();
+        unsigned int getDroppedCount();
+        unsigned int getErrorCount();
+        void resetStats();
+        // - Write the statistics to the serial output as a frame:
+        //   [frames,dropped,errors]
+        void reportStats();
 };
 
 #endif // _ssb_max4live_class_
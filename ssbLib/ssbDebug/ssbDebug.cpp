@@ -5,6 +5,17 @@
 
   Created by Peter Fawcett, Dec 10. 2014.
     Version 0.1: Created basic ssbDebug Obect
+    Version 0.2: Oct 18. 2026
+                    Added trace mode.
+    Version 0.3: Oct 18. 2026
+                    Made trace stamps and the trace buffer interrupt safe.
+    Version 0.4: Oct 18. 2026
+                    Added debugProfile.
+                    Added stack painting and memory statistics.
+    Version 0.5: Oct 18. 2026
+                    Fixed free min after the heap shrinks.
+    Version 0.6: Oct 18. 2026
+                    Removed debugSize.
 
 ============================================================
 
@@ -28,6 +39,43 @@ visit http://creativecommons.org/licenses/
 // used by getFreeMem call.
 extern int __bss_end;
 extern void *__brkval;
+// used by the memory map and stack high water mark.
+extern int __data_start;
+extern int __data_end;
+extern int __bss_start;
+extern int __heap_start;
+extern int __stack;
+
+// avr-libc malloc free list.
+struct __freelist
+{
+    size_t sz;
+    struct __freelist *nx;
+};
+extern struct __freelist *__flp;
+
+/* ssb_paint_stack
+- Fill the free SRAM (end of .bss up to the top of the stack) with
+STACK_CANARY. Runs from .init1, before the stack or the zero register are
+set up, so it is written in asm and must not be called.
+*/
+void ssb_paint_stack(void) __attribute__ ((naked, used, section (".init1")));
+
+void ssb_paint_stack(void)
+{
+    __asm volatile ("    ldi r30,lo8(_end)\n"
+                    "    ldi r31,hi8(_end)\n"
+                    "    ldi r24,0xC5\n"          // STACK_CANARY
+                    "    ldi r25,hi8(__stack)\n"
+                    "    rjmp .ssb_paint_cmp\n"
+                    ".ssb_paint_loop:\n"
+                    "    st Z+,r24\n"
+                    ".ssb_paint_cmp:\n"
+                    "    cpi r30,lo8(__stack)\n"
+                    "    cpc r31,r25\n"
+                    "    brlo .ssb_paint_loop\n"
+                    "    breq .ssb_paint_loop"::);
+}
 
 ssbDebug::ssbDebug()
 {
@@ -39,6 +87,13 @@ ssbDebug::ssbDebug()
     _tick_count = 0;            // Default to 0 as it is not not used in the default state.
     _current_tick = 0;          // Default to 0 as it is not not used in the default state.
     _do_print = false;
+    _trace_buf = 0;             // Tracing is off till enableTrace is called.
+    _trace_mask = 0;
+    _trace_head = 0;
+    _trace_tail = 0;
+    _trace_lost = 0;
+    _brk_high = 0;
+    _stack_low = 0;
 }
 
 ssbDebug::ssbDebug(unsigned int frequency)
@@ -51,6 +106,13 @@ ssbDebug::ssbDebug(unsigned int frequency)
     _tick_count = 0;            // Default to 0 as it is not not used in the default state.
     _current_tick = 0;          // Default to 0 as it is not not used in the default state.
     _do_print = false;
+    _trace_buf = 0;             // Tracing is off till enableTrace is called.
+    _trace_mask = 0;
+    _trace_head = 0;
+    _trace_tail = 0;
+    _trace_lost = 0;
+    _brk_high = 0;
+    _stack_low = 0;
 }
 
 ssbDebug::ssbDebug(unsigned int frequency, bool use_ms)
@@ -73,6 +135,13 @@ ssbDebug::ssbDebug(unsigned int frequency, bool use_ms)
         _current_tick = 0;      // Set current ticks to 0
     }
     _do_print = false;
+    _trace_buf = 0;             // Tracing is off till enableTrace is called.
+    _trace_mask = 0;
+    _trace_head = 0;
+    _trace_tail = 0;
+    _trace_lost = 0;
+    _brk_high = 0;
+    _stack_low = 0;
 }
 
 ssbDebug::ssbDebug(unsigned int frequency, bool use_ms, unsigned int baud_rate)
@@ -95,6 +164,13 @@ ssbDebug::ssbDebug(unsigned int frequency, bool use_ms, unsigned int baud_rate)
         _current_tick = 0;      // Set current ticks to 0
     }
     _do_print = false;
+    _trace_buf = 0;             // Tracing is off till enableTrace is called.
+    _trace_mask = 0;
+    _trace_head = 0;
+    _trace_tail = 0;
+    _trace_lost = 0;
+    _brk_high = 0;
+    _stack_low = 0;
 }
 
 ssbDebug::~ssbDebug()
@@ -292,6 +368,92 @@ int ssbDebug::getFreeMem()
     return freeValue;
 }
 
+// function to return the least amount of free RAM since reset
+// Heap given back by free (the break moves down) still holds heap data,
+// not the canary. It is painted again the first time the lower break is
+// seen, and stale heap above the break from a grow and shrink between
+// two calls is skipped, so the count is the canary gap below the stack.
+int ssbDebug::getMinFreeMem()
+{
+    byte *ptr = (byte *)__brkval;
+    byte *stack_ptr = (byte *)SP;
+    byte *end = _brk_high;
+    int count = 0;
+    if (ptr == 0)
+    {
+        ptr = (byte *)&__heap_start;
+    }
+    if (end > stack_ptr)
+    {
+        end = stack_ptr;
+    }
+    for (byte *paint = ptr; paint < end; paint++)
+    {
+        *paint = STACK_CANARY;
+    }
+    _brk_high = ptr;
+    while ((ptr < stack_ptr) && (*ptr != STACK_CANARY))
+    {
+        ptr++;
+    }
+    while ((ptr <= (byte *)&__stack) && (*ptr == STACK_CANARY))
+    {
+        ptr++;
+        count++;
+    }
+    _stack_low = ptr;
+    return count;
+}
+
+// function to return the deepest the stack has been since reset
+int ssbDebug::getStackPeak()
+{
+    getMinFreeMem();
+    return ((int)&__stack) - ((int)_stack_low) + 1;
+}
+
+int ssbDebug::getHeapSize()
+{
+    if (__brkval == 0)
+    {
+        return 0;
+    }
+    return ((int)__brkval) - ((int)&__heap_start);
+}
+
+int ssbDebug::getHeapFree()
+{
+    int total = 0;
+    for (struct __freelist *block = __flp; block != 0; block = block->nx)
+    {
+        total += block->sz + sizeof(size_t);
+    }
+    return total;
+}
+
+int ssbDebug::getHeapFreeBlocks()
+{
+    int count = 0;
+    for (struct __freelist *block = __flp; block != 0; block = block->nx)
+    {
+        count++;
+    }
+    return count;
+}
+
+int ssbDebug::getHeapLargestFree()
+{
+    int largest = 0;
+    for (struct __freelist *block = __flp; block != 0; block = block->nx)
+    {
+        if ((int)block->sz > largest)
+        {
+            largest = block->sz;
+        }
+    }
+    return largest;
+}
+
 void ssbDebug::debugValue(int value)
 {
     if ((_debug_on == true) && (Serial.available()))
@@ -439,9 +601,139 @@ void ssbDebug::debugOutput(int outSignal, boolean d0Out, boolean d1Out)
     }
 }
 
+void ssbDebug::debugMem()
+{
+    if (_debug_on == true)
+    {
+        Serial.println("SRAM map (bytes):");
+        Serial.print(".data: ");
+        Serial.println(((int)&__data_end) - ((int)&__data_start));
+        Serial.print(".bss: ");
+        Serial.println(((int)&__bss_end) - ((int)&__bss_start));
+        Serial.print("Heap: ");
+        Serial.println(getHeapSize());
+        Serial.print("Stack peak: ");
+        Serial.println(getStackPeak());
+        Serial.print("Free now: ");
+        Serial.println(getFreeMem());
+        Serial.print("Free min: ");
+        Serial.println(getMinFreeMem());
+        Serial.print("Heap free list: ");
+        Serial.print(getHeapFree());
+        Serial.print(" in ");
+        Serial.print(getHeapFreeBlocks());
+        Serial.print(" blocks, largest ");
+        Serial.println(getHeapLargestFree());
+    }
+}
+
+void ssbDebug::debugProfile(ssbProfile* profile)
+{
+    if (_debug_on == true)
+    {
+        if (_output_time() == true)
+        {
+            Serial.println("Section: min / max / mean (us) count");
+            for (byte i = 0; i < PROF_SECTIONS; i++)
+            {
+                if (profile->getCount(i) > 0)
+                {
+                    Serial.print(profile->getSectionName(i));
+                    Serial.print(": ");
+                    Serial.print(profile->getMin(i));
+                    Serial.print(" / ");
+                    Serial.print(profile->getMax(i));
+                    Serial.print(" / ");
+                    Serial.print(profile->getMean(i));
+                    Serial.print(" ");
+                    Serial.println(profile->getCount(i));
+                }
+            }
+        }
+    }
+}
+
+bool ssbDebug::enableTrace(ssbTraceEvent* buffer, byte size)
+{
+    // Off first, an ISR may be tracing.
+    _trace_buf = 0;
+    if ((size == 0) || ((size & (size - 1)) != 0))
+    {
+        return false;
+    }
+    uint8_t old_sreg = SREG;
+    cli();
+    _trace_mask = size - 1;
+    _trace_head = 0;
+    _trace_tail = 0;
+    _trace_lost = 0;
+    _trace_buf = buffer;
+    SREG = old_sreg;
+    return true;
+}
+
+void ssbDebug::flushTrace()
+{
+    if ((_trace_buf != 0) && (_trace_tail != _trace_head))
+    {
+        if (Serial.availableForWrite() >= 6)
+        {
+            _send_trace_event();
+        }
+    }
+}
+
+void ssbDebug::dumpTrace()
+{
+    if (_trace_buf != 0)
+    {
+        while (_trace_tail != _trace_head)
+        {
+            _send_trace_event();
+        }
+    }
+}
+
+unsigned int ssbDebug::getTraceLost()
+{
+    unsigned int lost;
+    uint8_t old_sreg = SREG;
+    cli();
+    lost = _trace_lost;
+    SREG = old_sreg;
+    return lost;
+}
+
 bool ssbDebug::_output_time()
 {
     //Serial.print("Output_Time::Do Print => ");
     //Serial.println(_do_print);
     return _do_print;
 }
+
+void ssbDebug::_send_trace_event()
+{
+    byte frame[6];
+    bool is_event = false;
+    // Copy the event out with interrupts off, a traceEvent from an ISR
+    // could over write it (and move the tail) part way through.
+    uint8_t old_sreg = SREG;
+    cli();
+    if (_trace_tail != _trace_head)
+    {
+        ssbTraceEvent* event = &_trace_buf[_trace_tail];
+        frame[0] = TRACE_SYNC;
+        frame[1] = event->id;
+        frame[2] = lowByte(event->time);
+        frame[3] = highByte(event->time);
+        frame[4] = lowByte(event->value);
+        frame[5] = highByte(event->value);
+        _trace_tail = (_trace_tail + 1) & _trace_mask;
+        is_event = true;
+    }
+    SREG = old_sreg;
+    if (is_event == true)
+    {
+        Serial.write(frame, 6);
+    }
+}
@@ -5,6 +5,26 @@
 
   Created by Peter Fawcett, Dec 10. 2014.
     Version 0.1: Created basic ssbDebug Obect
+    Version 0.2: Oct 18. 2026
+                    Added trace mode. Fixed size binary events are written
+                    to a ring buffer in RAM (a few cycles each) and sent
+                    over serial later, so hot loops keep their timing.
+    Version 0.3: Oct 18. 2026
+                    Trace stamps are read with interrupts off and count a
+                    Timer0 overflow that is pending but not yet serviced.
+                    The trace buffer indexes are updated with interrupts
+                    off, so events may be traced from an ISR and the loop.
+                    enableTrace rejects a size that is not a power of 2.
+    Version 0.4: Oct 18. 2026
+                    Added debugProfile to report ssbProfile sections.
+                    Added stack painting, stack high water mark, heap free
+                    list statistics and an SRAM map report (debugMem).
+    Version 0.5: Oct 18. 2026
+                    Free min and stack peak skip heap given back by free,
+                    which holds stale heap data rather than the canary.
+    Version 0.6: Oct 18. 2026
+                    Removed debugSize. Per object SRAM comes from the build
+                    (hostTest/sramMap).
 
 ============================================================
 
@@ -26,6 +46,36 @@ visit http://creativecommons.org/licenses/
 #define _ssb_debug_class_
 
 #include <Arduino.h>
+#include "ssbProfile.h"
+
+// ============================================================================
+// Trace Events:
+// ============================================================================
+// Each event is stamped with the Timer0 count used by millis()/micros(),
+// in 4us steps. The 16 bit stamp wraps every 262ms, the host decoder has to
+// unwrap it (events are in order, so a smaller stamp means a wrap). See
+// hostTest/traceDecode.
+// Events are sent over serial as 6 bytes (little endian):
+//   TRACE_SYNC, id, time lo, time hi, value lo, value hi
+const byte    TRACE_SYNC            = 0xA5;
+
+struct ssbTraceEvent
+{
+    unsigned int    time;   // Timer0 count, 4us per step.
+    byte            id;     // Event id, set by the sketch.
+    int             value;  // Value to record with the event.
+};
+
+// ============================================================================
+// Memory:
+// ============================================================================
+// Free SRAM is painted with STACK_CANARY before main runs (any patch that
+// links ssbDebug gets this). Bytes still holding the canary have never been
+// used by the stack or the heap.
+const byte    STACK_CANARY          = 0xC5;
+
+// Timer0 overflow count. From the Arduino core (wiring.c).
+extern volatile unsigned long timer0_overflow_count;
 
 class ssbDebug
 {
@@ -38,6 +88,13 @@ class ssbDebug
         unsigned int    _tick_count;    // Number of ticks between output (if ms_freq is false).
         unsigned int    _current_tick;  // The current tick count (if ms_freq is false).
         bool            _do_print;      // State. Will be set at end of loop on update and will print next run though.
+        ssbTraceEvent*  _trace_buf;     // Trace ring buffer, supplied by the sketch. 0 when tracing is off.
+        byte            _trace_mask;    // Buffer size - 1. Size must be a power of 2.
+        volatile byte   _trace_head;    // Next event to write.
+        volatile byte   _trace_tail;    // Next event to send.
+        volatile unsigned int _trace_lost; // Events over written before they were sent.
+        byte*           _brk_high;      // Heap break at the last getMinFreeMem.
+        byte*           _stack_low;     // Deepest stack byte found by getMinFreeMem.
     public:
         // Constructors
         ssbDebug();
@@ -83,6 +140,17 @@ class ssbDebug
 
         // Get the current amount of free memory in RAM
         int getFreeMem();
+        // Get the least amount of free memory there has been since reset
+        // (unused bytes between the top of the heap and the deepest stack).
+        int getMinFreeMem();
+        // Get the deepest the stack has been since reset.
+        int getStackPeak();
+        // Heap free list statistics. Free blocks are holes left by free
+        // (String growth for example) below the top of the heap.
+        int getHeapSize();
+        int getHeapFree();
+        int getHeapFreeBlocks();
+        int getHeapLargestFree();
 
         // Various debug outputs for general values
         void debugValue(int value);
@@ -98,8 +166,62 @@ class ssbDebug
 
         // Debug output for ArdOutputs.
         void debugOutput(int dac_out, boolean d0_out, boolean d1_out);
+
+        // Debug output for memory. SRAM map (.data, .bss, heap, stack),
+        // free memory and heap fragmentation. Output on every call.
+        // The SRAM used by each table or object is listed at build time
+        // from the .elf (hostTest/sramMap), sizeof can not tell a flash
+        // table from one in SRAM.
+        void debugMem();
+
+        // Debug output for ssbProfile. Min/max/mean (us) and count for
+        // each section that has run.
+        void debugProfile(ssbProfile* profile);
+
+        // Trace mode. Pass in a buffer (size must be a power of 2, max 128)
+        // to turn tracing on. Tracing does not need debugState to be on.
+        // Returns false (and tracing is off) if the size is not a power of 2.
+        bool enableTrace(ssbTraceEvent* buffer, byte size);
+        // - Record an event. Cheap enough for hot loops and ISRs.
+        //   When the buffer is full the oldest event is over written.
+        inline void traceEvent(byte id, int value)
+        {
+            if (_trace_buf != 0)
+            {
+                // Interrupts off: the stamp must not tear across a Timer0
+                // overflow, and an ISR may trace between the index updates.
+                uint8_t old_sreg = SREG;
+                cli();
+                unsigned int overflows = (unsigned int)timer0_overflow_count;
+                byte count = TCNT0;
+                // Overflowed, but the Timer0 ISR has not run yet (as micros).
+                if (((TIFR0 & _BV(TOV0)) != 0) && (count < 255))
+                {
+                    overflows++;
+                }
+                ssbTraceEvent* event = &_trace_buf[_trace_head];
+                event->time = (overflows << 8) | count;
+                event->id = id;
+                event->value = value;
+                _trace_head = (_trace_head + 1) & _trace_mask;
+                if (_trace_head == _trace_tail)
+                {
+                    _trace_tail = (_trace_tail + 1) & _trace_mask;
+                    _trace_lost++;
+                }
+                SREG = old_sreg;
+            }
+        }
+        // - Send at most one event, and only if it fits in the serial
+        //   output buffer. Call when the loop is idle. Never blocks.
+        void flushTrace();
+        // - Send all buffered events now (blocks till they are queued).
+        void dumpTrace();
+        // - Number of events over written before they were sent.
+        unsigned int getTraceLost();
     private:
         bool _output_time();
+        void _send_trace_event();
 };
 
 #endif // _ssb_debug_class_
@@ -0,0 +1,128 @@
+/*
+  ssbProfile.cpp - An object to time named sections of a patch loop using
+    Timer1. Each section keeps the min, max, mean and count of its run
+    times. Results are reported through ssbDebug (see debugProfile).
+
+  Created by Peter Fawcett, Oct 18. 2026.
+    Version 0.1: Created basic ssbProfile Obect
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#include "ssbProfile.h"
+
+// Timer1 counts per microsecond with a /8 prescale.
+const unsigned int COUNTS_PER_US = F_CPU / 8000000L;
+
+ssbProfile::ssbProfile()
+{
+    reset();
+}
+
+ssbProfile::~ssbProfile(){/*nothing to destruct*/}
+
+/* begin
+ - Start Timer1 free running (normal mode, /8 prescale, no interrupts).
+*/
+void ssbProfile::begin()
+{
+    TCCR1A = 0;
+    TCCR1B = _BV(CS11);
+    TIMSK1 = 0;
+}
+
+/* reset
+ - Clear all section statistics.
+*/
+void ssbProfile::reset()
+{
+    for (byte i = 0; i < PROF_SECTIONS; i++)
+    {
+        _start[i] = 0;
+        _min[i] = 0xFFFF;
+        _max[i] = 0;
+        _total[i] = 0;
+        _count[i] = 0;
+    }
+}
+
+unsigned int ssbProfile::getMin(byte section)
+{
+    if (_count[section] == 0)
+    {
+        return 0;
+    }
+    return _min[section] / COUNTS_PER_US;
+}
+
+unsigned int ssbProfile::getMax(byte section)
+{
+    return _max[section] / COUNTS_PER_US;
+}
+
+unsigned int ssbProfile::getMean(byte section)
+{
+    if (_count[section] == 0)
+    {
+        return 0;
+    }
+    return (_total[section] / _count[section]) / COUNTS_PER_US;
+}
+
+unsigned int ssbProfile::getCount(byte section)
+{
+    return _count[section];
+}
+
+const char* ssbProfile::getSectionName(byte section)
+{
+    switch (section)
+    {
+        case PROF_CTL_SCAN:
+            return "Ctl Scan";
+        case PROF_SERIAL:
+            return "Serial";
+        case PROF_ENVELOPE:
+            return "Envelope";
+        case PROF_GATE:
+            return "Gate";
+        case PROF_DAC:
+            return "DAC";
+    }
+    return "User";
+}
+
+// Private methods
+
+void ssbProfile::_record(byte section, unsigned int counts)
+{
+    if (_count[section] == 0xFFFF)
+    {
+        // Start over rather than let the mean drift.
+        _total[section] = 0;
+        _count[section] = 0;
+    }
+    if (counts < _min[section])
+    {
+        _min[section] = counts;
+    }
+    if (counts > _max[section])
+    {
+        _max[section] = counts;
+    }
+    _total[section] += counts;
+    _count[section]++;
+}
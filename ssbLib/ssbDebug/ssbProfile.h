@@ -0,0 +1,107 @@
+/*
+  ssbProfile.h - An object to time named sections of a patch loop using
+    Timer1. Each section keeps the min, max, mean and count of its run
+    times. Results are reported through ssbDebug (see debugProfile).
+    Timer1 is set to free run with a /8 prescale, so one count is 0.5us
+    (at 16MHz) and a section may be up to 32ms long. Do not use with
+    anything else that uses Timer1 (Servo, ssbOscillator, ...).
+
+    Use the SSB_PROFILE_BEGIN / SSB_PROFILE_END macros in the patch. Unless
+    SSB_PROFILE is defined before ssbDebug.h (or ssbProfile.h) is included,
+    they compile to nothing:
+
+        //#define SSB_PROFILE
+        #include <ssbDebug.h>
+        ...
+        SSB_PROFILE_BEGIN(PROFILE, PROF_DAC);
+        dacOutput(value);
+        SSB_PROFILE_END(PROFILE, PROF_DAC);
+
+  Created by Peter Fawcett, Oct 18. 2026.
+    Version 0.1: Created basic ssbProfile Obect
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#ifndef _ssb_profile_class_
+#define _ssb_profile_class_
+
+#include <Arduino.h>
+
+// ============================================================================
+// Profile Sections:
+// ============================================================================
+const byte    PROF_CTL_SCAN         = 0;    // Reading knobs / CV.
+const byte    PROF_SERIAL           = 1;    // Serial input parsing.
+const byte    PROF_ENVELOPE         = 2;    // Envelope (or other signal) math.
+const byte    PROF_GATE             = 3;    // Gate updates.
+const byte    PROF_DAC              = 4;    // DAC / expander writes.
+const byte    PROF_USER_1           = 5;    // Free for the patch to use.
+const byte    PROF_USER_2           = 6;
+const byte    PROF_USER_3           = 7;
+const byte    PROF_SECTIONS         = 8;
+
+#ifdef SSB_PROFILE
+#define SSB_PROFILE_BEGIN(profile, section)     (profile).sectionBegin(section)
+#define SSB_PROFILE_END(profile, section)       (profile).sectionEnd(section)
+#else
+#define SSB_PROFILE_BEGIN(profile, section)
+#define SSB_PROFILE_END(profile, section)
+#endif
+
+class ssbProfile
+{
+    private:
+        unsigned int    _start[PROF_SECTIONS];  // Timer1 count at section begin.
+        unsigned int    _min[PROF_SECTIONS];    // Shortest run (counts).
+        unsigned int    _max[PROF_SECTIONS];    // Longest run (counts).
+        unsigned long   _total[PROF_SECTIONS];  // Sum of all runs (counts).
+        unsigned int    _count[PROF_SECTIONS];  // Number of runs.
+    public:
+        // Constructors
+        ssbProfile();
+        // Destructor
+        ~ssbProfile();
+
+        // - Start Timer1 free running. Call in setup.
+        void begin();
+        // - Clear all section statistics.
+        void reset();
+
+        // Section markers. Keep these inline so the marker cost is a
+        // register read and a store.
+        inline void sectionBegin(byte section)
+        {
+            _start[section] = TCNT1;
+        }
+        inline void sectionEnd(byte section)
+        {
+            _record(section, TCNT1 - _start[section]);
+        }
+
+        // Section statistics, in microseconds.
+        unsigned int getMin(byte section);
+        unsigned int getMax(byte section);
+        unsigned int getMean(byte section);
+        // Number of times the section has run.
+        unsigned int getCount(byte section);
+        // Name of the section for reports.
+        const char* getSectionName(byte section);
+    private:
+        void _record(byte section, unsigned int counts);
+};
+
+#endif // _ssb_profile_class_
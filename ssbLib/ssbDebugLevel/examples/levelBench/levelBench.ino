@@ -0,0 +1,152 @@
+/*
+Program: levelBench
+Description:
+    Measures what the debug calls of a loop cost on the ArdCore in CPU
+    cycles, at the debug level set below. Build and run it once per level
+    (OFF, ERROR, INFO, VERBOSE): calls above the level are compiled out and
+    should read 0 cycles. The flash each level adds to the patches comes
+    from the build, see hostTest/sizeReport.
+
+    The calls are timed between prints (the debug object only prints once
+    a minute, a result that takes in the print reads high), as that is
+    what they cost on almost every loop. Timer1 runs free with no prescale
+    (one count a cycle at 16MHz), each test is timed over BENCH_CALLS calls
+    with interrupts off, BENCH_REPS times, and the cost of the timing loop
+    (the empty test) is taken off. A compiled out test can read a cycle
+    under the empty one (a different branch of the switch), that is 0.
+
+    Open the serial monitor at 9600. The results repeat every 2 seconds:
+        level: 3
+        empty: 0 cycles
+        error value: ...
+        info value: ...
+        verbose value: ...
+        updateTicks: ...
+        loop (all): ...
+
+    Uses Timer1, do not use with anything else that does (ssbProfile,
+    ssbTrigQueue, ssbOscillator, Servo).
+
+    Created:  Oct 18 2026 by Peter Fawcett (SoundSweepsBy).
+
+    ============================================================
+
+    License:
+
+    This software is licensed under the Creative Commons
+    "Attribution-NonCommercial license. This license allows you
+    to tweak and build upon the code for non-commercial purposes,
+    without the requirement to license derivative works on the
+    same terms. If you wish to use this (or derived) work for
+    commercial work, please contact Peter Fawcett at our website
+    (www.SoundSweepsBy.com).
+
+    For more information on the Creative Commons CC BY-NC license,
+    visit http://creativecommons.org/licenses/
+*/
+
+// Set to SSB_LEVEL_OFF, SSB_LEVEL_ERROR, SSB_LEVEL_INFO or SSB_LEVEL_VERBOSE.
+#define SSB_DEBUG_LEVEL SSB_LEVEL_VERBOSE
+#include <ssbDebugLevel.h>
+
+const byte    BENCH_CALLS       = 16;   // Calls timed at once (fits in 16 bits).
+const int     BENCH_REPS        = 64;   // Timed runs of each test.
+
+const byte    BENCH_EMPTY       = 0;
+const byte    BENCH_ERROR       = 1;
+const byte    BENCH_INFO        = 2;
+const byte    BENCH_VERBOSE     = 3;
+const byte    BENCH_TICKS       = 4;
+const byte    BENCH_LOOP        = 5;
+const byte    BENCH_TESTS       = 6;
+
+const char*   BENCH_NAMES[BENCH_TESTS] = {"empty", "error value", "info value",
+                                          "verbose value", "updateTicks",
+                                          "loop (all)"};
+
+// Prints once a minute (ms mode), so the calls are timed between prints.
+SSB_DEBUG(ssbDebug    DEBUG     = ssbDebug(60000, true);)
+volatile int  value             = 512;  // volatile, so it is not folded in.
+volatile int  sink              = 0;    // Results go here, so no call is dropped.
+
+void setup()
+{
+    Serial.begin(9600);
+    SSB_DEBUG(DEBUG.debugState(true));
+    // Timer1 free running, no prescale.
+    TCCR1A = 0;
+    TCCR1B = _BV(CS10);
+    TIMSK1 = 0;
+}
+
+void loop()
+{
+    unsigned long empty = benchCycles(BENCH_EMPTY);
+    Serial.print("level: ");
+    Serial.println(SSB_DEBUG_LEVEL);
+    for (byte test = 0; test < BENCH_TESTS; test++)
+    {
+        unsigned long total = benchCycles(test);
+        if (total < empty)
+        {
+            total = empty;
+        }
+        Serial.print(BENCH_NAMES[test]);
+        Serial.print(": ");
+        Serial.print((total - empty) / ((unsigned long)BENCH_CALLS * BENCH_REPS));
+        Serial.println(" cycles");
+    }
+    Serial.println();
+    delay(2000);
+}
+
+/* runTest
+ - One call of a test. Not inlined, so each test pays the same call and
+   switch, which the empty test measures.
+*/
+int __attribute__ ((noinline)) runTest(byte test)
+{
+    switch (test)
+    {
+        case BENCH_ERROR:
+            SSB_DEBUG_ERROR(DEBUG.debugValue("Error:", value));
+            return 0;
+        case BENCH_INFO:
+            SSB_DEBUG_INFO(DEBUG.debugValue("Step:", value));
+            return 0;
+        case BENCH_VERBOSE:
+            SSB_DEBUG_VERBOSE(DEBUG.debugValue("A0:", value));
+            return 0;
+        case BENCH_TICKS:
+            SSB_DEBUG(DEBUG.updateTicks());
+            return 0;
+        case BENCH_LOOP:
+            SSB_DEBUG_ERROR(DEBUG.debugValue("Error:", value));
+            SSB_DEBUG_INFO(DEBUG.debugValue("Step:", value));
+            SSB_DEBUG_VERBOSE(DEBUG.debugValue("A0:", value));
+            SSB_DEBUG(DEBUG.updateTicks());
+            return 0;
+        default:
+            return 0;
+    }
+}
+
+unsigned long benchCycles(byte test)
+{
+    unsigned long total = 0;
+    for (int rep = 0; rep < BENCH_REPS; rep++)
+    {
+        unsigned int start;
+        unsigned int end;
+        noInterrupts();
+        start = TCNT1;
+        for (byte i = 0; i < BENCH_CALLS; i++)
+        {
+            sink += runTest(test);
+        }
+        end = TCNT1;
+        interrupts();
+        total += (unsigned int)(end - start);
+    }
+    return total;
+}
@@ -0,0 +1,88 @@
+/*
+  ssbDebugLevel.h - Compile time debug levels for ssbDebug.
+    Debug calls are wrapped in a level macro. Calls above the level set by
+    the sketch compile to nothing (the call, its arguments and any string
+    literals). With the level at SSB_LEVEL_OFF ssbDebug is not included at
+    all, so Serial and the debug object cost no flash or SRAM.
+
+    Set the level before including this header:
+
+        #define SSB_DEBUG_LEVEL SSB_LEVEL_INFO
+        #include <ssbDebugLevel.h>
+        ...
+        SSB_DEBUG(ssbDebug DEBUG = ssbDebug();)
+        ...
+        SSB_DEBUG(DEBUG.enableSerial());
+        SSB_DEBUG(DEBUG.debugState(true));
+        ...
+        SSB_DEBUG_INFO(DEBUG.debugValue("Step:", step));
+        SSB_DEBUG_VERBOSE(DEBUG.debugCtl("A0:", A0_INPUT));
+        SSB_DEBUG(DEBUG.updateTicks());
+
+    SSB_DEBUG is for anything needed whenever ssbDebug is in use (the debug
+    object, setup and updateTicks). ssbDebug is also included when
+    SSB_PROFILE is defined (see ssbProfile.h), otherwise the profile
+    markers compile to nothing here.
+
+  Created by Peter Fawcett, Oct 18. 2026.
+    Version 0.1: Created basic ssbDebugLevel macros
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#ifndef _ssb_debug_level_
+#define _ssb_debug_level_
+
+// ============================================================================
+// Debug Levels:
+// ============================================================================
+#define SSB_LEVEL_OFF           0   // No debugging. ssbDebug is not included.
+#define SSB_LEVEL_ERROR         1   // Errors only.
+#define SSB_LEVEL_INFO          2   // Errors and general state.
+#define SSB_LEVEL_VERBOSE       3   // Everything, including per loop values.
+
+#ifndef SSB_DEBUG_LEVEL
+#define SSB_DEBUG_LEVEL         SSB_LEVEL_OFF
+#endif
+
+#if (SSB_DEBUG_LEVEL > SSB_LEVEL_OFF) || defined(SSB_PROFILE)
+#include <ssbDebug.h>
+#define SSB_DEBUG(...)          __VA_ARGS__
+#else
+#define SSB_DEBUG(...)
+#define SSB_PROFILE_BEGIN(profile, section)
+#define SSB_PROFILE_END(profile, section)
+#endif
+
+#if SSB_DEBUG_LEVEL >= SSB_LEVEL_ERROR
+#define SSB_DEBUG_ERROR(...)    __VA_ARGS__
+#else
+#define SSB_DEBUG_ERROR(...)
+#endif
+
+#if SSB_DEBUG_LEVEL >= SSB_LEVEL_INFO
+#define SSB_DEBUG_INFO(...)     __VA_ARGS__
+#else
+#define SSB_DEBUG_INFO(...)
+#endif
+
+#if SSB_DEBUG_LEVEL >= SSB_LEVEL_VERBOSE
+#define SSB_DEBUG_VERBOSE(...)  __VA_ARGS__
+#else
+#define SSB_DEBUG_VERBOSE(...)
+#endif
+
+#endif // _ssb_debug_level_
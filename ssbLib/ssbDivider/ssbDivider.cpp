@@ -0,0 +1,139 @@
+/*
+  ssbDivider.cpp - A bank of clock dividers for ArdCore patches.
+
+  Created by Peter Fawcett, Oct 18. 2026.
+    Version 0.1: Created basic ssbDivider Obect
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#include "ssbDivider.h"
+
+// Constructors
+
+ssbDivider::ssbDivider()
+{
+    _outputs = DIV_MAX_OUTPUTS;
+    for (byte i = 0; i < DIV_MAX_OUTPUTS; i++)
+    {
+        _ratio[i] = 1;
+    }
+    reset();
+}
+
+ssbDivider::ssbDivider(byte outputs)
+{
+    _outputs = constrain(outputs, 1, DIV_MAX_OUTPUTS);
+    for (byte i = 0; i < DIV_MAX_OUTPUTS; i++)
+    {
+        _ratio[i] = 1;
+    }
+    reset();
+}
+
+// Destructor
+
+ssbDivider::~ssbDivider(){/*nothing to destruct*/}
+
+// Divider Methods
+
+/* setRatio
+ - Keep the position in the cycle. The modulo is only done when the
+   ratio changes and the position is past the new end.
+*/
+void ssbDivider::setRatio(byte output, unsigned int ratio)
+{
+    unsigned int pos;
+    if (output >= _outputs)
+    {
+        return;
+    }
+    if (ratio == 0)
+    {
+        ratio = 1;
+    }
+    if (ratio == _ratio[output])
+    {
+        return;
+    }
+    pos = _ratio[output] - _count[output];
+    if (pos >= ratio)
+    {
+        pos = pos % ratio;
+    }
+    _ratio[output] = ratio;
+    _count[output] = ratio - pos;
+}
+
+unsigned int ssbDivider::getRatio(byte output)
+{
+    if (output >= _outputs)
+    {
+        return 1;
+    }
+    return _ratio[output];
+}
+
+/* clock
+ - Decrement and compare for each output.
+*/
+void ssbDivider::clock()
+{
+    unsigned int bit = 1;
+    _wraps = 0;
+    for (byte i = 0; i < _outputs; i++)
+    {
+        _count[i]--;
+        if (_count[i] == 0)
+        {
+            _count[i] = _ratio[i];
+            _wraps |= bit;
+        }
+        bit <<= 1;
+    }
+}
+
+bool ssbDivider::isWrap(byte output)
+{
+    if (output >= _outputs)
+    {
+        return false;
+    }
+    return ((_wraps & (1U << output)) != 0);
+}
+
+unsigned int ssbDivider::getWraps()
+{
+    return _wraps;
+}
+
+unsigned int ssbDivider::getPosition(byte output)
+{
+    if (output >= _outputs)
+    {
+        return 0;
+    }
+    return _ratio[output] - _count[output];
+}
+
+void ssbDivider::reset()
+{
+    for (byte i = 0; i < DIV_MAX_OUTPUTS; i++)
+    {
+        _count[i] = _ratio[i];
+    }
+    _wraps = 0;
+}
@@ -0,0 +1,72 @@
+/*
+  ssbDivider.h - A bank of clock dividers for ArdCore patches.
+    One countdown counter per output (up to DIV_MAX_OUTPUTS). Each clock
+    pulse counts every output down by one, and an output wraps (fires)
+    when its count reaches 0, then reloads its ratio. So a divide, skip
+    or pattern position is a decrement and a compare, not a modulo of an
+    ever growing step count (a software divide on the AVR).
+
+    Changing a ratio keeps the phase: the position in the cycle is kept
+    (and folded into the new ratio if it is past the end).
+
+  Created by Peter Fawcett, Oct 18. 2026.
+    Version 0.1: Created basic ssbDivider Obect
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#ifndef _ssb_divider_class_
+#define _ssb_divider_class_
+
+#include <Arduino.h>
+
+// ============================================================================
+// Divider Constants:
+// ============================================================================
+const byte    DIV_MAX_OUTPUTS       = 16;
+
+class ssbDivider
+{
+    private:
+        unsigned int    _ratio[DIV_MAX_OUTPUTS];    // Pulses per wrap (1 - 65535).
+        unsigned int    _count[DIV_MAX_OUTPUTS];    // Pulses to the next wrap.
+        unsigned int    _wraps;                     // Bit per output, set if it wrapped on the last clock.
+        byte            _outputs;                   // Outputs in use.
+    public:
+        // Constructors
+        ssbDivider();
+        ssbDivider(byte outputs);
+        // Destructor
+        ~ssbDivider();
+
+        // - Set the ratio of an output (pulses per wrap, 0 is taken as 1).
+        //   The position in the cycle is kept.
+        void setRatio(byte output, unsigned int ratio);
+        unsigned int getRatio(byte output);
+        // - Count every output down one pulse. Call on a clock edge.
+        void clock();
+        // - Did the output wrap on the last clock (every ratio pulses).
+        bool isWrap(byte output);
+        // - Wrap bits of all the outputs (bit 0 is output 0).
+        unsigned int getWraps();
+        // - Position in the cycle: 0 on a wrap, 1 on the pulse after it, up
+        //   to ratio - 1.
+        unsigned int getPosition(byte output);
+        // - Start all outputs at position 0.
+        void reset();
+};
+
+#endif // _ssb_divider_class_
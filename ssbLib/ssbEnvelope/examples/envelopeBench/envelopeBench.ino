@@ -0,0 +1,174 @@
+/*
+Program: envelopeBench
+Description:
+    Measures the cost of ssbEnvelope on the ArdCore in CPU cycles, against
+    the float envelope code the ssbMonoADSR patches used before it (three
+    map_float calls, the sustain math and a stage step every loop). Timer1
+    runs free with no prescale (one count a cycle at 16MHz), each test is
+    timed over BENCH_CALLS calls with interrupts off, BENCH_REPS times, and
+    the cost of the timing loop (the empty test) is taken off.
+
+    Open the serial monitor at 9600. The results repeat every 2 seconds:
+        empty: 0 cycles
+        map_float: ...
+        float loop: ...
+        setAttack (same): ...
+        setAttack (new): ...
+        updateState: ...
+        ssbEnvelope loop: ...
+
+    The host build (hostTest/envelopeBench) checks both give the same
+    envelope shape.
+
+    Uses Timer1, do not use with anything else that does (ssbProfile,
+    ssbTrigQueue, ssbOscillator, Servo).
+
+    Created:  Oct 18 2026 by Peter Fawcett (SoundSweepsBy).
+
+    ============================================================
+
+    License:
+
+    This software is licensed under the Creative Commons
+    "Attribution-NonCommercial license. This license allows you
+    to tweak and build upon the code for non-commercial purposes,
+    without the requirement to license derivative works on the
+    same terms. If you wish to use this (or derived) work for
+    commercial work, please contact Peter Fawcett at our website
+    (www.SoundSweepsBy.com).
+
+    For more information on the Creative Commons CC BY-NC license,
+    visit http://creativecommons.org/licenses/
+*/
+
+#include <ssbEnvelope.h>
+
+const byte    BENCH_CALLS       = 8;    // Calls timed at once (a float loop x 8 fits in 16 bits).
+const int     BENCH_REPS        = 64;   // Timed runs of each test.
+
+const byte    BENCH_EMPTY       = 0;
+const byte    BENCH_MAP_FLOAT   = 1;
+const byte    BENCH_FLOAT_LOOP  = 2;
+const byte    BENCH_SET_SAME    = 3;
+const byte    BENCH_SET_NEW     = 4;
+const byte    BENCH_UPDATE      = 5;
+const byte    BENCH_FIXED_LOOP  = 6;
+const byte    BENCH_TESTS       = 7;
+
+const char*   BENCH_NAMES[BENCH_TESTS] = {"empty", "map_float", "float loop",
+                                          "setAttack (same)", "setAttack (new)",
+                                          "updateState", "ssbEnvelope loop"};
+
+const int     ENVELOPE_MAX      = 1023;
+
+ssbEnvelope   env               = ssbEnvelope();
+float         envelopeVal       = 0.0;
+volatile int  knob              = 300;  // volatile, so it is not folded in.
+volatile int  sink              = 0;    // Results go here, so no call is dropped.
+
+void setup()
+{
+    Serial.begin(9600);
+    env.setGate(true);
+    // Timer1 free running, no prescale.
+    TCCR1A = 0;
+    TCCR1B = _BV(CS10);
+    TIMSK1 = 0;
+}
+
+void loop()
+{
+    unsigned long empty = benchCycles(BENCH_EMPTY);
+    for (byte test = 0; test < BENCH_TESTS; test++)
+    {
+        unsigned long total = benchCycles(test);
+        if (total < empty)
+        {
+            total = empty;
+        }
+        Serial.print(BENCH_NAMES[test]);
+        Serial.print(": ");
+        Serial.print((total - empty) / ((unsigned long)BENCH_CALLS * BENCH_REPS));
+        Serial.println(" cycles");
+    }
+    Serial.println();
+    delay(2000);
+}
+
+// The float code from ssbMonoADSR.
+float map_float(float x, float in_min, float in_max, float out_min, float out_max)
+{
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+float do_attack_inc(float envelopeVal, float attackValue)
+{
+    envelopeVal = (envelopeVal + attackValue); //step up to full level
+    if (envelopeVal >= ENVELOPE_MAX)
+    {
+        envelopeVal = 0;                // Wrap, so every call is an attack step.
+    }
+    return envelopeVal;
+}
+
+/* runTest
+ - One call of a test. Not inlined, so each test pays the same call and
+   switch, which the empty test measures.
+*/
+int __attribute__ ((noinline)) runTest(byte test)
+{
+    float attackValue;
+    float decayValue;
+    float releaseValue;
+    float sustainValue;
+    switch (test)
+    {
+        case BENCH_MAP_FLOAT:
+            return (int)map_float(knob, 0, 1023, 204.6, .5);
+        case BENCH_FLOAT_LOOP:
+            // The per loop envelope work of the patch (in attack).
+            attackValue = map_float(knob, 0, 1023, 204.6, .5);
+            decayValue = map_float(knob, 0, 1023, 204.6, .5);
+            sustainValue = (int)(ENVELOPE_MAX * (float)(70 / 100.0));
+            releaseValue = map_float(knob, 0, 1023, 204.6, .5);
+            envelopeVal = do_attack_inc(envelopeVal, attackValue);
+            return (int)(envelopeVal + decayValue + releaseValue + sustainValue);
+        case BENCH_SET_SAME:
+            env.setAttack(knob);
+            return 0;
+        case BENCH_SET_NEW:
+            env.setAttack(knob + (sink & 1));
+            return 0;
+        case BENCH_UPDATE:
+            return env.updateState();
+        case BENCH_FIXED_LOOP:
+            // The per loop envelope work with ssbEnvelope, knobs steady.
+            env.setAttack(knob);
+            env.setDecay(knob);
+            env.setSustain(716);
+            env.setRelease(knob);
+            return env.updateState();
+        default:
+            return 0;
+    }
+}
+
+unsigned long benchCycles(byte test)
+{
+    unsigned long total = 0;
+    for (int rep = 0; rep < BENCH_REPS; rep++)
+    {
+        unsigned int start;
+        unsigned int end;
+        noInterrupts();
+        start = TCNT1;
+        for (byte i = 0; i < BENCH_CALLS; i++)
+        {
+            sink += runTest(test);
+        }
+        end = TCNT1;
+        interrupts();
+        total += (unsigned int)(end - start);
+    }
+    return total;
+}
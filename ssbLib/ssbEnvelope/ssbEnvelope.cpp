@@ -0,0 +1,432 @@
+/*
+  ssbEnvelope.cpp - A fixed point ADSR envelope for ArdCore patches.
+
+  Created by Peter Fawcett, Oct 18. 2026.
+    Version 0.1: Created basic ssbEnvelope Obect
+    Version 0.2: Oct 18. 2026
+                    Fixed the rate math overflow.
+    Version 0.3: Oct 18. 2026
+                    Stage times in ms, advanced by elapsed micros.
+    Version 0.4: Oct 18. 2026
+                    Added per stage curves.
+    Version 0.5: Oct 18. 2026
+                    Curve span follows a sustain or peak change mid stage.
+    Version 0.6: Oct 18. 2026
+                    Added velocity curves.
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#include "ssbEnvelope.h"
+#include "ssbEnvelopeCurves.h"
+
+// Constructors
+
+ssbEnvelope::ssbEnvelope()
+{
+    _peak_level = ENV_MAX;
+    _attack_ctl = -1;           // -1 forces the first set to calculate.
+    _decay_ctl = -1;
+    _sustain_ctl = ENV_CTL_MAX;
+    _release_ctl = -1;
+    setAttackTime(ENV_TIME_MAX_MS);
+    setDecayTime(ENV_TIME_MAX_MS);
+    setReleaseTime(ENV_TIME_MAX_MS);
+    _calc_sustain();
+    for (byte i = 0; i < 4; i++)
+    {
+        _curve[i] = ENV_CURVE_LINEAR;
+    }
+    _vel_curve = ENV_VELOCITY_LINEAR;
+    _velocity = ENV_VELOCITY_MAX;
+    _last_us = 0;
+    reset();
+}
+
+ssbEnvelope::ssbEnvelope(int peak)
+{
+    _peak_level = constrain(peak, 0, ENV_MAX);
+    _attack_ctl = -1;           // -1 forces the first set to calculate.
+    _decay_ctl = -1;
+    _sustain_ctl = ENV_CTL_MAX;
+    _release_ctl = -1;
+    setAttackTime(ENV_TIME_MAX_MS);
+    setDecayTime(ENV_TIME_MAX_MS);
+    setReleaseTime(ENV_TIME_MAX_MS);
+    _calc_sustain();
+    for (byte i = 0; i < 4; i++)
+    {
+        _curve[i] = ENV_CURVE_LINEAR;
+    }
+    _vel_curve = ENV_VELOCITY_LINEAR;
+    _velocity = ENV_VELOCITY_MAX;
+    _last_us = 0;
+    reset();
+}
+
+// Destructor
+
+ssbEnvelope::~ssbEnvelope(){/*nothing to destruct*/}
+
+// Envelope Methods
+
+void ssbEnvelope::setAttack(int ctl)
+{
+    if (ctl != _attack_ctl)
+    {
+        _attack_ctl = ctl;
+        setAttackTime(_ctl_to_ms(ctl));
+    }
+}
+
+void ssbEnvelope::setDecay(int ctl)
+{
+    if (ctl != _decay_ctl)
+    {
+        _decay_ctl = ctl;
+        setDecayTime(_ctl_to_ms(ctl));
+    }
+}
+
+void ssbEnvelope::setRelease(int ctl)
+{
+    if (ctl != _release_ctl)
+    {
+        _release_ctl = ctl;
+        setReleaseTime(_ctl_to_ms(ctl));
+    }
+}
+
+void ssbEnvelope::setAttackTime(unsigned int ms)
+{
+    _attack_us = (unsigned long)max(ms, 1) * 1000;
+    _attack_rate = ENV_FULL / _attack_us;
+}
+
+void ssbEnvelope::setDecayTime(unsigned int ms)
+{
+    _decay_us = (unsigned long)max(ms, 1) * 1000;
+    _decay_rate = ENV_FULL / _decay_us;
+}
+
+void ssbEnvelope::setReleaseTime(unsigned int ms)
+{
+    _release_us = (unsigned long)max(ms, 1) * 1000;
+    _release_rate = ENV_FULL / _release_us;
+}
+
+void ssbEnvelope::setSustain(int ctl)
+{
+    if (ctl != _sustain_ctl)
+    {
+        _sustain_ctl = ctl;
+        _calc_sustain();
+        _calc_span();
+    }
+}
+
+void ssbEnvelope::setPeak(int level)
+{
+    if (level != _peak_level)
+    {
+        _peak_level = constrain(level, 0, ENV_MAX);
+        _calc_sustain();
+        _calc_span();
+    }
+}
+
+void ssbEnvelope::setCurve(byte stage, byte curve)
+{
+    if (stage < 4)
+    {
+        _curve[stage] = curve;
+    }
+}
+
+void ssbEnvelope::setVelocityCurve(byte curve)
+{
+    if (curve != _vel_curve)
+    {
+        _vel_curve = curve;
+        setVelocity(_velocity);
+    }
+}
+
+/* setVelocity
+ - Look up the peak for a velocity in the velocity curve table.
+*/
+void ssbEnvelope::setVelocity(byte velocity)
+{
+    const unsigned int* table;
+    _velocity = min(velocity, ENV_VELOCITY_MAX);
+    switch (_vel_curve)
+    {
+        case ENV_VELOCITY_FIXED:
+            setPeak(ENV_MAX);
+            return;
+        case ENV_VELOCITY_SOFT:
+            table = ENV_VEL_SOFT_TABLE;
+            break;
+        case ENV_VELOCITY_HARD:
+            table = ENV_VEL_HARD_TABLE;
+            break;
+        default:
+            table = ENV_VEL_LINEAR_TABLE;
+            break;
+    }
+    setPeak((int)pgm_read_word(&table[_velocity]));
+}
+
+/* setGate
+ - Set the gate. Gate off moves to release from any state. Gate on in
+   release restarts the attack from the current value (no jump to 0 or to
+   the sustain level).
+*/
+void ssbEnvelope::setGate(bool is_on)
+{
+    if (is_on == _gate)
+    {
+        return;
+    }
+    _gate = is_on;
+    if (_gate == true)
+    {
+        _start_stage(ENV_ATTACK);
+    }
+    else
+    {
+        _start_stage(ENV_RELEASE);
+    }
+}
+
+/* updateState
+ - Advance the envelope by the time since the last call. Call once per loop.
+*/
+int ssbEnvelope::updateState()
+{
+    return updateState(micros());
+}
+
+int ssbEnvelope::updateState(unsigned long now_us)
+{
+    unsigned long elapsed = now_us - _last_us;
+    _last_us = now_us;
+    switch (_state)
+    {
+        case ENV_ATTACK:
+            if (_gate == false)
+            {
+                // Waiting for a gate.
+                break;
+            }
+            _value += _step(_attack_rate, _attack_us, elapsed);
+            if (_value >= _peak)
+            {
+                _value = _peak;
+                _out = _peak_level;
+                _start_stage(ENV_DECAY);
+            }
+            break;
+        case ENV_DECAY:
+            _value -= _step(_decay_rate, _decay_us, elapsed);
+            if (_value <= _sustain)
+            {
+                _value = _sustain;
+                _state = ENV_SUSTAIN;
+            }
+            break;
+        case ENV_SUSTAIN:
+            // Follow the sustain level (knob / CV).
+            _value = _sustain;
+            break;
+        case ENV_RELEASE:
+            _value -= _step(_release_rate, _release_us, elapsed);
+            if (_value <= 0)
+            {
+                reset();
+            }
+            break;
+    }
+    _out = _curve_value();
+    return _out;
+}
+
+int ssbEnvelope::getValue()
+{
+    return _out;
+}
+
+byte ssbEnvelope::getState()
+{
+    return _state;
+}
+
+void ssbEnvelope::reset()
+{
+    _out = 0;
+    _gate = false;
+    _start_stage(ENV_ATTACK);
+}
+
+// Private methods
+
+/* _ctl_to_ms
+ - Map a control value to a stage time. Squared curve, 0 -> 2ms,
+   1023 -> 5s. The square is taken >> 4 to keep the math in 32 bits.
+*/
+unsigned int ssbEnvelope::_ctl_to_ms(int ctl)
+{
+    const unsigned long CTL_SQ_MAX = ((unsigned long)ENV_CTL_MAX * ENV_CTL_MAX) >> 4;
+    unsigned long ctl_sq;
+    ctl = constrain(ctl, 0, ENV_CTL_MAX);
+    ctl_sq = ((unsigned long)ctl * ctl) >> 4;
+    return ENV_TIME_MIN_MS + (unsigned int)((ctl_sq * (ENV_TIME_MAX_MS - ENV_TIME_MIN_MS)) / CTL_SQ_MAX);
+}
+
+/* _step
+ - Amount to move for the elapsed time. A gap longer than the whole stage
+   (first update, a long stall) is a full scale move, which also keeps
+   rate * elapsed in range.
+*/
+long ssbEnvelope::_step(long rate, unsigned long stage_us, unsigned long elapsed_us)
+{
+    if (elapsed_us >= stage_us)
+    {
+        return ENV_FULL;
+    }
+    return rate * (long)elapsed_us;
+}
+
+void ssbEnvelope::_calc_sustain()
+{
+    _peak = (long)_peak_level << ENV_SHIFT;
+    _sustain = (((long)_peak_level * _sustain_ctl) / ENV_CTL_MAX) << ENV_SHIFT;
+}
+
+/* _start_stage
+ - Start a stage from the current output level. The linear value restarts
+   at the output level, so a stage cut short (gate on in release, gate off
+   in attack) carries on from where the curve was.
+*/
+void ssbEnvelope::_start_stage(byte state)
+{
+    _state = state;
+    _value = (long)_out << ENV_SHIFT;
+    _stage_from = _value;
+    _out_from = _out;
+    _calc_span();
+}
+
+/* _calc_span
+ - Output target and span of the current stage. The span is measured here
+   so the progress through the stage is a multiply, not a divide. Called
+   at the start of a stage and again when the peak or sustain moves, as
+   _step chases the live level and the curve has to end on it too.
+*/
+void ssbEnvelope::_calc_span()
+{
+    switch (_state)
+    {
+        case ENV_ATTACK:
+            _out_to = _peak_level;
+            break;
+        case ENV_DECAY:
+            _out_to = (int)(_sustain >> ENV_SHIFT);
+            break;
+        case ENV_RELEASE:
+            _out_to = 0;
+            break;
+        default:
+            _out_to = _out_from;
+            break;
+    }
+    _span = (unsigned long)abs(_out_to - _out_from) << 10;
+    if (_span == 0)
+    {
+        _span_inv = 0;
+    }
+    else
+    {
+        _span_inv = 0x80000000UL / _span;
+    }
+}
+
+/* _curve_value
+ - Output for the current linear value and the curve of the stage.
+*/
+int ssbEnvelope::_curve_value()
+{
+    unsigned long progress;
+    unsigned int x;
+    if (_state == ENV_SUSTAIN)
+    {
+        return (int)(_sustain >> ENV_SHIFT);
+    }
+    if ((_curve[_state] == ENV_CURVE_LINEAR) || (_span_inv == 0))
+    {
+        return (int)(_value >> ENV_SHIFT);
+    }
+    // Stage progress 0 - 65535 from the linear value. Clamped to the span
+    // first, the value can pass the target for a loop (or the target can
+    // move back) and span * _span_inv is the most that fits in 32 bits.
+    progress = (unsigned long)abs(_value - _stage_from) >> 10;
+    if (progress > _span)
+    {
+        progress = _span;
+    }
+    progress = (progress * _span_inv) >> 15;
+    if (progress > 0xFFFF)
+    {
+        progress = 0xFFFF;
+    }
+    x = _curve_lookup(_curve[_state], (unsigned int)progress);
+    return _out_from + (int)(((long)(_out_to - _out_from) * (long)x) >> 16);
+}
+
+/* _curve_lookup
+ - Curve table read with linear interpolation between entries. x and the
+   result are 0 - 65535.
+*/
+unsigned int ssbEnvelope::_curve_lookup(byte curve, unsigned int x)
+{
+    const unsigned int* table;
+    byte index = x >> 8;
+    byte frac = x & 0xFF;
+    unsigned int y0;
+    unsigned int y1;
+    switch (curve)
+    {
+        case ENV_CURVE_EXP:
+            table = ENV_EXP_TABLE;
+            break;
+        case ENV_CURVE_LOG:
+            table = ENV_LOG_TABLE;
+            break;
+        default:
+            table = ENV_S_TABLE;
+            break;
+    }
+    y0 = pgm_read_word(&table[index]);
+    if (index == (ENV_CURVE_SIZE - 1))
+    {
+        y1 = 0xFFFF;
+    }
+    else
+    {
+        y1 = pgm_read_word(&table[index + 1]);
+    }
+    return y0 + (unsigned int)(((unsigned long)(y1 - y0) * frac) >> 8);
+}
@@ -0,0 +1,186 @@
+/*
+  ssbEnvelope.h - A fixed point ADSR envelope for ArdCore patches.
+    Replaces the float envelope code that each of the ssbMonoADSR patches
+    carried. The envelope value is kept in Q20 (value << 20) so no float
+    math is done. The attack, decay and release rates are only
+    recalculated when the control value for them changes, so a loop with
+    steady knobs only multiplies, adds and compares.
+
+    Stage times are real time. Each call to updateState advances the
+    envelope by the time (micros) since the last call, so the envelope
+    length does not change when the loop slows down (serial input, debug
+    output, ...). A stage time is the time for a full scale (0 - 1023)
+    move, so a decay to a sustain level of half is half the decay time.
+    Knob values map to 2ms (0) - 5s (1023) on a squared curve, which gives
+    more of the knob to short times.
+
+    Each stage may be linear (default) or follow a curve (see setCurve).
+    The linear value is used as the progress through the stage, and the
+    output is looked up from a 256 entry flash table with interpolation.
+    A stage starts from the current output level, so changing stage mid
+    curve does not jump.
+
+    setVelocity sets the peak from a MIDI velocity (0 - 127) through a
+    velocity curve (128 entry flash table). The lookup is only done when a
+    velocity arrives, not each loop.
+
+  Created by Peter Fawcett, Oct 18. 2026.
+    Version 0.1: Created basic ssbEnvelope Obect
+    Version 0.2: Oct 18. 2026
+                    Fixed the rate of controls over 160, the rate math
+                    overflowed 32 bits.
+    Version 0.3: Oct 18. 2026
+                    Stage times in ms, envelope advanced by elapsed micros
+                    rather than a fixed amount per loop.
+    Version 0.4: Oct 18. 2026
+                    Added per stage curves (exponential, logarithmic and
+                    s-curve) from flash tables.
+    Version 0.5: Oct 18. 2026
+                    A sustain or peak change mid stage moves the curve
+                    target too, progress is clamped to the stage span.
+    Version 0.6: Oct 18. 2026
+                    Added velocity curves (linear, soft, hard, fixed).
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#ifndef _ssb_envelope_class_
+#define _ssb_envelope_class_
+
+#include <Arduino.h>
+
+// ============================================================================
+// Envelope States:
+// ============================================================================
+const byte    ENV_ATTACK            = 0;    // gate on       -> peak          (or gate off)
+const byte    ENV_DECAY             = 1;    // peak          -> sustain level (or gate off)
+const byte    ENV_SUSTAIN           = 2;    // sustain level -> gate off
+const byte    ENV_RELEASE           = 3;    // gate off      -> 0             (or gate on)
+
+// ============================================================================
+// Envelope Constants:
+// ============================================================================
+const int     ENV_MAX               = 1023;
+const int     ENV_CTL_MAX           = 1023;                     // Max control (knob) value.
+const byte    ENV_SHIFT             = 20;                       // Q20 fixed point.
+const long    ENV_FULL              = (long)ENV_MAX << ENV_SHIFT;
+const unsigned int ENV_TIME_MIN_MS  = 2;                        // Stage time at control 0.
+const unsigned int ENV_TIME_MAX_MS  = 5000;                     // Stage time at control 1023.
+
+// ============================================================================
+// Curves (see ssbEnvelopeCurves.h):
+// ============================================================================
+const byte    ENV_CURVE_LINEAR      = 0;    // Straight ramp.
+const byte    ENV_CURVE_EXP         = 1;    // Slow start, fast finish.
+const byte    ENV_CURVE_LOG         = 2;    // Fast start, slow finish (RC / analog).
+const byte    ENV_CURVE_S           = 3;    // Slow start and finish.
+
+// ============================================================================
+// Velocity Curves (see ssbEnvelopeCurves.h):
+// ============================================================================
+const byte    ENV_VELOCITY_LINEAR   = 0;    // Peak follows velocity.
+const byte    ENV_VELOCITY_SOFT     = 1;    // Loud with a light touch.
+const byte    ENV_VELOCITY_HARD     = 2;    // Needs a hard touch.
+const byte    ENV_VELOCITY_FIXED    = 3;    // Always full peak.
+const byte    ENV_VELOCITY_MAX      = 127;  // Max (MIDI) velocity.
+
+class ssbEnvelope
+{
+    private:
+        long            _value;         // Current linear envelope value (Q20).
+        long            _stage_from;    // Linear value at the start of the stage (Q20).
+        unsigned long   _span;          // Stage span (Q10).
+        unsigned long   _span_inv;      // 2^31 / stage span (Q10), for stage progress.
+        int             _out;           // Current output (0 - 1023), after the curve.
+        int             _out_from;      // Output at the start of the stage.
+        int             _out_to;        // Output target of the stage.
+        byte            _curve[4];      // Curve for each stage (sustain is unused).
+        byte            _vel_curve;     // Velocity curve.
+        byte            _velocity;      // Last velocity (0 - 127).
+        long            _peak;          // Attack peak (Q20).
+        long            _sustain;       // Sustain level (Q20).
+        long            _attack_rate;   // Full scale / attack time (Q20 per us).
+        long            _decay_rate;    // Full scale / decay time (Q20 per us).
+        long            _release_rate;  // Full scale / release time (Q20 per us).
+        unsigned long   _attack_us;     // Stage times (us).
+        unsigned long   _decay_us;
+        unsigned long   _release_us;
+        unsigned long   _last_us;       // micros() at the last update.
+        int             _peak_level;    // Peak level (0 - 1023).
+        int             _attack_ctl;    // Last control values, rates are only
+        int             _decay_ctl;     // recalculated when these change.
+        int             _sustain_ctl;
+        int             _release_ctl;
+        byte            _state;         // Current envelope state.
+        bool            _gate;          // Current gate state.
+    public:
+        // Constructors
+        ssbEnvelope();
+        ssbEnvelope(int peak);
+        // Destructor
+        ~ssbEnvelope();
+
+        // Stage controls. Values are 0 - 1023 (knob / CV). Cheap to call
+        // every loop, the rate is only recalculated on a change.
+        // - Attack, decay and release: 0 is fastest, 1023 is slowest.
+        void setAttack(int ctl);
+        void setDecay(int ctl);
+        void setRelease(int ctl);
+        // - Set a stage time directly, in ms (full scale move).
+        void setAttackTime(unsigned int ms);
+        void setDecayTime(unsigned int ms);
+        void setReleaseTime(unsigned int ms);
+        // - Sustain level as a fraction of the peak (0 - 1023).
+        void setSustain(int ctl);
+        // - Attack peak level (0 - 1023). Used for velocity.
+        void setPeak(int level);
+        // - Set the curve for a stage (ENV_ATTACK, ENV_DECAY, ENV_RELEASE)
+        //   to ENV_CURVE_LINEAR, ENV_CURVE_EXP, ENV_CURVE_LOG or ENV_CURVE_S.
+        void setCurve(byte stage, byte curve);
+        // - Set the velocity curve (ENV_VELOCITY_LINEAR, ENV_VELOCITY_SOFT,
+        //   ENV_VELOCITY_HARD or ENV_VELOCITY_FIXED). Reapplied to the last
+        //   velocity.
+        void setVelocityCurve(byte curve);
+        // - Set the peak from a velocity (0 - 127) through the velocity
+        //   curve. Call when a velocity arrives, not every loop.
+        void setVelocity(byte velocity);
+
+        // - Set the gate. A gate on in release restarts the attack from the
+        //   current value.
+        void setGate(bool is_on);
+        // - Advance the envelope by the time since the last call. Call once
+        //   per loop. Returns the new value (0 - 1023).
+        int updateState();
+        // - As above, with the current time (micros) supplied by the caller.
+        int updateState(unsigned long now_us);
+
+        // - Current value (0 - 1023).
+        int getValue();
+        // - Current state (ENV_ATTACK, ENV_DECAY, ENV_SUSTAIN, ENV_RELEASE).
+        byte getState();
+        // - Drop to 0 and wait for a gate.
+        void reset();
+    private:
+        unsigned int _ctl_to_ms(int ctl);
+        long _step(long rate, unsigned long stage_us, unsigned long elapsed_us);
+        void _start_stage(byte state);
+        void _calc_span();
+        int _curve_value();
+        unsigned int _curve_lookup(byte curve, unsigned int x);
+        void _calc_sustain();
+};
+
+#endif // _ssb_envelope_class_
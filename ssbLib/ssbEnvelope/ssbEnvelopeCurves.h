@@ -0,0 +1,215 @@
+/*
+  ssbEnvelopeCurves.h - Curve tables for ssbEnvelope. Only included by
+    ssbEnvelope.cpp.
+    Each table maps stage progress (0 - 1, as index / 256) to output
+    progress (0 - 65535). The end point (1 -> 65535) is not stored, the
+    last entry interpolates to it. Generated with k = 4.6 (about 40dB from
+    the start of the curve to the end):
+      exponential:  (e^(k*x) - 1) / (e^k - 1)     slow start, fast finish.
+      logarithmic:  1 - exponential(1 - x)        fast start, slow finish.
+      s-curve:      (1 - cos(pi * x)) / 2         slow start and finish.
+    The velocity tables map a MIDI velocity (0 - 127) to a peak level
+    (0 - 1023):
+      linear:       x
+      soft:         1 - (1 - x)^2                 loud with a light touch.
+      hard:         x^2                           needs a hard touch.
+
+  Created by Peter Fawcett, Oct 18. 2026.
+    Version 0.1: Created curve tables
+    Version 0.2: Oct 18. 2026
+                    Added velocity tables.
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#ifndef _ssb_envelope_curves_
+#define _ssb_envelope_curves_
+
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+
+const int     ENV_CURVE_SIZE        = 256;
+const int     ENV_VELOCITY_SIZE     = 128;
+
+// Exponential (ENV_CURVE_EXP).
+const unsigned int ENV_EXP_TABLE[ENV_CURVE_SIZE] PROGMEM = {
+        0,    12,    24,    37,    50,    63,    76,    89,
+      103,   117,   131,   145,   160,   175,   190,   206,
+      222,   238,   254,   271,   288,   305,   323,   341,
+      359,   377,   396,   416,   435,   455,   475,   496,
+      517,   539,   560,   583,   605,   628,   652,   676,
+      700,   725,   750,   776,   802,   828,   855,   883,
+      911,   940,   969,   998,  1029,  1059,  1090,  1122,
+     1155,  1188,  1221,  1256,  1290,  1326,  1362,  1399,
+     1436,  1474,  1513,  1553,  1593,  1634,  1675,  1718,
+     1761,  1805,  1850,  1895,  1942,  1989,  2037,  2086,
+     2136,  2187,  2239,  2291,  2345,  2400,  2455,  2512,
+     2569,  2628,  2688,  2748,  2810,  2873,  2938,  3003,
+     3069,  3137,  3206,  3276,  3348,  3420,  3494,  3570,
+     3647,  3725,  3805,  3886,  3968,  4052,  4138,  4225,
+     4313,  4404,  4496,  4589,  4684,  4781,  4880,  4981,
+     5083,  5187,  5293,  5401,  5511,  5623,  5737,  5854,
+     5972,  6092,  6215,  6339,  6466,  6596,  6727,  6861,
+     6998,  7137,  7278,  7422,  7569,  7718,  7870,  8025,
+     8183,  8343,  8506,  8673,  8842,  9014,  9190,  9368,
+     9550,  9736,  9924, 10116, 10312, 10511, 10713, 10920,
+    11130, 11344, 11561, 11783, 12009, 12238, 12472, 12711,
+    12953, 13200, 13451, 13707, 13968, 14233, 14503, 14779,
+    15059, 15344, 15634, 15929, 16230, 16537, 16849, 17166,
+    17489, 17819, 18154, 18495, 18842, 19196, 19556, 19923,
+    20296, 20676, 21063, 21457, 21858, 22267, 22682, 23106,
+    23537, 23975, 24422, 24877, 25340, 25812, 26292, 26781,
+    27278, 27785, 28301, 28826, 29361, 29905, 30459, 31024,
+    31598, 32183, 32779, 33385, 34002, 34631, 35271, 35922,
+    36586, 37261, 37949, 38649, 39362, 40088, 40827, 41579,
+    42345, 43125, 43919, 44727, 45550, 46388, 47241, 48110,
+    48994, 49894, 50811, 51744, 52695, 53662, 54647, 55650,
+    56671, 57711, 58769, 59847, 60944, 62061, 63198, 64356
+};
+
+// Logarithmic (ENV_CURVE_LOG). The RC (analog) shape.
+const unsigned int ENV_LOG_TABLE[ENV_CURVE_SIZE] PROGMEM = {
+        0,  1179,  2337,  3474,  4591,  5688,  6766,  7824,
+     8864,  9885, 10888, 11873, 12840, 13791, 14724, 15641,
+    16541, 17425, 18294, 19147, 19985, 20808, 21616, 22410,
+    23190, 23956, 24708, 25447, 26173, 26886, 27586, 28274,
+    28949, 29613, 30264, 30904, 31533, 32150, 32756, 33352,
+    33937, 34511, 35076, 35630, 36174, 36709, 37234, 37750,
+    38257, 38754, 39243, 39723, 40195, 40658, 41113, 41560,
+    41998, 42429, 42853, 43268, 43677, 44078, 44472, 44859,
+    45239, 45612, 45979, 46339, 46693, 47040, 47381, 47716,
+    48046, 48369, 48686, 48998, 49305, 49606, 49901, 50191,
+    50476, 50756, 51032, 51302, 51567, 51828, 52084, 52335,
+    52582, 52824, 53063, 53297, 53526, 53752, 53974, 54191,
+    54405, 54615, 54822, 55024, 55223, 55419, 55611, 55799,
+    55985, 56167, 56345, 56521, 56693, 56862, 57029, 57192,
+    57352, 57510, 57665, 57817, 57966, 58113, 58257, 58398,
+    58537, 58674, 58808, 58939, 59069, 59196, 59320, 59443,
+    59563, 59681, 59798, 59912, 60024, 60134, 60242, 60348,
+    60452, 60554, 60655, 60754, 60851, 60946, 61039, 61131,
+    61222, 61310, 61397, 61483, 61567, 61649, 61730, 61810,
+    61888, 61965, 62041, 62115, 62187, 62259, 62329, 62398,
+    62466, 62532, 62597, 62662, 62725, 62787, 62847, 62907,
+    62966, 63023, 63080, 63135, 63190, 63244, 63296, 63348,
+    63399, 63449, 63498, 63546, 63593, 63640, 63685, 63730,
+    63774, 63817, 63860, 63901, 63942, 63982, 64022, 64061,
+    64099, 64136, 64173, 64209, 64245, 64279, 64314, 64347,
+    64380, 64413, 64445, 64476, 64506, 64537, 64566, 64595,
+    64624, 64652, 64680, 64707, 64733, 64759, 64785, 64810,
+    64835, 64859, 64883, 64907, 64930, 64952, 64975, 64996,
+    65018, 65039, 65060, 65080, 65100, 65119, 65139, 65158,
+    65176, 65194, 65212, 65230, 65247, 65264, 65281, 65297,
+    65313, 65329, 65345, 65360, 65375, 65390, 65404, 65418,
+    65432, 65446, 65459, 65472, 65485, 65498, 65511, 65523
+};
+
+// S-curve (ENV_CURVE_S).
+const unsigned int ENV_S_TABLE[ENV_CURVE_SIZE] PROGMEM = {
+        0,     2,    10,    22,    39,    62,    89,   121,
+      158,   200,   246,   298,   355,   416,   482,   554,
+      630,   710,   796,   887,   982,  1082,  1187,  1297,
+     1411,  1530,  1654,  1782,  1915,  2053,  2196,  2343,
+     2494,  2650,  2811,  2976,  3146,  3320,  3499,  3682,
+     3869,  4061,  4257,  4457,  4662,  4871,  5084,  5301,
+     5522,  5748,  5977,  6211,  6448,  6690,  6935,  7185,
+     7438,  7695,  7956,  8220,  8488,  8760,  9036,  9315,
+     9597,  9883, 10173, 10466, 10762, 11062, 11365, 11671,
+    11980, 12292, 12608, 12926, 13248, 13572, 13900, 14230,
+    14563, 14899, 15237, 15578, 15922, 16268, 16616, 16968,
+    17321, 17677, 18035, 18395, 18758, 19122, 19489, 19857,
+    20228, 20600, 20975, 21351, 21728, 22108, 22489, 22872,
+    23256, 23641, 24028, 24416, 24806, 25196, 25588, 25981,
+    26375, 26770, 27166, 27562, 27960, 28358, 28756, 29156,
+    29556, 29956, 30357, 30758, 31160, 31561, 31963, 32365,
+    32767, 33170, 33572, 33974, 34375, 34777, 35178, 35579,
+    35979, 36379, 36779, 37177, 37575, 37973, 38369, 38765,
+    39160, 39554, 39947, 40339, 40729, 41119, 41507, 41894,
+    42279, 42663, 43046, 43427, 43807, 44184, 44560, 44935,
+    45307, 45678, 46046, 46413, 46777, 47140, 47500, 47858,
+    48214, 48567, 48919, 49267, 49613, 49957, 50298, 50636,
+    50972, 51305, 51635, 51963, 52287, 52609, 52927, 53243,
+    53555, 53864, 54170, 54473, 54773, 55069, 55362, 55652,
+    55938, 56220, 56499, 56775, 57047, 57315, 57579, 57840,
+    58097, 58350, 58600, 58845, 59087, 59324, 59558, 59787,
+    60013, 60234, 60451, 60664, 60873, 61078, 61278, 61474,
+    61666, 61853, 62036, 62215, 62389, 62559, 62724, 62885,
+    63041, 63192, 63339, 63482, 63620, 63753, 63881, 64005,
+    64124, 64238, 64348, 64453, 64553, 64648, 64739, 64825,
+    64905, 64981, 65053, 65119, 65180, 65237, 65289, 65335,
+    65377, 65414, 65446, 65473, 65496, 65513, 65525, 65533
+};
+
+// Linear velocity (ENV_VELOCITY_LINEAR).
+const unsigned int ENV_VEL_LINEAR_TABLE[ENV_VELOCITY_SIZE] PROGMEM = {
+       0,    8,   16,   24,   32,   40,   48,   56,
+      64,   72,   81,   89,   97,  105,  113,  121,
+     129,  137,  145,  153,  161,  169,  177,  185,
+     193,  201,  209,  217,  226,  234,  242,  250,
+     258,  266,  274,  282,  290,  298,  306,  314,
+     322,  330,  338,  346,  354,  362,  371,  379,
+     387,  395,  403,  411,  419,  427,  435,  443,
+     451,  459,  467,  475,  483,  491,  499,  507,
+     516,  524,  532,  540,  548,  556,  564,  572,
+     580,  588,  596,  604,  612,  620,  628,  636,
+     644,  652,  661,  669,  677,  685,  693,  701,
+     709,  717,  725,  733,  741,  749,  757,  765,
+     773,  781,  789,  797,  806,  814,  822,  830,
+     838,  846,  854,  862,  870,  878,  886,  894,
+     902,  910,  918,  926,  934,  942,  951,  959,
+     967,  975,  983,  991,  999, 1007, 1015, 1023
+};
+
+// Soft velocity (ENV_VELOCITY_SOFT).
+const unsigned int ENV_VEL_SOFT_TABLE[ENV_VELOCITY_SIZE] PROGMEM = {
+       0,   16,   32,   48,   63,   79,   94,  110,
+     125,  140,  155,  170,  184,  199,  213,  227,
+     242,  256,  269,  283,  297,  310,  324,  337,
+     350,  363,  376,  389,  401,  414,  426,  438,
+     451,  463,  474,  486,  498,  509,  521,  532,
+     543,  554,  565,  575,  586,  597,  607,  617,
+     627,  637,  647,  657,  666,  676,  685,  694,
+     703,  712,  721,  730,  738,  747,  755,  763,
+     771,  779,  787,  795,  802,  810,  817,  824,
+     831,  838,  845,  851,  858,  864,  871,  877,
+     883,  889,  895,  900,  906,  911,  916,  922,
+     927,  931,  936,  941,  945,  950,  954,  958,
+     962,  966,  970,  973,  977,  980,  983,  986,
+     989,  992,  995,  998, 1000, 1002, 1005, 1007,
+    1009, 1011, 1012, 1014, 1015, 1017, 1018, 1019,
+    1020, 1021, 1021, 1022, 1022, 1023, 1023, 1023
+};
+
+// Hard velocity (ENV_VELOCITY_HARD).
+const unsigned int ENV_VEL_HARD_TABLE[ENV_VELOCITY_SIZE] PROGMEM = {
+       0,    0,    0,    1,    1,    2,    2,    3,
+       4,    5,    6,    8,    9,   11,   12,   14,
+      16,   18,   21,   23,   25,   28,   31,   34,
+      37,   40,   43,   46,   50,   53,   57,   61,
+      65,   69,   73,   78,   82,   87,   92,   96,
+     101,  107,  112,  117,  123,  128,  134,  140,
+     146,  152,  159,  165,  172,  178,  185,  192,
+     199,  206,  213,  221,  228,  236,  244,  252,
+     260,  268,  276,  285,  293,  302,  311,  320,
+     329,  338,  347,  357,  366,  376,  386,  396,
+     406,  416,  426,  437,  448,  458,  469,  480,
+     491,  502,  514,  525,  537,  549,  560,  572,
+     585,  597,  609,  622,  634,  647,  660,  673,
+     686,  699,  713,  726,  740,  754,  767,  781,
+     796,  810,  824,  839,  853,  868,  883,  898,
+     913,  929,  944,  960,  975,  991, 1007, 1023
+};
+
+#endif // _ssb_envelope_curves_
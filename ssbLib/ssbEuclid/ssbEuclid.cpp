@@ -0,0 +1,145 @@
+/*
+  ssbEuclid.cpp - A Euclidean rhythm generator for ArdCore patches.
+
+  Created by Peter Fawcett, Oct 18. 2026.
+    Version 0.1: Created basic ssbEuclid Obect
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#include "ssbEuclid.h"
+
+// Constructors
+
+ssbEuclid::ssbEuclid()
+{
+    _hits = 0;
+    _steps = 1;
+    _rotate = 0;
+    _mask = 0;
+    reset();
+}
+
+ssbEuclid::ssbEuclid(byte hits, byte steps, byte rotate)
+{
+    _hits = 0xFF;               // Forces the first mask to be worked out.
+    _steps = 1;
+    _rotate = 0;
+    _pos = 0;
+    setPattern(hits, steps, rotate);
+    reset();
+}
+
+// Destructor
+
+ssbEuclid::~ssbEuclid(){/*nothing to destruct*/}
+
+// Euclid Methods
+
+void ssbEuclid::setPattern(byte hits, byte steps, byte rotate)
+{
+    steps = constrain(steps, 1, EUC_MAX_STEPS);
+    hits = min(hits, steps);
+    rotate = rotate % steps;
+    if ((hits == _hits) && (steps == _steps) && (rotate == _rotate))
+    {
+        return;
+    }
+    _hits = hits;
+    _steps = steps;
+    _rotate = rotate;
+    _mask = euclidMask(_hits, _steps, _rotate);
+    if (_pos >= _steps)
+    {
+        _pos = 0;
+    }
+    _bits = _mask >> _pos;
+}
+
+/* step
+ - Test and shift, the pattern is reloaded after the last step.
+*/
+bool ssbEuclid::step()
+{
+    bool hit = ((_bits & 1) != 0);
+    _bits >>= 1;
+    _pos++;
+    if (_pos >= _steps)
+    {
+        _pos = 0;
+        _bits = _mask;
+    }
+    return hit;
+}
+
+void ssbEuclid::reset()
+{
+    _pos = 0;
+    _bits = _mask;
+}
+
+unsigned long ssbEuclid::getMask()
+{
+    return _mask;
+}
+
+byte ssbEuclid::getSteps()
+{
+    return _steps;
+}
+
+byte ssbEuclid::getPosition()
+{
+    return _pos;
+}
+
+/* euclidMask
+ - Bresenham style: add the hits to a bucket each step, a step is a hit
+   when the bucket passes the step count. Starting the bucket at
+   steps - hits puts a hit on the first step. Then rotate left.
+*/
+unsigned long ssbEuclid::euclidMask(byte hits, byte steps, byte rotate)
+{
+    unsigned long mask = 0;
+    unsigned long full;
+    byte bucket;
+    steps = constrain(steps, 1, EUC_MAX_STEPS);
+    hits = min(hits, steps);
+    rotate = rotate % steps;
+    bucket = steps - hits;
+    for (byte i = 0; i < steps; i++)
+    {
+        bucket += hits;
+        if (bucket >= steps)
+        {
+            bucket -= steps;
+            mask |= (1UL << i);
+        }
+    }
+    if (rotate > 0)
+    {
+        if (steps == EUC_MAX_STEPS)
+        {
+            full = 0xFFFFFFFFUL;
+        }
+        else
+        {
+            full = (1UL << steps) - 1;
+        }
+        mask = ((mask >> rotate) | (mask << (steps - rotate))) & full;
+    }
+    return mask;
+}
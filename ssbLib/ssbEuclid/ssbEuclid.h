@@ -0,0 +1,74 @@
+/*
+  ssbEuclid.h - A Euclidean rhythm generator for ArdCore patches.
+    Spreads k hits as evenly as possible over n steps (n up to 32), with a
+    rotation. This gives the same rhythms as Bjorklund's algorithm, (3, 8)
+    is x . . x . . x . for example.
+
+    The pattern is worked out into a 32 bit mask only when the hits,
+    steps or rotation change. step (call on a clock edge) then only
+    tests the low bit of a copy of the mask and shifts it, and reloads
+    the copy at the end of the pattern.
+
+  Created by Peter Fawcett, Oct 18. 2026.
+    Version 0.1: Created basic ssbEuclid Obect
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#ifndef _ssb_euclid_class_
+#define _ssb_euclid_class_
+
+#include <Arduino.h>
+
+// ============================================================================
+// Euclid Constants:
+// ============================================================================
+const byte    EUC_MAX_STEPS         = 32;
+
+class ssbEuclid
+{
+    private:
+        unsigned long   _mask;          // Pattern, bit 0 is the first step.
+        unsigned long   _bits;          // Steps still to play this time through.
+        byte            _hits;
+        byte            _steps;
+        byte            _rotate;
+        byte            _pos;           // Next step.
+    public:
+        // Constructors
+        ssbEuclid();
+        ssbEuclid(byte hits, byte steps, byte rotate);
+        // Destructor
+        ~ssbEuclid();
+
+        // - Set hits (0 - steps), steps (1 - 32) and rotation (steps to
+        //   the left). Cheap to call every clock, the mask is only worked
+        //   out on a change. The position is kept.
+        void setPattern(byte hits, byte steps, byte rotate);
+        // - Play the next step. Returns true for a hit.
+        bool step();
+        // - The next step is the first one.
+        void reset();
+
+        unsigned long getMask();
+        byte getSteps();
+        byte getPosition();
+
+        // - Euclidean mask for hits, steps and rotation.
+        static unsigned long euclidMask(byte hits, byte steps, byte rotate);
+};
+
+#endif // _ssb_euclid_class_
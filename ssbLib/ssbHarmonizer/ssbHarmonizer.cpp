@@ -0,0 +1,184 @@
+/*
+  ssbHarmonizer.cpp - A quantize and shift (harmonizer) engine for ArdCore
+    patches.
+
+  Created by Peter Fawcett, Oct 18. 2026.
+    Version 0.1: Created basic ssbHarmonizer Obect
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#include "ssbHarmonizer.h"
+
+// Constructors
+
+ssbHarmonizer::ssbHarmonizer()
+{
+    _init(HARM_CHROMATIC);
+}
+
+ssbHarmonizer::ssbHarmonizer(byte mode)
+{
+    _init(mode);
+}
+
+// Destructor
+
+ssbHarmonizer::~ssbHarmonizer(){/*nothing to destruct*/}
+
+// Harmonizer Methods
+
+void ssbHarmonizer::setMode(byte mode)
+{
+    _mode = mode;
+}
+
+void ssbHarmonizer::setKey(byte key)
+{
+    _key = key % 12;
+}
+
+void ssbHarmonizer::setScale(unsigned int scale_mask)
+{
+    // The root is always in the scale.
+    scale_mask = (scale_mask & CHROMATIC_SCALE_MASK) | 1;
+    if (scale_mask != _scale)
+    {
+        _scale = scale_mask;
+        _calc_degrees();
+    }
+}
+
+void ssbHarmonizer::setShift(int shift)
+{
+    _shift = shift;
+}
+
+void ssbHarmonizer::setChord(const char* shifts, byte count)
+{
+    _chord_len = min(count, HARM_CHORD_MAX);
+    for (byte i = 0; i < _chord_len; i++)
+    {
+        _chord[i] = shifts[i];
+    }
+    _chord_index = 0;
+}
+
+void ssbHarmonizer::nextChordTone()
+{
+    if (_chord_len > 0)
+    {
+        _chord_index++;
+        if (_chord_index >= _chord_len)
+        {
+            _chord_index = 0;
+        }
+    }
+}
+
+void ssbHarmonizer::resetChord()
+{
+    _chord_index = 0;
+}
+
+int ssbHarmonizer::process(int value)
+{
+    _note = shiftNote(quantizeIndex(value));
+    return QNOTES[_note];
+}
+
+int ssbHarmonizer::getNote()
+{
+    return _note;
+}
+
+/* shiftNote
+ - Chromatic: add the shift. Diatonic: note to (octave, degree) from the
+   key, add the shift to the degree and back to a note. Then move back in
+   range by octaves.
+*/
+int ssbHarmonizer::shiftNote(int note)
+{
+    int shift = _shift;
+    int rel;
+    int octave;
+    int degree;
+    if (_chord_len > 0)
+    {
+        shift += _chord[_chord_index];
+    }
+    if (_mode == HARM_DIATONIC)
+    {
+        // + 12 keeps rel positive for keys above the note.
+        rel = note + 12 - _key;
+        octave = rel / 12;
+        degree = _note_degree[rel % 12] + shift;
+        while (degree < 0)
+        {
+            degree += _scale_len;
+            octave--;
+        }
+        octave += degree / _scale_len;
+        degree = degree % _scale_len;
+        note = (octave * 12) + _degree_note[degree] + _key - 12;
+    }
+    else
+    {
+        note += shift;
+    }
+    while (note > HARM_MAX_NOTE)
+    {
+        note -= 12;
+    }
+    while (note < 0)
+    {
+        note += 12;
+    }
+    return note;
+}
+
+// Private methods
+
+void ssbHarmonizer::_init(byte mode)
+{
+    _mode = mode;
+    _key = C_NOTE;
+    _scale = 0;
+    _shift = 0;
+    _chord_len = 0;
+    _chord_index = 0;
+    _note = 0;
+    setScale(MAJOR_SCALE_MASK);
+}
+
+/* _calc_degrees
+ - Build the degree to semitone table and the semitone to degree table
+   (a semitone not in the scale maps to the degree below it).
+*/
+void ssbHarmonizer::_calc_degrees()
+{
+    byte degree = 0;
+    for (byte i = 0; i < 12; i++)
+    {
+        if ((_scale >> i) & 1)
+        {
+            _degree_note[degree] = i;
+            degree++;
+        }
+        _note_degree[i] = degree - 1;
+    }
+    _scale_len = degree;
+}
@@ -0,0 +1,110 @@
+/*
+  ssbHarmonizer.h - A quantize and shift (harmonizer) engine for ArdCore
+    patches. Generalizes the 4ths and 5ths patches to any shift.
+    The input (1v/oct, 0 - 1023) is quantized to a QNOTES index in constant
+    time (quantizeIndex, ssbScales) and shifted by either:
+      - semitones (chromatic, the same as the 4ths and 5ths patches), or
+      - scale degrees in a key (diatonic, setKey / setScale with the
+        ssbScales masks). The input is moved down to the scale first, so
+        the output always stays in key. In C major a shift of 2 degrees
+        is a major 3rd from C and a minor 3rd from D.
+    Shifts that go past the ArdCore range (C3 - C8) are moved back by
+    octaves.
+
+    A chord (a list of shifts added to the main shift) may be set. Each
+    nextChordTone (call it on a clock edge) moves to the next chord tone,
+    which makes an arpeggio of the input note.
+
+    The degree tables are only rebuilt when the key or scale change, so
+    process is a few table reads.
+
+  Created by Peter Fawcett, Oct 18. 2026.
+    Version 0.1: Created basic ssbHarmonizer Obect
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#ifndef _ssb_harmonizer_class_
+#define _ssb_harmonizer_class_
+
+#include <Arduino.h>
+#include <ssbScales.h>
+
+// ============================================================================
+// Harmonizer Constants:
+// ============================================================================
+const byte    HARM_CHROMATIC        = 0;    // Shift in semitones.
+const byte    HARM_DIATONIC         = 1;    // Shift in scale degrees.
+const byte    HARM_CHORD_MAX        = 8;    // Max chord tones.
+const int     HARM_MAX_NOTE         = NOTE_COUNT - 1;
+
+// ============================================================================
+// Common Shifts:
+// ============================================================================
+const int     HARM_FOURTH           = 5;    // Semitones.
+const int     HARM_FIFTH            = 7;
+const int     HARM_FOURTH_DEGREES   = 3;    // Scale degrees.
+const int     HARM_FIFTH_DEGREES    = 4;
+
+class ssbHarmonizer
+{
+    private:
+        byte            _mode;                      // HARM_CHROMATIC or HARM_DIATONIC.
+        byte            _key;                       // Root note (C_NOTE - B_NOTE).
+        unsigned int    _scale;                     // Scale mask.
+        byte            _scale_len;                 // Notes in the scale.
+        byte            _degree_note[12];           // Semitones above the key, per degree.
+        byte            _note_degree[12];           // Degree at or below, per semitone.
+        int             _shift;                     // Main shift.
+        char            _chord[HARM_CHORD_MAX];     // Chord tone shifts.
+        byte            _chord_len;                 // Chord tones (0 is no chord).
+        byte            _chord_index;               // Current chord tone.
+        int             _note;                      // Last output note index.
+    public:
+        // Constructors
+        ssbHarmonizer();
+        ssbHarmonizer(byte mode);
+        // Destructor
+        ~ssbHarmonizer();
+
+        // - HARM_CHROMATIC (semitones) or HARM_DIATONIC (scale degrees).
+        void setMode(byte mode);
+        // - Key (C_NOTE - B_NOTE) and scale mask (MAJOR_SCALE_MASK, ...) for
+        //   the diatonic mode.
+        void setKey(byte key);
+        void setScale(unsigned int scale_mask);
+        // - Shift in semitones or degrees (negative is down).
+        void setShift(int shift);
+        // - Chord tone shifts (semitones or degrees, added to the main
+        //   shift). A count of 0 clears the chord.
+        void setChord(const char* shifts, byte count);
+        // - Move to the next chord tone. Call on a clock edge.
+        void nextChordTone();
+        // - Back to the first chord tone.
+        void resetChord();
+
+        // - Quantize and shift an input (0 - 1023). Returns the QNOTES value.
+        int process(int value);
+        // - QNOTES index of the last output.
+        int getNote();
+        // - Shift a QNOTES index (0 - 60). Returns the new index.
+        int shiftNote(int note);
+    private:
+        void _init(byte mode);
+        void _calc_degrees();
+};
+
+#endif // _ssb_harmonizer_class_
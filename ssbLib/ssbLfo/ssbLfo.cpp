@@ -0,0 +1,238 @@
+/*
+  ssbLfo.cpp - A tempo synced LFO for ArdCore patches.
+
+  Created by Peter Fawcett, Oct 18. 2026.
+    Version 0.1: Created basic ssbLfo Obect
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#include "ssbLfo.h"
+
+// Constructors
+
+ssbLfo::ssbLfo()
+{
+    _init(WAVE_SINE_ID);
+}
+
+ssbLfo::ssbLfo(byte shape)
+{
+    _init(shape);
+}
+
+// Destructor
+
+ssbLfo::~ssbLfo(){/*nothing to destruct*/}
+
+// LFO Methods
+
+void ssbLfo::setShape(byte shape)
+{
+    if (shape < LFO_SHAPE_COUNT)
+    {
+        _shape = shape;
+    }
+}
+
+/* setRate
+ - Map a control value to a free rate. Squared curve, the square is
+   taken >> 4 to keep the math in 32 bits.
+*/
+void ssbLfo::setRate(int ctl)
+{
+    const unsigned long CTL_SQ_MAX = ((unsigned long)LFO_CTL_MAX * LFO_CTL_MAX) >> 4;
+    unsigned long ctl_sq;
+    if ((ctl == _rate_ctl) && (_clock_sync == false))
+    {
+        return;
+    }
+    _rate_ctl = ctl;
+    ctl = constrain(ctl, 0, LFO_CTL_MAX);
+    ctl_sq = ((unsigned long)ctl * ctl) >> 4;
+    setRateMilliHz(LFO_RATE_MIN_MHZ + ((ctl_sq * (LFO_RATE_MAX_MHZ - LFO_RATE_MIN_MHZ)) / CTL_SQ_MAX));
+}
+
+/* setRateMilliHz
+ - increment = rate * 2^32 / tick rate. With a 1ms tick that is
+   mHz * 4294.967296, done as whole and fraction parts to stay in 32 bits
+   (good to 1000Hz).
+*/
+void ssbLfo::setRateMilliHz(unsigned long mhz)
+{
+    _clock_sync = false;
+    _inc = (mhz * 4294UL) + ((mhz * 967UL) / 1000UL);
+}
+
+void ssbLfo::setClockRatio(byte mult, byte div)
+{
+    _clock_mult = max(mult, 1);
+    _clock_div = max(div, 1);
+    _clock_sync = true;
+    _rate_ctl = -1;     // Next setRate recalculates.
+    _calc_clock_inc();
+}
+
+void ssbLfo::setClockReset(bool is_on)
+{
+    _clock_reset = is_on;
+}
+
+void ssbLfo::clockEdge()
+{
+    clockEdge(micros());
+}
+
+/* clockEdge
+ - Measure the clock period and reset the phase at the start of a cycle.
+   The first edge only starts the measurement.
+*/
+void ssbLfo::clockEdge(unsigned long now_us)
+{
+    if (_last_clock_us != 0)
+    {
+        _clock_us = now_us - _last_clock_us;
+        if (_clock_sync == true)
+        {
+            _calc_clock_inc();
+        }
+    }
+    _last_clock_us = now_us;
+    if ((_clock_sync == true) && (_clock_reset == true))
+    {
+        _clock_count++;
+        if (_clock_count >= _clock_div)
+        {
+            _clock_count = 0;
+            reset();
+        }
+    }
+}
+
+int ssbLfo::update()
+{
+    return update(micros());
+}
+
+/* update
+ - One add per tick since the last update, then one table read. A stall
+   of more than LFO_MAX_CATCHUP ticks drops the extra ticks.
+*/
+int ssbLfo::update(unsigned long now_us)
+{
+    byte ticks = 0;
+    byte level;
+    while ((long)(now_us - _next_tick_us) >= 0)
+    {
+        _phase += _inc;
+        if (_phase < _inc)
+        {
+            // Wrapped, start of a new cycle.
+            _random_level = random(0, 256);
+        }
+        _next_tick_us += LFO_TICK_US;
+        if (++ticks >= LFO_MAX_CATCHUP)
+        {
+            _next_tick_us = now_us + LFO_TICK_US;
+            break;
+        }
+    }
+    if (_shape == LFO_RANDOM_ID)
+    {
+        level = _random_level;
+    }
+    else
+    {
+        level = pgm_read_byte(waveTable(_shape) + (byte)(_phase >> 24));
+    }
+    // 8 bit level to 0 - 1023.
+    _out = ((int)level << 2) | (level >> 6);
+    return _out;
+}
+
+int ssbLfo::getValue()
+{
+    return _out;
+}
+
+unsigned int ssbLfo::getPhase()
+{
+    return (unsigned int)(_phase >> 16);
+}
+
+unsigned long ssbLfo::getClockPeriod()
+{
+    return _clock_us;
+}
+
+void ssbLfo::reset()
+{
+    _phase = 0;
+    _random_level = random(0, 256);
+}
+
+// Private methods
+
+void ssbLfo::_init(byte shape)
+{
+    _phase = 0;
+    _inc = 0;
+    _next_tick_us = 0;
+    _last_clock_us = 0;
+    _clock_us = 0;
+    _rate_ctl = -1;             // -1 forces the first set to calculate.
+    _shape = WAVE_SINE_ID;
+    setShape(shape);
+    _clock_mult = 1;
+    _clock_div = 1;
+    _clock_count = 0;
+    _clock_sync = false;
+    _clock_reset = true;
+    _random_level = 128;
+    _out = 0;
+    setRateMilliHz(1000);
+}
+
+/* _calc_clock_inc
+ - LFO period is clock period * div / mult. Nothing to do until the clock
+   period is known.
+*/
+void ssbLfo::_calc_clock_inc()
+{
+    if (_clock_us == 0)
+    {
+        return;
+    }
+    _inc = _inc_for_period((_clock_us * _clock_div) / _clock_mult);
+}
+
+/* _inc_for_period
+ - increment = 2^32 * tick / period. Split into whole and remainder parts
+   so nothing overflows 32 bits. Periods shorter than two ticks are held
+   at two ticks.
+*/
+unsigned long ssbLfo::_inc_for_period(unsigned long period_us)
+{
+    unsigned long whole;
+    unsigned long part;
+    if (period_us < (2UL * LFO_TICK_US))
+    {
+        period_us = 2UL * LFO_TICK_US;
+    }
+    whole = 0xFFFFFFFFUL / period_us;
+    part = 0xFFFFFFFFUL % period_us;
+    return (whole * LFO_TICK_US) + (part / (period_us / LFO_TICK_US));
+}
@@ -0,0 +1,117 @@
+/*
+  ssbLfo.h - A tempo synced LFO for ArdCore patches.
+    A 32 bit phase accumulator (DDS) advanced at a fixed tick rate
+    (LFO_TICK_US). Each tick is one add, the wave is looked up (ssbWaves,
+    flash) once per update, so the LFO can run in the same loop as gates
+    and envelopes. The ticks are counted from micros, so the rate does not
+    change when the loop slows down.
+
+    The rate is either free (Hz, set from a knob or in mHz) or a multiple /
+    division of the clock. For the clock rate, call clockEdge on each
+    rising edge of the clock input. The clock period is measured (micros)
+    on each edge and the phase is reset at the start of each LFO cycle
+    (every edge for multiples, every div edges for divisions), so the LFO
+    stays locked to the clock.
+
+    Shapes: sine, triangle, saw, square (WAVE_*_ID from ssbWaves) and
+    random step (LFO_RANDOM_ID, a new random level each cycle).
+
+  Created by Peter Fawcett, Oct 18. 2026.
+    Version 0.1: Created basic ssbLfo Obect
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#ifndef _ssb_lfo_class_
+#define _ssb_lfo_class_
+
+#include <Arduino.h>
+#include <ssbWaves.h>
+
+// ============================================================================
+// LFO Constants:
+// ============================================================================
+const byte    LFO_RANDOM_ID         = WAVE_COUNT;       // Random step shape.
+const byte    LFO_SHAPE_COUNT       = WAVE_COUNT + 1;
+const unsigned int LFO_TICK_US      = 1000;             // Phase tick (1kHz).
+const byte    LFO_MAX_CATCHUP       = 100;              // Max ticks per update.
+const int     LFO_MAX               = 1023;             // Max output value.
+const int     LFO_CTL_MAX           = 1023;             // Max control (knob) value.
+const unsigned long LFO_RATE_MIN_MHZ = 10;              // Rate at control 0 (0.01Hz).
+const unsigned long LFO_RATE_MAX_MHZ = 50000;           // Rate at control 1023 (50Hz).
+
+class ssbLfo
+{
+    private:
+        unsigned long   _phase;         // Phase accumulator.
+        unsigned long   _inc;           // Phase increment per tick.
+        unsigned long   _next_tick_us;  // micros() of the next tick.
+        unsigned long   _last_clock_us; // micros() of the last clock edge.
+        unsigned long   _clock_us;      // Measured clock period (0 until known).
+        int             _rate_ctl;      // Last rate control value.
+        byte            _shape;         // Shape id.
+        byte            _clock_mult;    // Clock multiple (clock mode).
+        byte            _clock_div;     // Clock division (clock mode).
+        byte            _clock_count;   // Clock edges since the last reset.
+        bool            _clock_sync;    // true: rate from the clock.
+        bool            _clock_reset;   // Reset the phase on the clock.
+        byte            _random_level;  // Current random step level.
+        int             _out;           // Current output (0 - 1023).
+    public:
+        // Constructors
+        ssbLfo();
+        ssbLfo(byte shape);
+        // Destructor
+        ~ssbLfo();
+
+        // - Set the shape (WAVE_SINE_ID, WAVE_TRI_ID, WAVE_SAW_ID,
+        //   WAVE_SQUARE_ID or LFO_RANDOM_ID).
+        void setShape(byte shape);
+        // - Free rate from a control value (0 - 1023), 0.01Hz - 50Hz on a
+        //   squared curve. Only recalculated when the value changes.
+        void setRate(int ctl);
+        // - Free rate in mHz (1000 = 1Hz).
+        void setRateMilliHz(unsigned long mhz);
+        // - Rate from the clock, mult / div times the clock rate (1, 4 is
+        //   one cycle every 4 clocks, 2, 1 is two cycles per clock).
+        void setClockRatio(byte mult, byte div);
+        // - Reset the phase on the clock (default on). Only used for the
+        //   clock rate.
+        void setClockReset(bool is_on);
+        // - Call on each rising clock edge.
+        void clockEdge();
+        void clockEdge(unsigned long now_us);
+
+        // - Advance by the ticks since the last call. Call once per loop.
+        //   Returns the new value (0 - 1023).
+        int update();
+        int update(unsigned long now_us);
+
+        // - Current value (0 - 1023).
+        int getValue();
+        // - Current phase (0 - 65535).
+        unsigned int getPhase();
+        // - Measured clock period (us, 0 until two edges are seen).
+        unsigned long getClockPeriod();
+        // - Restart the cycle at phase 0.
+        void reset();
+    private:
+        void _init(byte shape);
+        void _calc_clock_inc();
+        static unsigned long _inc_for_period(unsigned long period_us);
+};
+
+#endif // _ssb_lfo_class_
@@ -0,0 +1,152 @@
+/*
+  ssbLogicGate.cpp - A truth table logic element for ArdCore patches.
+
+  Created by Peter Fawcett, Oct 18. 2026.
+    Version 0.1: Created basic ssbLogicGate Obect
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#include "ssbLogicGate.h"
+
+// Constructors
+
+ssbLogicGate::ssbLogicGate()
+{
+    _type = LOGIC_CUSTOM;
+    _win_low = 0;
+    _win_high = 0;
+    setType(LOGIC_OR);
+}
+
+ssbLogicGate::ssbLogicGate(byte type)
+{
+    _type = LOGIC_CUSTOM;
+    _win_low = 0;
+    _win_high = 0;
+    setType(type);
+}
+
+// Destructor
+
+ssbLogicGate::~ssbLogicGate(){/*nothing to destruct*/}
+
+// Logic Methods
+
+void ssbLogicGate::setType(byte type)
+{
+    if ((type >= LOGIC_TYPE_COUNT) || (type == _type))
+    {
+        return;
+    }
+    _type = type;
+    _mask = 0;
+    _index_mask = 0x0F;
+    if (type < LOGIC_TABLE_COUNT)
+    {
+        _mask = pgm_read_word(LOGIC_TABLES + type);
+    }
+    if (type < LOGIC_TABLE_2_COUNT)
+    {
+        _index_mask = 0x03;
+    }
+    _last = 0;
+    _state = false;
+}
+
+byte ssbLogicGate::getType()
+{
+    return _type;
+}
+
+void ssbLogicGate::setTable(unsigned int mask, byte inputs)
+{
+    inputs = constrain(inputs, 1, LOGIC_INPUTS);
+    _type = LOGIC_CUSTOM;
+    _mask = mask;
+    _index_mask = (1 << inputs) - 1;
+    _last = 0;
+    _state = false;
+}
+
+void ssbLogicGate::setWindow(int low, int high)
+{
+    _win_low = low;
+    _win_high = high;
+}
+
+/* update
+ - Tables are one shift and mask. A rising edge is a bit that is set
+   now and was clear on the last update.
+*/
+bool ssbLogicGate::update(byte bits, int level)
+{
+    byte rising = bits & ~_last;
+    byte falling = _last & ~bits;
+    if ((_type < LOGIC_TABLE_COUNT) || (_type == LOGIC_CUSTOM))
+    {
+        _state = ((_mask >> (bits & _index_mask)) & 1) != 0;
+    }
+    else
+    {
+        switch (_type)
+        {
+            case LOGIC_SR:
+                if ((bits & 2) != 0)
+                {
+                    _state = false;
+                }
+                else if ((bits & 1) != 0)
+                {
+                    _state = true;
+                }
+                break;
+            case LOGIC_D:
+                if ((rising & 2) != 0)
+                {
+                    _state = ((bits & 1) != 0);
+                }
+                break;
+            case LOGIC_T:
+                if (((rising & 2) != 0) && ((bits & 1) != 0))
+                {
+                    _state = !_state;
+                }
+                break;
+            case LOGIC_RISE:
+                _state = ((rising & 1) != 0);
+                break;
+            case LOGIC_FALL:
+                _state = ((falling & 1) != 0);
+                break;
+            case LOGIC_WINDOW:
+                _state = ((level >= _win_low) && (level <= _win_high));
+                break;
+        }
+    }
+    _last = bits;
+    return _state;
+}
+
+bool ssbLogicGate::getState()
+{
+    return _state;
+}
+
+bool ssbLogicGate::isPulse()
+{
+    return ((_type == LOGIC_RISE) || (_type == LOGIC_FALL));
+}
@@ -0,0 +1,116 @@
+/*
+  ssbLogicGate.h - A truth table logic element for ArdCore patches.
+    Inputs are passed in as bits (bit 0 is input A, bit 1 is B, bit 2 is
+    C, bit 3 is D). A table type is a mask with one bit per input state,
+    the output is the mask bit the input bits index:
+
+            A:   0    1    0    1
+            B:   0    0    1    1
+            ------------------------------
+            OR:  0    1    1    1     mask 0x000E
+            AND: 0    0    0    1     mask 0x0008
+
+    Two input tables are 4 entries (A and B), four input tables are 16
+    entries (A - D). Any table may be set with setTable. So a gate is a
+    shift and a mask, the same cost for every type.
+
+    Stateful types:
+      LOGIC_SR:       set on A, reset on B (reset wins).
+      LOGIC_D:        latch A on the rising edge of B.
+      LOGIC_T:        toggle on the rising edge of B when A is high.
+      LOGIC_RISE:     true for one update on the rising edge of A.
+      LOGIC_FALL:     true for one update on the falling edge of A.
+      LOGIC_WINDOW:   true while the level is inside the window.
+
+  Created by Peter Fawcett, Oct 18. 2026.
+    Version 0.1: Created basic ssbLogicGate Obect
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#ifndef _ssb_logic_gate_class_
+#define _ssb_logic_gate_class_
+
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+
+// ============================================================================
+// Logic Constants:
+// ============================================================================
+const byte    LOGIC_INPUTS          = 4;
+// Two input tables (A, B).
+const byte    LOGIC_OR              = 0;
+const byte    LOGIC_AND             = 1;
+const byte    LOGIC_NOR             = 2;
+const byte    LOGIC_NAND            = 3;
+const byte    LOGIC_XOR             = 4;
+const byte    LOGIC_NXOR            = 5;
+// Four input tables (A - D).
+const byte    LOGIC_OR4             = 6;
+const byte    LOGIC_AND4            = 7;
+const byte    LOGIC_XOR4            = 8;    // Odd count of inputs high.
+const byte    LOGIC_MAJ4            = 9;    // 3 or more inputs high.
+// Stateful types.
+const byte    LOGIC_SR              = 10;
+const byte    LOGIC_D               = 11;
+const byte    LOGIC_T               = 12;
+const byte    LOGIC_RISE            = 13;
+const byte    LOGIC_FALL            = 14;
+const byte    LOGIC_WINDOW          = 15;
+const byte    LOGIC_TYPE_COUNT      = 16;
+// Table set with setTable.
+const byte    LOGIC_CUSTOM          = 16;
+
+const byte    LOGIC_TABLE_2_COUNT   = 6;
+const byte    LOGIC_TABLE_COUNT     = 10;
+const unsigned int LOGIC_TABLES[LOGIC_TABLE_COUNT] PROGMEM = {
+    0x000E, 0x0008, 0x0001, 0x0007, 0x0006, 0x0009,
+    0xFFFE, 0x8000, 0x6996, 0xE880};
+
+class ssbLogicGate
+{
+    private:
+        unsigned int    _mask;          // Truth table, one bit per input state.
+        byte            _index_mask;    // Input bits the table uses (0x03 or 0x0F).
+        byte            _type;
+        byte            _last;          // Input bits of the last update (for edges).
+        bool            _state;
+        int             _win_low;
+        int             _win_high;
+    public:
+        // Constructors
+        ssbLogicGate();
+        ssbLogicGate(byte type);
+        // Destructor
+        ~ssbLogicGate();
+
+        // - Set the type (LOGIC_OR - LOGIC_WINDOW). Clears the state if the
+        //   type changed.
+        void setType(byte type);
+        byte getType();
+        // - Use a custom truth table over 1 - 4 inputs.
+        void setTable(unsigned int mask, byte inputs);
+        // - Window for LOGIC_WINDOW, low to high (inclusive).
+        void setWindow(int low, int high);
+        // - Update with the input bits (and the level, for LOGIC_WINDOW).
+        //   Returns the output.
+        bool update(byte bits, int level);
+        bool getState();
+        // - Is the output a one update pulse (edge types).
+        bool isPulse();
+};
+
+#endif // _ssb_logic_gate_class_
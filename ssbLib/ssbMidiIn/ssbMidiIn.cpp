@@ -0,0 +1,355 @@
+/*
+  ssbMidiIn.cpp - An object to parse a raw MIDI byte stream arriving on the
+    serial connection (for example from a USB-MIDI to serial bridge). This
+    removes the need for a Max4Live device to convert MIDI to the ASCII
+    '[n]' strings used by ssbArdM4L.
+    Can not be used at same time as ssbDebug or ssbArdM4L as they use the
+    same serial connection.
+
+  Created by Peter Fawcett, Oct 18. 2026.
+    Version 0.1: Created basic ssbMidiIn Obect
+    Version 0.2: Oct 18. 2026
+                    Skip system exclusive data. Held note stack.
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#include "ssbMidiIn.h"
+
+// Status byte constants (upper nibble for channel messages).
+const byte STATUS_NOTE_OFF  = 0x80;
+const byte STATUS_NOTE_ON   = 0x90;
+const byte STATUS_CC        = 0xB0;
+const byte STATUS_PROGRAM   = 0xC0;
+const byte STATUS_PRESSURE  = 0xD0;
+const byte STATUS_SYSTEM    = 0xF0;
+const byte STATUS_SYSEX_END = 0xF7;
+const byte STATUS_REALTIME  = 0xF8;
+const byte STATUS_CLOCK     = 0xF8;
+const byte STATUS_START     = 0xFA;
+const byte STATUS_CONTINUE  = 0xFB;
+const byte STATUS_STOP      = 0xFC;
+// Channel mode controllers.
+const byte CC_ALL_SOUND_OFF = 120;
+const byte CC_ALL_NOTES_OFF = 123;
+
+ssbMidiIn::ssbMidiIn()
+{
+    _baud_rate = MIDI_BAUD;     // Default baud rate.
+    _channel = MIDI_OMNI;       // Default is to listen to all channels.
+    _note = 0;
+    _velocity = 0;
+    _cc_number = 0;
+    _cc_value = 0;
+    _held_count = 0;
+    resetStats();
+    reset();
+}
+
+ssbMidiIn::ssbMidiIn(byte channel)
+{
+    _baud_rate = MIDI_BAUD;     // Default baud rate.
+    _channel = channel;         // Listen to the specified channel.
+    _note = 0;
+    _velocity = 0;
+    _cc_number = 0;
+    _cc_value = 0;
+    _held_count = 0;
+    resetStats();
+    reset();
+}
+
+ssbMidiIn::~ssbMidiIn()
+{
+    Serial.end();
+}
+
+void ssbMidiIn::enableSerial()
+{
+    Serial.begin(_baud_rate);   // Enable serial input at specified baud rate.
+}
+
+void ssbMidiIn::enableSerial(long baud_rate)
+{
+    _baud_rate = baud_rate;
+    Serial.begin(_baud_rate);   // Enable serial input at specified baud rate.
+}
+
+/* doRead
+ - Read (at most) one byte from the serial input and parse it. One byte per
+   call keeps the cost per loop small and fixed. Returns the type of message
+   completed by the byte, or MIDI_NONE.
+*/
+byte ssbMidiIn::doRead()
+{
+    if (Serial.available() > 0)
+    {
+        return parseByte((byte)Serial.read());
+    }
+    return MIDI_NONE;
+}
+
+/* parseByte
+ - Advance the parser state machine by one byte.
+*/
+byte ssbMidiIn::parseByte(byte in_byte)
+{
+    if (in_byte >= STATUS_REALTIME)
+    {
+        // Real time messages may appear anywhere, even between the data
+        // bytes of another message. They do not touch running status.
+        switch (in_byte)
+        {
+            case STATUS_CLOCK:
+                return MIDI_CLOCK;
+            case STATUS_START:
+                return MIDI_START;
+            case STATUS_CONTINUE:
+                return MIDI_CONTINUE;
+            case STATUS_STOP:
+                return MIDI_STOP;
+        }
+        return MIDI_NONE;
+    }
+    if (in_byte >= STATUS_SYSTEM)
+    {
+        // System exclusive / system common. Cancels running status, data
+        // bytes are skipped till the end of exclusive or the next status.
+        if (_data_index > 0)
+        {
+            _error_count++;
+        }
+        reset();
+        if (in_byte != STATUS_SYSEX_END)
+        {
+            _in_sysex = true;
+        }
+        return MIDI_NONE;
+    }
+    if (in_byte & 0x80)
+    {
+        // Also ends an exclusive that was never closed.
+        _in_sysex = false;
+        // Channel status byte. Start a new message.
+        if (_data_index > 0)
+        {
+            // previous message cut short.
+            _error_count++;
+        }
+        _status = in_byte;
+        _data_index = 0;
+        byte type = in_byte & 0xF0;
+        if ((type == STATUS_PROGRAM) || (type == STATUS_PRESSURE))
+        {
+            _data_needed = 1;
+        }
+        else
+        {
+            _data_needed = 2;
+        }
+        return MIDI_NONE;
+    }
+    if (_in_sysex == true)
+    {
+        return MIDI_NONE;
+    }
+    if (_status == 0)
+    {
+        // Data byte with no status to apply it to.
+        _error_count++;
+        return MIDI_NONE;
+    }
+    _data[_data_index] = in_byte;
+    _data_index++;
+    if (_data_index < _data_needed)
+    {
+        return MIDI_NONE;
+    }
+    // Message complete. Keep the status for running status.
+    _data_index = 0;
+    _message_count++;
+    return _do_message();
+}
+
+/* reset
+ - Forget the running status and any partial message.
+*/
+void ssbMidiIn::reset()
+{
+    _status = 0;
+    _data_index = 0;
+    _data_needed = 2;
+    _in_sysex = false;
+}
+
+byte ssbMidiIn::getChannel()
+{
+    return _channel;
+}
+
+void ssbMidiIn::setChannel(byte channel)
+{
+    _channel = channel;
+}
+
+byte ssbMidiIn::getNote()
+{
+    return _note;
+}
+
+byte ssbMidiIn::getVelocity()
+{
+    return _velocity;
+}
+
+byte ssbMidiIn::getCCNumber()
+{
+    return _cc_number;
+}
+
+byte ssbMidiIn::getCCValue()
+{
+    return _cc_value;
+}
+
+/* getGate
+ - Monophonic gate. On while any note is held.
+*/
+bool ssbMidiIn::getGate()
+{
+    return (_held_count > 0);
+}
+
+/* getGateNote
+ - The last note played that is still held (or the last note released
+   once none are held).
+*/
+byte ssbMidiIn::getGateNote()
+{
+    if (_held_count == 0)
+    {
+        return _note;
+    }
+    return _held[_held_count - 1];
+}
+
+void ssbMidiIn::releaseAll()
+{
+    _held_count = 0;
+}
+
+unsigned int ssbMidiIn::getMessageCount()
+{
+    return _message_count;
+}
+
+unsigned int ssbMidiIn::getErrorCount()
+{
+    return _error_count;
+}
+
+void ssbMidiIn::resetStats()
+{
+    _message_count = 0;
+    _error_count = 0;
+}
+
+void ssbMidiIn::reportStats()
+{
+    Serial.print('[');
+    Serial.print(_message_count);
+    Serial.print(',');
+    Serial.print(_error_count);
+    Serial.println(']');
+}
+
+// Private methods
+
+byte ssbMidiIn::_do_message()
+{
+    if ((_channel != MIDI_OMNI) && ((_status & 0x0F) != _channel))
+    {
+        return MIDI_NONE;
+    }
+    switch (_status & 0xF0)
+    {
+        case STATUS_NOTE_ON:
+            _note = _data[0];
+            _velocity = _data[1];
+            if (_velocity > 0)
+            {
+                _hold_note(_note);
+                return MIDI_NOTE_ON;
+            }
+            // Note on with a velocity of 0 is a note off.
+            _release_note(_note);
+            return MIDI_NOTE_OFF;
+        case STATUS_NOTE_OFF:
+            _note = _data[0];
+            _velocity = _data[1];
+            _release_note(_note);
+            return MIDI_NOTE_OFF;
+        case STATUS_CC:
+            _cc_number = _data[0];
+            _cc_value = _data[1];
+            if ((_cc_number == CC_ALL_NOTES_OFF) || (_cc_number == CC_ALL_SOUND_OFF))
+            {
+                releaseAll();
+            }
+            return MIDI_CC;
+    }
+    return MIDI_NONE;
+}
+
+/* _hold_note
+ - Put a note on top of the held stack. A note already held moves to the
+   top. When the stack is full the oldest note is forgotten.
+*/
+void ssbMidiIn::_hold_note(byte note)
+{
+    _release_note(note);
+    if (_held_count >= MIDI_HELD_MAX)
+    {
+        for (byte i = 1; i < MIDI_HELD_MAX; i++)
+        {
+            _held[i - 1] = _held[i];
+        }
+        _held_count = MIDI_HELD_MAX - 1;
+    }
+    _held[_held_count] = note;
+    _held_count++;
+}
+
+/* _release_note
+ - Take a note out of the held stack, where ever it is.
+*/
+void ssbMidiIn::_release_note(byte note)
+{
+    byte i = 0;
+    while ((i < _held_count) && (_held[i] != note))
+    {
+        i++;
+    }
+    if (i == _held_count)
+    {
+        return;
+    }
+    _held_count--;
+    for (; i < _held_count; i++)
+    {
+        _held[i] = _held[i + 1];
+    }
+}
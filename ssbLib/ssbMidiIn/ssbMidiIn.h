@@ -0,0 +1,136 @@
+/*
+  ssbMidiIn.h - An object to parse a raw MIDI byte stream arriving on the
+    serial connection (for example from a USB-MIDI to serial bridge). This
+    removes the need for a Max4Live device to convert MIDI to the ASCII
+    '[n]' strings used by ssbArdM4L.
+    The parser is a small fixed size state machine. It handles running
+    status, note on/off (note on with velocity 0 is a note off), control
+    change and the clock/start/continue/stop real time messages. Real time
+    messages may arrive in the middle of another message and do not break
+    running status. System exclusive and other system common messages are
+    skipped, with their data, till the end of exclusive (0xF7) or the next
+    status byte. The gate is monophonic with last note priority: up to
+    MIDI_HELD_MAX held notes are kept, releasing a note returns to the
+    note held before it and the gate stays on while any note is held. No
+    memory is allocated.
+    Can not be used at same time as ssbDebug or ssbArdM4L as they use the
+    same serial connection.
+
+  Created by Peter Fawcett, Oct 18. 2026.
+    Version 0.1: Created basic ssbMidiIn Obect
+    Version 0.2: Oct 18. 2026
+                    System exclusive data is skipped. Held note stack for
+                    the gate. All notes off.
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#ifndef _ssb_midi_in_class_
+#define _ssb_midi_in_class_
+
+#include <Arduino.h>
+
+// ============================================================================
+// Message types returned by doRead / parseByte:
+// ============================================================================
+const byte    MIDI_NONE             = 0;
+const byte    MIDI_NOTE_ON          = 1;
+const byte    MIDI_NOTE_OFF         = 2;
+const byte    MIDI_CC               = 3;
+const byte    MIDI_CLOCK            = 4;
+const byte    MIDI_START            = 5;
+const byte    MIDI_CONTINUE         = 6;
+const byte    MIDI_STOP             = 7;
+
+// ============================================================================
+// Channel Constants:
+// ============================================================================
+const byte    MIDI_OMNI             = 0xFF;     // Listen to all channels.
+const long    MIDI_BAUD             = 31250;    // Standard DIN MIDI baud rate.
+const byte    MIDI_HELD_MAX         = 8;        // Held notes kept for the gate.
+
+class ssbMidiIn
+{
+    private:
+        long            _baud_rate;     // Baud rate for the serial connection.
+        byte            _channel;       // Channel to listen to (0-15) or MIDI_OMNI.
+        byte            _status;        // Running status byte. 0 when there is none.
+        byte            _data[2];       // Data bytes for the current message.
+        byte            _data_index;    // Number of data bytes received for the current message.
+        byte            _data_needed;   // Number of data bytes the current status requires.
+        byte            _note;          // Note number of last note on/off.
+        byte            _velocity;      // Velocity of last note on/off.
+        byte            _cc_number;     // Controller number of last control change.
+        byte            _cc_value;      // Controller value of last control change.
+        byte            _held[MIDI_HELD_MAX]; // Held notes, oldest first.
+        byte            _held_count;    // Number of held notes.
+        bool            _in_sysex;      // In a system exclusive (or common) message, skip data.
+        unsigned int    _message_count; // Number of complete messages parsed.
+        unsigned int    _error_count;   // Stray data bytes and messages cut short.
+    public:
+        // Constructors
+        ssbMidiIn();
+        ssbMidiIn(byte channel);
+        // Destructor
+        ~ssbMidiIn();
+
+        // enable the serial input in setup.
+        void enableSerial();
+        void enableSerial(long baud_rate);
+
+        // handle input
+        // - Read (at most) one byte from the serial input and parse it.
+        //   Returns the type of message completed by the byte, or MIDI_NONE.
+        byte doRead();
+        // - Parse a single byte. Used by doRead, but may be fed from any
+        //   source (a recorded stream for example).
+        byte parseByte(byte in_byte);
+        // - Forget the running status and any partial message.
+        void reset();
+
+        // Get/Set the channel to listen to (0-15 or MIDI_OMNI).
+        byte getChannel();
+        void setChannel(byte channel);
+
+        // Values from the last completed messages.
+        byte getNote();
+        byte getVelocity();
+        byte getCCNumber();
+        byte getCCValue();
+
+        // - Monophonic gate. On while any note is held (last note
+        //   priority). getGateNote is the note holding the gate, the last
+        //   one played that is still held.
+        bool getGate();
+        byte getGateNote();
+        // - Release all held notes (also done by the All Notes Off and
+        //   All Sound Off controllers).
+        void releaseAll();
+
+        // Parser statistics. Counters wrap at 65535.
+        unsigned int getMessageCount();
+        unsigned int getErrorCount();
+        void resetStats();
+        // - Write the statistics to the serial output as a frame:
+        //   [messages,errors]
+        void reportStats();
+    private:
+        byte _do_message();
+        void _hold_note(byte note);
+        void _release_note(byte note);
+};
+
+#endif // _ssb_midi_in_class_
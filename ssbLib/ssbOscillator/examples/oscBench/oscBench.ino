@@ -0,0 +1,120 @@
+/*
+Program: oscBench
+Description:
+    Measures the ssbOscillator interrupt on the ArdCore in CPU cycles and
+    checks it against OSC_ISR_BUDGET. Timer1 runs the oscillator (CTC, no
+    prescale, one count a cycle at 16MHz, back to 0 every 1000), so it is
+    also the clock: a tight loop reads TCNT1 and keeps the largest gap
+    between two reads. The same loop is run with the interrupt off, which
+    gives its own largest gap. The difference is the most cycles the
+    interrupt took from the loop, entry and exit included. Timer0 (millis)
+    is stopped and the serial output is flushed while measuring, so
+    nothing else gets in. Each wave is measured, at the top note.
+
+    Open the serial monitor at 9600. The results repeat every 2 seconds:
+        wave 0: isr ... cycles (...%), budget 150, PASS
+        ...
+        wave 3: isr ... cycles (...%), budget 150, PASS
+
+    Uses Timer1 (through ssbOscillator) and the DAC.
+
+    Created:  Oct 18 2026 by Peter Fawcett (SoundSweepsBy).
+
+    ============================================================
+
+    License:
+
+    This software is licensed under the Creative Commons
+    "Attribution-NonCommercial license. This license allows you
+    to tweak and build upon the code for non-commercial purposes,
+    without the requirement to license derivative works on the
+    same terms. If you wish to use this (or derived) work for
+    commercial work, please contact Peter Fawcett at our website
+    (www.SoundSweepsBy.com).
+
+    For more information on the Creative Commons CC BY-NC license,
+    visit http://creativecommons.org/licenses/
+*/
+
+#include <ssbOscillator.h>
+
+const unsigned int  BENCH_READS     = 20000;    // About 300 interrupts a run.
+const unsigned int  SAMPLE_CYCLES   = F_CPU / OSC_SAMPLE_RATE;
+
+ssbOscillator osc = ssbOscillator(WAVE_SINE_ID);
+
+void setup()
+{
+    Serial.begin(9600);
+    osc.setNote(OSC_MAX_NOTE);
+    osc.begin();
+}
+
+void loop()
+{
+    for (byte wave = 0; wave < WAVE_COUNT; wave++)
+    {
+        unsigned int loop_gap;
+        unsigned int isr_gap;
+        unsigned int isr_cycles;
+        osc.setWave(wave);
+        osc.end();
+        loop_gap = maxGap();
+        osc.begin();
+        isr_gap = maxGap();
+        isr_cycles = 0;
+        if (isr_gap > loop_gap)
+        {
+            isr_cycles = isr_gap - loop_gap;
+        }
+        Serial.print("wave ");
+        Serial.print(wave);
+        Serial.print(": isr ");
+        Serial.print(isr_cycles);
+        Serial.print(" cycles (");
+        Serial.print((isr_cycles * 100.0) / SAMPLE_CYCLES, 1);
+        Serial.print("%), budget ");
+        Serial.print(OSC_ISR_BUDGET);
+        if (isr_cycles <= OSC_ISR_BUDGET)
+        {
+            Serial.println(", PASS");
+        }
+        else
+        {
+            Serial.println(", FAIL");
+        }
+    }
+    Serial.println();
+    delay(2000);
+}
+
+/* maxGap
+ - Largest gap in cycles between two reads of TCNT1, over BENCH_READS
+   reads. TCNT1 goes back to 0 after SAMPLE_CYCLES - 1 (CTC), so a read
+   below the last one has wrapped once.
+*/
+unsigned int maxGap()
+{
+    unsigned int max_gap = 0;
+    unsigned int last;
+    byte old_timsk0 = TIMSK0;
+    Serial.flush();
+    TIMSK0 = 0;
+    last = TCNT1;
+    for (unsigned int i = 0; i < BENCH_READS; i++)
+    {
+        unsigned int now = TCNT1;
+        unsigned int gap = now - last;
+        if (now < last)
+        {
+            gap += SAMPLE_CYCLES;
+        }
+        if (gap > max_gap)
+        {
+            max_gap = gap;
+        }
+        last = now;
+    }
+    TIMSK0 = old_timsk0;
+    return max_gap;
+}
@@ -0,0 +1,206 @@
+/*
+  ssbOscillator.cpp - An audio rate wavetable oscillator (or LFO) for the
+    ArdCore DAC.
+
+  Created by Peter Fawcett, Oct 18. 2026.
+    Version 0.1: Created basic ssbOscillator Obect
+    Version 0.2: Oct 18. 2026
+                    Removed the pin 13 timing hook (see oscBench).
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#include "ssbOscillator.h"
+
+// Phase increments for the top octave (notes 60 - 71, C8 - B8) at
+// OSC_SAMPLE_RATE. Lower notes shift these right one bit per octave.
+// increment = frequency * 2^32 / OSC_SAMPLE_RATE
+const unsigned long OSC_TOP_INC[12] PROGMEM = {
+    1123673247UL, 1190490335UL, 1261280574UL, 1336280220UL,
+    1415739577UL, 1499923833UL, 1589113945UL, 1683607578UL,
+    1783720094UL, 1889785610UL, 2002158110UL, 2121212627UL};
+
+// Interrupt state. Only one oscillator.
+static volatile unsigned long   osc_phase = 0;
+static volatile unsigned long   osc_inc = 0;
+static const byte* volatile     osc_table = WAVE_SINE;
+
+/* Timer1 compare interrupt
+ - Advance the phase and write the sample to the DAC. DAC bits 0-2 are
+   PORTD 5-7, bits 3-7 are PORTB 0-4 (pins 5 - 12).
+*/
+ISR(TIMER1_COMPA_vect)
+{
+    byte sample;
+    osc_phase += osc_inc;
+    sample = pgm_read_byte(osc_table + (byte)(osc_phase >> 24));
+    PORTD = (PORTD & 0x1F) | (sample << 5);
+    PORTB = (PORTB & 0xE0) | (sample >> 3);
+}
+
+// Constructors
+
+ssbOscillator::ssbOscillator()
+{
+    _note = 0;
+    _octave_down = 0;
+    _wave = WAVE_SINE_ID;
+    _running = false;
+}
+
+ssbOscillator::ssbOscillator(byte wave_id)
+{
+    _note = 0;
+    _octave_down = 0;
+    _wave = wave_id;
+    _running = false;
+}
+
+// Destructor
+
+ssbOscillator::~ssbOscillator()
+{
+    end();
+}
+
+// Oscillator Methods
+
+/* begin
+ - DAC pins to output, Timer1 to CTC mode with no prescale at
+   OSC_SAMPLE_RATE and enable the compare interrupt.
+*/
+void ssbOscillator::begin()
+{
+    DDRD |= 0xE0;
+    DDRB |= 0x1F;
+    osc_table = waveTable(_wave);
+    _update_increment();
+    TCCR1A = 0;
+    TCCR1B = _BV(WGM12) | _BV(CS10);
+    OCR1A = (F_CPU / OSC_SAMPLE_RATE) - 1;
+    TCNT1 = 0;
+    TIMSK1 = _BV(OCIE1A);
+    _running = true;
+}
+
+void ssbOscillator::end()
+{
+    if (_running == true)
+    {
+        TIMSK1 = 0;
+        _running = false;
+    }
+}
+
+void ssbOscillator::setWave(byte wave_id)
+{
+    if (wave_id != _wave)
+    {
+        // A pointer write is two bytes, keep the interrupt out.
+        uint8_t old_sreg = SREG;
+        _wave = wave_id;
+        cli();
+        osc_table = waveTable(_wave);
+        SREG = old_sreg;
+    }
+}
+
+void ssbOscillator::setNote(byte note)
+{
+    if (note > OSC_MAX_NOTE)
+    {
+        note = OSC_MAX_NOTE;
+    }
+    if (note != _note)
+    {
+        _note = note;
+        _update_increment();
+    }
+}
+
+void ssbOscillator::setPitch(int cv)
+{
+    setNote(quantizeNote(cv));
+}
+
+void ssbOscillator::setOctaveDown(byte octaves)
+{
+    if (octaves != _octave_down)
+    {
+        _octave_down = octaves;
+        _update_increment();
+    }
+}
+
+void ssbOscillator::resetPhase()
+{
+    uint8_t old_sreg = SREG;
+    cli();
+    osc_phase = 0;
+    SREG = old_sreg;
+}
+
+byte ssbOscillator::getNote()
+{
+    return _note;
+}
+
+byte ssbOscillator::getWave()
+{
+    return _wave;
+}
+
+/* quantizeNote
+ - Estimate the note from the average note spacing, then move to the
+   nearest QNOTES entry (the estimate is never more than one note out).
+*/
+byte ssbOscillator::quantizeNote(int cv)
+{
+    int note;
+    cv = constrain(cv, 0, QNOTES[OSC_MAX_NOTE]);
+    note = ((long)cv * OSC_MAX_NOTE) / QNOTES[OSC_MAX_NOTE];
+    if ((note < OSC_MAX_NOTE) && ((cv - QNOTES[note]) > (QNOTES[note + 1] - cv)))
+    {
+        note++;
+    }
+    else if ((note > 0) && ((QNOTES[note] - cv) > (cv - QNOTES[note - 1])))
+    {
+        note--;
+    }
+    return (byte)note;
+}
+
+// Private methods
+
+void ssbOscillator::_update_increment()
+{
+    unsigned long inc;
+    byte shift = (OSC_MAX_NOTE / 12) - (_note / 12) + _octave_down;
+    inc = pgm_read_dword(&OSC_TOP_INC[_note % 12]);
+    if (shift > 31)
+    {
+        inc = 0;
+    }
+    else
+    {
+        inc = inc >> shift;
+    }
+    // A 32 bit write is four bytes, keep the interrupt out.
+    uint8_t old_sreg = SREG;
+    cli();
+    osc_inc = inc;
+    SREG = old_sreg;
+}
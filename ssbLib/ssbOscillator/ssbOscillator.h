@@ -0,0 +1,101 @@
+/*
+  ssbOscillator.h - An audio rate wavetable oscillator (or LFO) for the
+    ArdCore DAC.
+    A Timer1 interrupt runs at OSC_SAMPLE_RATE. Each interrupt adds the
+    increment to a 32 bit phase accumulator (DDS), reads the wavetable
+    (ssbWaves, flash) at the top 8 bits of the phase and writes the value
+    straight to the DAC port bits. The main loop only sets the pitch and
+    wave, so it is never blocked.
+
+    Pitch is by note index into the ssbScales QNOTES table (0 - 60, C3 - C8),
+    so a 1v/oct CV can be quantized with setPitch. setOctaveDown moves the
+    whole range down for sub audio / LFO use (7 octaves down is about
+    1 - 33Hz).
+
+    The interrupt must fit in OSC_ISR_BUDGET cycles of the 1000 between
+    samples at 16kHz, the rest is the loop's. The oscBench example
+    measures it (Timer1 counted, on an ArdCore) and checks the budget.
+
+    Only one oscillator (there is one DAC). Do not use the DAC (dacOutput)
+    while it is running, or anything else that uses Timer1 (ssbProfile,
+    Servo, PWM on pins 9 and 10, ...).
+
+  Created by Peter Fawcett, Oct 18. 2026.
+    Version 0.1: Created basic ssbOscillator Obect
+    Version 0.2: Oct 18. 2026
+                    Added OSC_ISR_BUDGET and the oscBench example, which
+                    measures the interrupt, in place of the pin 13 hook.
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#ifndef _ssb_oscillator_class_
+#define _ssb_oscillator_class_
+
+#include <Arduino.h>
+#include <ssbScales.h>
+#include <ssbWaves.h>
+
+// ============================================================================
+// Oscillator Constants:
+// ============================================================================
+const long    OSC_SAMPLE_RATE       = 16000;            // Interrupt rate (Hz).
+const byte    OSC_MAX_NOTE          = NOTE_COUNT - 1;   // C8.
+const byte    OSC_LFO_OCTAVES       = 7;                // Octaves down for LFO use.
+const int     OSC_ISR_BUDGET        = 150;              // Max interrupt cycles (of 1000).
+
+class ssbOscillator
+{
+    private:
+        byte    _note;          // Note index (0 - 60, into QNOTES).
+        byte    _octave_down;   // Octaves below the note.
+        byte    _wave;          // Wave id (ssbWaves).
+        bool    _running;       // Is the interrupt running.
+    public:
+        // Constructors
+        ssbOscillator();
+        ssbOscillator(byte wave_id);
+        // Destructor
+        ~ssbOscillator();
+
+        // - Set the DAC pins to output and start the interrupt. Call in setup.
+        void begin();
+        // - Stop the interrupt. The DAC holds the last value.
+        void end();
+
+        // - Set the wave (WAVE_SINE_ID, WAVE_TRI_ID, WAVE_SAW_ID, WAVE_SQUARE_ID).
+        void setWave(byte wave_id);
+        // - Set the pitch by note index (0 - 60, C3 - C8).
+        void setNote(byte note);
+        // - Set the pitch from a 1v/oct input (0 - 1023), quantized to the
+        //   nearest note.
+        void setPitch(int cv);
+        // - Move the pitch down by a number of octaves (0 for audio,
+        //   OSC_LFO_OCTAVES for LFO).
+        void setOctaveDown(byte octaves);
+        // - Restart the wave at phase 0 (hard sync / LFO reset).
+        void resetPhase();
+
+        byte getNote();
+        byte getWave();
+
+        // - Nearest note index (0 - 60) for a 1v/oct input (0 - 1023).
+        static byte quantizeNote(int cv);
+    private:
+        void _update_increment();
+};
+
+#endif // _ssb_oscillator_class_
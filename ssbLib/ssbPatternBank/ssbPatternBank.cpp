@@ -0,0 +1,267 @@
+/*
+  ssbPatternBank.cpp - EEPROM pattern banks for ArdCore step sequencers.
+
+  Created by Peter Fawcett, Oct 18. 2026.
+    Version 0.1: Created basic ssbPatternBank Obect
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#include "ssbPatternBank.h"
+
+// Constructors
+
+ssbPatternBank::ssbPatternBank()
+{
+    for (byte i = 0; i < PBANK_COUNT; i++)
+    {
+        _newest[i] = PBANK_NONE;
+        _seq[i] = 0;
+    }
+    for (byte i = 0; i < PBANK_STEPS; i++)
+    {
+        _steps[i] = 0;
+    }
+    _length = 1;
+    _bank = PBANK_NONE;
+    _write_pos = PBANK_RECORD_SIZE;
+    _write_bank = 0;
+    _write_copy = 0;
+    _write_start = 0;
+    _write_ms = 0;
+    _load_us = 0;
+    _error_count = 0;
+}
+
+// Destructor
+
+ssbPatternBank::~ssbPatternBank(){/*nothing to destruct*/}
+
+// Bank Methods
+
+/* begin
+ - Read every slot and keep the newest good record of each bank. The
+   sequence numbers of a bank are never more than PBANK_COPIES apart, so
+   a signed difference finds the newest across the 255 -> 0 wrap.
+*/
+void ssbPatternBank::begin()
+{
+    byte record[PBANK_RECORD_SIZE];
+    for (byte bank = 0; bank < PBANK_COUNT; bank++)
+    {
+        _newest[bank] = PBANK_NONE;
+        for (byte copy = 0; copy < PBANK_COPIES; copy++)
+        {
+            if (_read_record(bank, copy, record) == false)
+            {
+                continue;
+            }
+            if ((_newest[bank] == PBANK_NONE) ||
+                ((signed char)(record[PBANK_SEQ_OFS] - _seq[bank]) > 0))
+            {
+                _newest[bank] = copy;
+                _seq[bank] = record[PBANK_SEQ_OFS];
+            }
+        }
+    }
+}
+
+bool ssbPatternBank::isValid(byte bank)
+{
+    if (bank >= PBANK_COUNT)
+    {
+        return false;
+    }
+    return (_newest[bank] != PBANK_NONE);
+}
+
+/* load
+ - Copy the newest record of a bank to SRAM. 20 EEPROM reads and a
+   checksum, so it is quick, but it is only done on a bank change.
+*/
+bool ssbPatternBank::load(byte bank)
+{
+    byte record[PBANK_RECORD_SIZE];
+    unsigned long start = micros();
+    if (isValid(bank) == false)
+    {
+        return false;
+    }
+    if (_read_record(bank, _newest[bank], record) == false)
+    {
+        return false;
+    }
+    for (byte i = 0; i < PBANK_STEPS; i++)
+    {
+        _steps[i] = record[PBANK_STEP_OFS + i];
+    }
+    _length = record[PBANK_LEN_OFS];
+    _bank = bank;
+    _load_us = micros() - start;
+    return true;
+}
+
+const byte* ssbPatternBank::getSteps()
+{
+    return _steps;
+}
+
+byte ssbPatternBank::getLength()
+{
+    return _length;
+}
+
+byte ssbPatternBank::getBank()
+{
+    return _bank;
+}
+
+/* write
+ - Build the record in the write buffer. It goes to the slot after the
+   newest, with the next sequence number.
+*/
+bool ssbPatternBank::write(byte bank, const byte* steps, byte length)
+{
+    byte sum1;
+    byte sum2;
+    if ((isBusy() == true) || (bank >= PBANK_COUNT) ||
+        (length == 0) || (length > PBANK_STEPS))
+    {
+        return false;
+    }
+    _write_bank = bank;
+    if (_newest[bank] == PBANK_NONE)
+    {
+        _write_copy = 0;
+        _write_buf[PBANK_SEQ_OFS] = 0;
+    }
+    else
+    {
+        _write_copy = (_newest[bank] + 1) % PBANK_COPIES;
+        _write_buf[PBANK_SEQ_OFS] = _seq[bank] + 1;
+    }
+    _write_buf[PBANK_LEN_OFS] = length;
+    for (byte i = 0; i < PBANK_STEPS; i++)
+    {
+        if (i < length)
+        {
+            _write_buf[PBANK_STEP_OFS + i] = steps[i];
+        }
+        else
+        {
+            _write_buf[PBANK_STEP_OFS + i] = 0;
+        }
+    }
+    _checksum(_write_buf, &sum1, &sum2);
+    _write_buf[PBANK_SUM_OFS] = sum1;
+    _write_buf[PBANK_SUM_OFS + 1] = sum2;
+    _write_pos = 0;
+    _write_start = millis();
+    return true;
+}
+
+/* update
+ - Write one byte if the EEPROM is not busy with the last one. Once the
+   record is written it is read back, and only then becomes the newest.
+*/
+bool ssbPatternBank::update()
+{
+    byte record[PBANK_RECORD_SIZE];
+    if ((isBusy() == false) || (eeprom_is_ready() == false))
+    {
+        return false;
+    }
+    eeprom_update_byte((uint8_t*)(_addr(_write_bank, _write_copy) + _write_pos),
+                       _write_buf[_write_pos]);
+    _write_pos++;
+    if (_write_pos < PBANK_RECORD_SIZE)
+    {
+        return false;
+    }
+    // eeprom_read_block waits for the last byte to finish.
+    if (_read_record(_write_bank, _write_copy, record) == true)
+    {
+        _newest[_write_bank] = _write_copy;
+        _seq[_write_bank] = record[PBANK_SEQ_OFS];
+    }
+    else
+    {
+        _error_count++;
+    }
+    _write_ms = millis() - _write_start;
+    return true;
+}
+
+bool ssbPatternBank::isBusy()
+{
+    return (_write_pos < PBANK_RECORD_SIZE);
+}
+
+unsigned long ssbPatternBank::getLoadMicros()
+{
+    return _load_us;
+}
+
+unsigned long ssbPatternBank::getWriteMillis()
+{
+    return _write_ms;
+}
+
+unsigned int ssbPatternBank::getErrorCount()
+{
+    return _error_count;
+}
+
+// Private methods
+
+unsigned int ssbPatternBank::_addr(byte bank, byte copy)
+{
+    return PBANK_BASE_ADDR + ((unsigned int)bank * PBANK_COPIES + copy) * PBANK_RECORD_SIZE;
+}
+
+/* _read_record
+ - Read a slot. Returns false if the length or the checksum is bad (an
+   erased slot is all 0xFF, which fails both).
+*/
+bool ssbPatternBank::_read_record(byte bank, byte copy, byte* record)
+{
+    byte sum1;
+    byte sum2;
+    eeprom_read_block(record, (const void*)_addr(bank, copy), PBANK_RECORD_SIZE);
+    if ((record[PBANK_LEN_OFS] == 0) || (record[PBANK_LEN_OFS] > PBANK_STEPS))
+    {
+        return false;
+    }
+    _checksum(record, &sum1, &sum2);
+    return ((record[PBANK_SUM_OFS] == sum1) && (record[PBANK_SUM_OFS + 1] == sum2));
+}
+
+/* _checksum
+ - Fletcher-16 of the record up to the sums. Unlike a plain sum it also
+   catches swapped bytes.
+*/
+void ssbPatternBank::_checksum(const byte* record, byte* sum1, byte* sum2)
+{
+    unsigned int s1 = 0;
+    unsigned int s2 = 0;
+    for (byte i = 0; i < PBANK_SUM_OFS; i++)
+    {
+        s1 = (s1 + record[i]) % 255;
+        s2 = (s2 + s1) % 255;
+    }
+    *sum1 = s1;
+    *sum2 = s2;
+}
@@ -0,0 +1,121 @@
+/*
+  ssbPatternBank.h - EEPROM pattern banks for ArdCore step sequencers.
+    Keeps PBANK_COUNT patterns (ssbSequencer step bytes, up to
+    PBANK_STEPS steps) in EEPROM so they can be changed over serial with
+    out a reflash.
+
+    Each bank has PBANK_COPIES record slots. A write goes to the slot
+    after the newest one, so the writes for a bank are spread over all of
+    its slots (wear levelling), and the newest good record is never
+    written over. A record is:
+      sequence, length, steps[PBANK_STEPS], fletcher sum 1, sum 2
+    The newest record is the one with the highest sequence number (8 bit,
+    wrapping) and a good checksum, so a write cut short (power off) falls
+    back to the record before it.
+
+    Writes do not block. write copies the record to a buffer and update
+    (call every loop) writes one byte each time the EEPROM is ready
+    (about 3.4ms a byte). load copies a bank to SRAM, and a sequencer
+    plays it from there (ssbSequencer::setRamPattern), so the clock path
+    never reads the EEPROM. The time of the last load (us) and the last
+    write (ms) are kept so both can be checked.
+
+  Created by Peter Fawcett, Oct 18. 2026.
+    Version 0.1: Created basic ssbPatternBank Obect
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#ifndef _ssb_pattern_bank_class_
+#define _ssb_pattern_bank_class_
+
+#include <Arduino.h>
+#include <avr/eeprom.h>
+
+// ============================================================================
+// Bank Constants:
+// ============================================================================
+const byte    PBANK_COUNT           = 8;
+const byte    PBANK_COPIES          = 6;        // Record slots per bank.
+const byte    PBANK_STEPS           = 16;
+const byte    PBANK_NONE            = 0xFF;     // No bank / no record.
+const unsigned int PBANK_BASE_ADDR  = 0;        // First EEPROM byte used.
+
+// ============================================================================
+// Record Layout:
+// ============================================================================
+const byte    PBANK_SEQ_OFS         = 0;
+const byte    PBANK_LEN_OFS         = 1;
+const byte    PBANK_STEP_OFS        = 2;
+const byte    PBANK_SUM_OFS         = PBANK_STEP_OFS + PBANK_STEPS;
+const byte    PBANK_RECORD_SIZE     = PBANK_SUM_OFS + 2;
+// 8 banks * 6 copies * 20 bytes = 960 of the 1024 EEPROM bytes.
+
+class ssbPatternBank
+{
+    private:
+        byte            _newest[PBANK_COUNT];   // Slot of the newest record, PBANK_NONE if none.
+        byte            _seq[PBANK_COUNT];      // Sequence number of the newest record.
+        byte            _steps[PBANK_STEPS];    // Loaded pattern.
+        byte            _length;                // Loaded pattern length.
+        byte            _bank;                  // Loaded bank, PBANK_NONE if none.
+        byte            _write_buf[PBANK_RECORD_SIZE];
+        byte            _write_pos;             // Next byte to write, PBANK_RECORD_SIZE when idle.
+        byte            _write_bank;
+        byte            _write_copy;
+        unsigned long   _write_start;           // millis() when the write was queued.
+        unsigned long   _write_ms;              // Time of the last write.
+        unsigned long   _load_us;               // Time of the last load.
+        unsigned int    _error_count;           // Writes that did not read back.
+    public:
+        // Constructors
+        ssbPatternBank();
+        // Destructor
+        ~ssbPatternBank();
+
+        // - Find the newest record of each bank. Call in setup.
+        void begin();
+        // - Does the bank hold a pattern.
+        bool isValid(byte bank);
+        // - Copy a bank to SRAM. Returns false (and keeps the loaded
+        //   pattern) if the bank is empty.
+        bool load(byte bank);
+        // - Loaded pattern, for ssbSequencer::setRamPattern.
+        const byte* getSteps();
+        byte getLength();
+        byte getBank();
+
+        // - Queue a pattern to write. Returns false if a write is still in
+        //   progress or the bank or length is out of range.
+        bool write(byte bank, const byte* steps, byte length);
+        // - Write the next byte if the EEPROM is ready. Call every loop.
+        //   Returns true on the call that finishes a write.
+        bool update();
+        bool isBusy();
+
+        // - Time of the last load (us) and the last write (ms, queue to
+        //   read back).
+        unsigned long getLoadMicros();
+        unsigned long getWriteMillis();
+        // - Writes that did not read back with a good checksum.
+        unsigned int getErrorCount();
+    private:
+        unsigned int _addr(byte bank, byte copy);
+        bool _read_record(byte bank, byte copy, byte* record);
+        static void _checksum(const byte* record, byte* sum1, byte* sum2);
+};
+
+#endif // _ssb_pattern_bank_class_
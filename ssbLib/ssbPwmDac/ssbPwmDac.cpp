@@ -0,0 +1,75 @@
+/*
+  ssbPwmDac.cpp - A second (PWM) CV out on pin 11 for ArdCore patches.
+
+  Created by Peter Fawcett, Oct 18. 2026.
+    Version 0.1: Created basic ssbPwmDac Obect
+    Version 0.2: Oct 18. 2026
+                    Inverted PWM, 0 is a steady 0.
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#include "ssbPwmDac.h"
+
+// Constructors
+
+ssbPwmDac::ssbPwmDac()
+{
+    _value = 0;
+    _running = false;
+}
+
+// Destructor
+
+ssbPwmDac::~ssbPwmDac(){/*nothing to destruct*/}
+
+// PWM DAC Methods
+
+/* begin
+ - Timer2 fast PWM (WGM21, WGM20), inverting on OC2A (COM2A1, COM2A0), no
+   prescale (CS20). No interrupts. Inverted, the pin is high from the
+   compare match to the top: (255 - OCR2A) / 256 of the cycle, and OCR2A
+   at 255 (the top) holds it low.
+*/
+void ssbPwmDac::begin()
+{
+    pinMode(PWM_DAC_PIN, OUTPUT);
+    OCR2A = 255 - _value;
+    TCCR2A = _BV(COM2A1) | _BV(COM2A0) | _BV(WGM21) | _BV(WGM20);
+    TCCR2B = _BV(CS20);
+    _running = true;
+}
+
+void ssbPwmDac::end()
+{
+    if (_running == true)
+    {
+        TCCR2A = 0;
+        TCCR2B = 0;
+        _running = false;
+    }
+}
+
+void ssbPwmDac::output(long value)
+{
+    _value = (byte)(constrain(value, 0, 1023) >> 2);
+    OCR2A = 255 - _value;
+}
+
+byte ssbPwmDac::getValue()
+{
+    return _value;
+}
@@ -0,0 +1,78 @@
+/*
+  ssbPwmDac.h - A second (PWM) CV out on pin 11 for ArdCore patches.
+    Timer2 runs in fast PWM mode with no prescale, so the carrier is
+    F_CPU / 256 (62.5kHz at 16MHz) with 8 bit (256 step) duty resolution.
+    That is the fastest carrier Timer2 can give at 8 bits and is well above
+    the audio range, so a simple RC filter on the output gives a clean CV.
+    output takes the same 0 - 1023 value as dacOutput and costs one
+    register write (OCR2A), the duty changes at the next PWM cycle.
+    The output is inverted (COM2A1 and COM2A0) with OCR2A = 255 - value, so
+    the duty is exactly value / 256 as on the DAC: 0 is a steady low, where
+    non inverted fast PWM gives a 1 / 256 spike for 0 and can not reach 0.
+
+    NOTE: pin 11 is also bit 6 of the ArdCore DAC (and of the output
+    expander bits). While the PWM is on, the timer drives the pin, so
+    writes to DAC bit 6 are lost. Use it in patches that do not need the
+    main DAC (or only need it for the other expander bits), or call end
+    to give the pin back. Mask PWM_DAC_BIT out of anything written to the
+    DAC port (see ssbMonoADSR_PWM), so the pin is low when end is called.
+    Also do not use tone() or anything else that uses Timer2.
+
+  Created by Peter Fawcett, Oct 18. 2026.
+    Version 0.1: Created basic ssbPwmDac Obect
+    Version 0.2: Oct 18. 2026
+                    Inverted PWM, so a value of 0 is a steady 0 (no spike)
+                    and each of the 256 steps is 1 / 256 of full scale.
+                    Added PWM_DAC_BIT.
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#ifndef _ssb_pwm_dac_class_
+#define _ssb_pwm_dac_class_
+
+#include <Arduino.h>
+
+// ============================================================================
+// PWM DAC Constants:
+// ============================================================================
+const int     PWM_DAC_PIN           = 11;                   // OC2A.
+const long    PWM_DAC_CARRIER_HZ    = F_CPU / 256;          // 62.5kHz at 16MHz.
+const int     PWM_DAC_STEPS         = 256;                  // Duty resolution.
+const byte    PWM_DAC_BIT           = B01000000;            // Pin 11 as a DAC / expander bit (6).
+
+class ssbPwmDac
+{
+    private:
+        byte    _value;         // Current duty (0 - 255).
+        bool    _running;       // Is the PWM running.
+    public:
+        // Constructors
+        ssbPwmDac();
+        // Destructor
+        ~ssbPwmDac();
+
+        // - Set pin 11 to output and start the PWM. Call in setup.
+        void begin();
+        // - Stop the PWM and give pin 11 back to the DAC (port) writes.
+        void end();
+        // - Write a value (0 - 1023, the same as dacOutput).
+        void output(long value);
+        // - Current duty (0 - 255).
+        byte getValue();
+};
+
+#endif // _ssb_pwm_dac_class_
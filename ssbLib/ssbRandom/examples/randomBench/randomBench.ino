@@ -0,0 +1,130 @@
+/*
+Program: randomBench
+Description:
+    Measures the cost of ssbRandom on the ArdCore in CPU cycles, against the
+    Arduino random(0, 100) it replaced in the patches. Timer1 runs free with
+    no prescale (one count a cycle at 16MHz), each test is timed over
+    BENCH_CALLS calls with interrupts off, BENCH_REPS times, and the cost of
+    the timing loop (the empty test) is taken off.
+
+    Open the serial monitor at 9600. The results repeat every 2 seconds:
+        empty              0 cycles
+        next16            ...
+        chance            ...
+        random(0, 100)    ...
+
+    Uses Timer1, do not use with anything else that does (ssbProfile,
+    ssbTrigQueue, ssbOscillator, Servo).
+
+    Created:  Oct 18 2026 by Peter Fawcett (SoundSweepsBy).
+
+    ============================================================
+
+    License:
+
+    This software is licensed under the Creative Commons
+    "Attribution-NonCommercial license. This license allows you
+    to tweak and build upon the code for non-commercial purposes,
+    without the requirement to license derivative works on the
+    same terms. If you wish to use this (or derived) work for
+    commercial work, please contact Peter Fawcett at our website
+    (www.SoundSweepsBy.com).
+
+    For more information on the Creative Commons CC BY-NC license,
+    visit http://creativecommons.org/licenses/
+*/
+
+#include <ssbRandom.h>
+
+const byte    BENCH_CALLS       = 16;   // Calls timed at once (random() x 16 fits in 16 bits).
+const int     BENCH_REPS        = 64;   // Timed runs of each test.
+
+const byte    BENCH_EMPTY       = 0;
+const byte    BENCH_NEXT16      = 1;
+const byte    BENCH_NEXT8       = 2;
+const byte    BENCH_CHANCE      = 3;
+const byte    BENCH_THRESHOLD   = 4;
+const byte    BENCH_RANDOM      = 5;
+const byte    BENCH_RANDOM_PCT  = 6;
+const byte    BENCH_TESTS       = 7;
+
+const char*   BENCH_NAMES[BENCH_TESTS] = {"empty", "next16", "next8", "chance",
+                                          "percentToThreshold", "random(256)",
+                                          "random(0, 100) < pct"};
+
+ssbRandom     rand_gen          = ssbRandom();
+unsigned int  threshold         = 0;
+volatile byte percent           = 30;   // volatile, so it is not folded in.
+volatile int  sink              = 0;    // Results go here, so no call is dropped.
+
+void setup()
+{
+    Serial.begin(9600);
+    rand_gen.seedFromNoise(A5);
+    randomSeed(analogRead(A5));
+    threshold = ssbRandom::percentToThreshold(percent);
+    // Timer1 free running, no prescale.
+    TCCR1A = 0;
+    TCCR1B = _BV(CS10);
+    TIMSK1 = 0;
+}
+
+void loop()
+{
+    unsigned long empty = benchCycles(BENCH_EMPTY);
+    for (byte test = 0; test < BENCH_TESTS; test++)
+    {
+        unsigned long total = benchCycles(test);
+        Serial.print(BENCH_NAMES[test]);
+        Serial.print(": ");
+        Serial.print((total - empty) / ((unsigned long)BENCH_CALLS * BENCH_REPS));
+        Serial.println(" cycles");
+    }
+    Serial.println();
+    delay(2000);
+}
+
+/* runTest
+ - One call of a test. Not inlined, so each test pays the same call and
+   switch, which the empty test measures.
+*/
+int __attribute__ ((noinline)) runTest(byte test)
+{
+    switch (test)
+    {
+        case BENCH_NEXT16:
+            return rand_gen.next16();
+        case BENCH_NEXT8:
+            return rand_gen.next8();
+        case BENCH_CHANCE:
+            return rand_gen.chance(threshold);
+        case BENCH_THRESHOLD:
+            return ssbRandom::percentToThreshold(percent);
+        case BENCH_RANDOM:
+            return random(256);
+        case BENCH_RANDOM_PCT:
+            return (random(0, 100) < percent);
+        default:
+            return 0;
+    }
+}
+
+unsigned long benchCycles(byte test)
+{
+    unsigned long total = 0;
+    for (int rep = 0; rep < BENCH_REPS; rep++)
+    {
+        unsigned int start;
+        unsigned int end;
+        noInterrupts();
+        start = TCNT1;
+        for (byte i = 0; i < BENCH_CALLS; i++)
+        {
+            sink += runTest(test);
+        }
+        end = TCNT1;
+        interrupts();
+        total += (unsigned int)(end - start);
+    }
+    return total;
+}
@@ -0,0 +1,104 @@
+/*
+  ssbRandom.cpp - A fast random number generator for ArdCore patches.
+
+  Created by Peter Fawcett, Oct 18. 2026.
+    Version 0.1: Created basic ssbRandom Obect
+    Version 0.2: Oct 18. 2026
+                    16 bit state on any target.
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#include "ssbRandom.h"
+
+// Constructors
+
+ssbRandom::ssbRandom()
+{
+    _state = 1;
+}
+
+ssbRandom::ssbRandom(unsigned int seed)
+{
+    _state = 1;
+    this->seed(seed);
+}
+
+// Destructor
+
+ssbRandom::~ssbRandom(){/*nothing to destruct*/}
+
+// Random Methods
+
+void ssbRandom::seed(unsigned int seed)
+{
+    _state = seed;
+    if (_state == 0)
+    {
+        _state = 1;
+    }
+}
+
+/* seedFromNoise
+ - Only the low bit of each read is used, it is the one that moves with
+   noise on a knob or an open jack. micros fills in if the pin is quiet.
+*/
+void ssbRandom::seedFromNoise(byte pin)
+{
+    unsigned int noise = 0;
+    for (byte i = 0; i < RAND_NOISE_READS; i++)
+    {
+        noise = (noise << 1) | (analogRead(pin) & 1);
+    }
+    seed(noise ^ (unsigned int)micros());
+    // Mix the seed in, close seeds start close together.
+    for (byte i = 0; i < 4; i++)
+    {
+        next16();
+    }
+}
+
+/* next16
+ - 16 bit xorshift (7, 9, 8). The left shifts drop the bits above 16 when
+   stored back to the uint16_t state.
+*/
+unsigned int ssbRandom::next16()
+{
+    _state ^= _state << 7;
+    _state ^= _state >> 9;
+    _state ^= _state << 8;
+    return _state;
+}
+
+byte ssbRandom::next8()
+{
+    return next16() >> 8;
+}
+
+bool ssbRandom::chance(unsigned int threshold)
+{
+    return (next8() < threshold);
+}
+
+/* percentToThreshold
+ - Rounded percent of 256. Do this when the control changes, not for
+   each roll.
+*/
+unsigned int ssbRandom::percentToThreshold(byte percent)
+{
+    percent = min(percent, 100);
+    return (((unsigned int)percent * RAND_ALWAYS) + 50) / 100;
+}
@@ -0,0 +1,74 @@
+/*
+  ssbRandom.h - A fast random number generator for ArdCore patches.
+    A 16 bit xorshift (shifts 7, 9, 8). Each number is three shifts and
+    three xors, no multiply or divide. Arduino random(0, 100) is the libc
+    random() (32 bit math) plus a 32 bit modulo, which is slow on the AVR
+    and too slow for the clock path.
+
+    next8 is the high byte of the 16 bit state (the low byte of a 16 bit
+    xorshift is the weaker one). The state repeats after 65535 numbers.
+
+    For a chance (a probability), work the percent out once into a
+    threshold when the control changes (percentToThreshold), then each
+    roll is one number and a compare (chance).
+
+  Created by Peter Fawcett, Oct 18. 2026.
+    Version 0.1: Created basic ssbRandom Obect
+    Version 0.2: Oct 18. 2026
+                    The state is a uint16_t, so the xorshift gives the same
+                    numbers where int is wider than 16 bits (host builds).
+                    Quality and cost are measured by hostTest/randomTest and,
+                    on the ArdCore, by the randomBench example.
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#ifndef _ssb_random_class_
+#define _ssb_random_class_
+
+#include <Arduino.h>
+
+// ============================================================================
+// Random Constants:
+// ============================================================================
+const unsigned int  RAND_ALWAYS             = 256;  // Threshold of a 100% chance.
+const byte          RAND_NOISE_READS        = 16;   // ADC reads for seedFromNoise.
+
+class ssbRandom
+{
+    private:
+        uint16_t        _state;                     // xorshift state (never 0), 16 bits on any target.
+    public:
+        // Constructors
+        ssbRandom();
+        ssbRandom(unsigned int seed);
+        // Destructor
+        ~ssbRandom();
+
+        // - Seed the generator (0 is taken as 1).
+        void seed(unsigned int seed);
+        // - Seed from the low bit of RAND_NOISE_READS reads of an analog
+        //   pin (ADC noise), mixed with micros.
+        void seedFromNoise(byte pin);
+        unsigned int next16();
+        byte next8();
+        // - True threshold times in 256 (0 - RAND_ALWAYS).
+        bool chance(unsigned int threshold);
+        // - Threshold for a percent (0 - 100) chance.
+        static unsigned int percentToThreshold(byte percent);
+};
+
+#endif // _ssb_random_class_
@@ -4,6 +4,9 @@
   Created by Peter Fawcett, Jan 23. 2015.
     Version 0.1: Implemented / moved over from working code, the base
                  set of functionality.
+    Version 0.2: Oct 18. 2026
+                 Added a constant time quantize (quantizeIndex) and scale
+                 masks.
 
 ============================================================
 
@@ -25,6 +28,7 @@ visit http://creativecommons.org/licenses/
 #define _ssb_scales_
 
 #include <Arduino.h>
+#include <avr/pgmspace.h>
 
 // ============================================================================
 // Quantized Voltage Map:
@@ -41,6 +45,45 @@ const  int      QNOTES[(NOTE_COUNT)]    = {
     810, 827, 844, 862, 879, 896, 913, 930, 947, 964, 981, 998, // OCT7
    1015};
 
+// ============================================================================
+// Quantize:
+// QNOTE_INDEX maps an input value >> 2 (0 - 255) to the QNOTES index at the
+// bottom of that range of 4 values. The notes are more than 4 apart, so at
+// most one more compare finds the note. quantizeIndex(analogRead(A2_INPUT))
+// is the index of the highest note at or below the input (the same as a
+// search of QNOTES from the bottom), with out the search.
+// ============================================================================
+
+const   byte    QNOTE_INDEX[256] PROGMEM = {
+     0,  0,  0,  1,  1,  1,  1,  2,  2,  2,  2,  3,  3,  3,  3,  4,
+     4,  4,  4,  4,  5,  5,  5,  5,  6,  6,  6,  6,  7,  7,  7,  7,
+     8,  8,  8,  8,  8,  9,  9,  9,  9, 10, 10, 10, 10, 11, 11, 11,
+    11, 11, 12, 12, 12, 12, 13, 13, 13, 13, 14, 14, 14, 14, 15, 15,
+    15, 15, 15, 16, 16, 16, 16, 17, 17, 17, 17, 18, 18, 18, 18, 19,
+    19, 19, 19, 19, 20, 20, 20, 20, 21, 21, 21, 21, 22, 22, 22, 22,
+    23, 23, 23, 23, 23, 24, 24, 24, 24, 25, 25, 25, 25, 26, 26, 26,
+    26, 27, 27, 27, 27, 27, 28, 28, 28, 28, 29, 29, 29, 29, 30, 30,
+    30, 30, 30, 31, 31, 31, 31, 32, 32, 32, 32, 33, 33, 33, 33, 34,
+    34, 34, 34, 34, 35, 35, 35, 35, 36, 36, 36, 36, 37, 37, 37, 37,
+    38, 38, 38, 38, 38, 39, 39, 39, 39, 40, 40, 40, 40, 41, 41, 41,
+    41, 42, 42, 42, 42, 42, 43, 43, 43, 43, 44, 44, 44, 44, 45, 45,
+    45, 45, 46, 46, 46, 46, 46, 47, 47, 47, 47, 48, 48, 48, 48, 49,
+    49, 49, 49, 50, 50, 50, 50, 50, 51, 51, 51, 51, 52, 52, 52, 52,
+    53, 53, 53, 53, 53, 54, 54, 54, 54, 55, 55, 55, 55, 56, 56, 56,
+    56, 57, 57, 57, 57, 57, 58, 58, 58, 58, 59, 59, 59, 59, 60, 60};
+
+inline int quantizeIndex(int value)
+{
+    int index;
+    value = constrain(value, 0, 1023);
+    index = pgm_read_byte(&QNOTE_INDEX[value >> 2]);
+    if ((index < (NOTE_COUNT - 1)) && (value >= QNOTES[index + 1]))
+    {
+        index++;
+    }
+    return index;
+}
+
 // ============================================================================
 // Note Constants:
 // These constants may be used to reference values in the QNOTES array from
@@ -112,5 +155,18 @@ const   int     PENTA_MAJOR_SCALE[PENTA_MAJOR_SCALE_LEN] = {0, 2, 4, 7, 9};
 const   int     PENTA_MINOR_SCALE_LEN   = 5;
 const   int     PENTA_MINOR_SCALE[PENTA_MINOR_SCALE_LEN] = {0, 3, 5, 7, 10};
 
+// ============================================================================
+// Scale Masks:
+// One bit per semitone above the root (bit 0 is the root, bit 11 is the
+// major 7th). Used by ssbHarmonizer to stay in key. For example
+// (MAJOR_SCALE_MASK >> E_NOTE) & 1 is 1 as E is in C major.
+// ============================================================================
+
+const   unsigned int CHROMATIC_SCALE_MASK   = 0x0FFF;
+const   unsigned int MAJOR_SCALE_MASK       = 0x0AB5;   // 0, 2, 4, 5, 7, 9, 11
+const   unsigned int MINOR_SCALE_MASK       = 0x05AD;   // 0, 2, 3, 5, 7, 8, 10
+const   unsigned int PENTA_MAJOR_SCALE_MASK = 0x0295;   // 0, 2, 4, 7, 9
+const   unsigned int PENTA_MINOR_SCALE_MASK = 0x04A9;   // 0, 3, 5, 7, 10
+
 #endif /* _ssb_scales_ */
 
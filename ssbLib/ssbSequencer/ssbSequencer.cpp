@@ -0,0 +1,325 @@
+/*
+  ssbSequencer.cpp - A step sequencer engine for ArdCore patches.
+
+  Created by Peter Fawcett, Oct 18. 2026.
+    Version 0.1: Created basic ssbSequencer Obect
+    Version 0.2: Oct 18. 2026
+                    Added SRAM patterns.
+    Version 0.3: Oct 18. 2026
+                    Added step lanes.
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#include "ssbSequencer.h"
+
+// Constructors
+
+ssbSequencer::ssbSequencer()
+{
+    _pattern = 0;
+    _in_ram = false;
+    _lanes = 0;
+    _length = 1;
+    _direction = SEQ_FORWARD;
+    reset();
+}
+
+ssbSequencer::ssbSequencer(const byte* pattern, byte length)
+{
+    _direction = SEQ_FORWARD;
+    setPattern(pattern, length);
+}
+
+// Destructor
+
+ssbSequencer::~ssbSequencer(){/*nothing to destruct*/}
+
+// Sequencer Methods
+
+void ssbSequencer::setPattern(const byte* pattern, byte length)
+{
+    _pattern = pattern;
+    _in_ram = false;
+    _lanes = 0;
+    _length = constrain(length, 1, SEQ_MAX_LENGTH);
+    reset();
+}
+
+void ssbSequencer::setRamPattern(const byte* pattern, byte length)
+{
+    _pattern = pattern;
+    _in_ram = true;
+    _lanes = 0;
+    _length = constrain(length, 1, SEQ_MAX_LENGTH);
+    reset();
+}
+
+void ssbSequencer::setLength(byte length)
+{
+    _length = constrain(length, 1, SEQ_MAX_LENGTH);
+    if (_step >= _length)
+    {
+        _step = _length - 1;
+    }
+    _calc_next();
+}
+
+void ssbSequencer::setLanes(const byte* lanes)
+{
+    _lanes = lanes;
+}
+
+void ssbSequencer::seed(unsigned int seed)
+{
+    _rand.seed(seed);
+}
+
+void ssbSequencer::setDirection(byte direction)
+{
+    if ((direction < SEQ_DIRECTION_COUNT) && (direction != _direction))
+    {
+        _direction = direction;
+        if (_started == false)
+        {
+            // Pick the first step for the new direction.
+            reset();
+        }
+        else
+        {
+            _rising = (_direction != SEQ_REVERSE);
+            _calc_next();
+        }
+    }
+}
+
+/* advance
+ - Move to the step worked out last time, read it and work out the next.
+   The probability roll is a compare of the top 2 bits of a random byte
+   with the lane value, p of 1 - 3 plays (4 - p) / 4 of the time.
+*/
+byte ssbSequencer::advance()
+{
+    byte prob;
+    _step = _next_step;
+    _started = true;
+    if (_pattern != 0)
+    {
+        _data = _read_step(_step);
+    }
+    _lane = 0;
+    if (_lanes != 0)
+    {
+        _lane = pgm_read_byte(_lanes + _step);
+    }
+    prob = _lane & SEQ_PROB_MASK;
+    _played = true;
+    if (prob != SEQ_PROB_100)
+    {
+        _played = ((_rand.next8() >> 6) >= prob);
+    }
+    _calc_next();
+    return _step;
+}
+
+void ssbSequencer::reset()
+{
+    _started = false;
+    _rising = (_direction != SEQ_REVERSE);
+    _step = 0;
+    _data = SEQ_REST;
+    _lane = 0;
+    _played = true;
+    if (_direction == SEQ_REVERSE)
+    {
+        _next_step = _length - 1;
+    }
+    else if (_direction == SEQ_RANDOM)
+    {
+        _next_step = ((unsigned int)_rand.next8() * _length) >> 8;
+    }
+    else
+    {
+        _next_step = 0;
+    }
+}
+
+byte ssbSequencer::getStep()
+{
+    return _step;
+}
+
+byte ssbSequencer::getNextStep()
+{
+    return _next_step;
+}
+
+byte ssbSequencer::getLength()
+{
+    return _length;
+}
+
+int ssbSequencer::getOffset()
+{
+    return stepOffset(_data);
+}
+
+bool ssbSequencer::isRest()
+{
+    return ((_data & SEQ_OFFSET_MASK) == SEQ_REST);
+}
+
+bool ssbSequencer::isTie()
+{
+    return ((_data & SEQ_TIE) != 0);
+}
+
+bool ssbSequencer::isAccent()
+{
+    return ((_data & SEQ_ACCENT) != 0);
+}
+
+byte ssbSequencer::getLane()
+{
+    return _lane;
+}
+
+bool ssbSequencer::isPlayed()
+{
+    return _played;
+}
+
+byte ssbSequencer::getRatchet()
+{
+    return ((_lane & SEQ_RATCHET_MASK) >> 2) + 1;
+}
+
+byte ssbSequencer::getGateQuarters()
+{
+    return 4 - ((_lane & SEQ_GATE_MASK) >> 4);
+}
+
+/* getOctave
+ - Sign extend the 2 bit octave.
+*/
+int ssbSequencer::getOctave()
+{
+    int octave = (_lane & SEQ_OCT_MASK) >> 6;
+    if (octave & 0x02)
+    {
+        octave -= 4;
+    }
+    return octave;
+}
+
+byte ssbSequencer::peekNext()
+{
+    if (_pattern == 0)
+    {
+        return SEQ_REST;
+    }
+    return _read_step(_next_step);
+}
+
+/* stepOffset
+ - Sign extend the 6 bit offset.
+*/
+int ssbSequencer::stepOffset(byte data)
+{
+    int offset = data & SEQ_OFFSET_MASK;
+    if (offset & SEQ_REST)
+    {
+        offset -= 64;
+    }
+    return offset;
+}
+
+// Private methods
+
+void ssbSequencer::_calc_next()
+{
+    if (_started == false)
+    {
+        // Next advance plays the first step (set by reset).
+        if (_next_step >= _length)
+        {
+            _next_step = 0;
+        }
+        return;
+    }
+    switch (_direction)
+    {
+        case SEQ_REVERSE:
+            if (_step == 0)
+            {
+                _next_step = _length - 1;
+            }
+            else
+            {
+                _next_step = _step - 1;
+            }
+            break;
+        case SEQ_PENDULUM:
+            if (_length == 1)
+            {
+                _next_step = 0;
+            }
+            else if (_rising == true)
+            {
+                if (_step >= (_length - 1))
+                {
+                    _rising = false;
+                    _next_step = _length - 2;
+                }
+                else
+                {
+                    _next_step = _step + 1;
+                }
+            }
+            else
+            {
+                if (_step == 0)
+                {
+                    _rising = true;
+                    _next_step = 1;
+                }
+                else
+                {
+                    _next_step = _step - 1;
+                }
+            }
+            break;
+        case SEQ_RANDOM:
+            _next_step = ((unsigned int)_rand.next8() * _length) >> 8;
+            break;
+        default:
+            _next_step = _step + 1;
+            if (_next_step >= _length)
+            {
+                _next_step = 0;
+            }
+            break;
+    }
+}
+
+byte ssbSequencer::_read_step(byte step)
+{
+    if (_in_ram == true)
+    {
+        return _pattern[step];
+    }
+    return pgm_read_byte(_pattern + step);
+}
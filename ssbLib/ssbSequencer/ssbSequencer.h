@@ -0,0 +1,182 @@
+/*
+  ssbSequencer.h - A step sequencer engine for ArdCore patches.
+    Patterns are kept in flash (PROGMEM), one byte per step:
+      bit 7:      accent
+      bit 6:      tie (change the note with out a new gate)
+      bits 0-5:   signed note offset (-31 - 31), -32 is a rest.
+    Build steps with the SEQ_ macros, for example:
+      const byte PATTERN[4] PROGMEM = {
+          SEQ_NOTE(0) | SEQ_ACCENT, SEQ_NOTE(7), SEQ_REST, SEQ_NOTE(-5) | SEQ_TIE};
+    A pattern may be any length (1 - SEQ_MAX_LENGTH) and played forward,
+    reverse, pendulum (no repeat at the ends) or random. The next step is
+    always worked out one step ahead, so advance (call on a clock edge) is
+    one flash read and a few compares whatever the direction, and the next
+    step can be checked before it plays (getNextStep).
+    A pattern may also be in SRAM (setRamPattern), for patterns loaded
+    from EEPROM (see ssbPatternBank) or built at run time.
+
+    A flash pattern may have a lane byte for each step (setLanes), kept
+    in a second array of the same length:
+      bits 0-1:   probability (100%, 75%, 50%, 25%)
+      bits 2-3:   ratchet (1 - 4 gates in the step)
+      bits 4-5:   gate length (full, 3/4, 1/2, 1/4)
+      bits 6-7:   octave (signed, -2 - 1)
+    0 is always play, one full gate, no octave shift. Build lane bytes by
+    or'ing the SEQ_PROB_, SEQ_RATCHET_, SEQ_GATE_ and SEQ_OCT_ values.
+    The probability is rolled (ssbRandom, a 16 bit xorshift) when the
+    step is advanced to, so a step either plays or not for its whole
+    length.
+
+  Created by Peter Fawcett, Oct 18. 2026.
+    Version 0.1: Created basic ssbSequencer Obect
+    Version 0.2: Oct 18. 2026
+                    Added SRAM patterns (setRamPattern).
+    Version 0.3: Oct 18. 2026
+                    Added step lanes (probability, ratchet, gate length
+                    and octave). Random play uses a xorshift, not random().
+    Version 0.4: Oct 18. 2026
+                    The xorshift is ssbRandom (include ssbRandom.h in the
+                    sketch too).
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#ifndef _ssb_sequencer_class_
+#define _ssb_sequencer_class_
+
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+#include <ssbRandom.h>
+
+// ============================================================================
+// Step Byte:
+// ============================================================================
+const byte    SEQ_ACCENT            = 0x80;
+const byte    SEQ_TIE               = 0x40;
+const byte    SEQ_OFFSET_MASK       = 0x3F;
+const byte    SEQ_REST              = 0x20;     // Offset -32.
+const int     SEQ_OFFSET_MIN        = -31;
+const int     SEQ_OFFSET_MAX        = 31;
+// - A step byte for a note offset (-31 - 31).
+#define SEQ_NOTE(offset) ((byte)((offset) & SEQ_OFFSET_MASK))
+
+// ============================================================================
+// Directions:
+// ============================================================================
+const byte    SEQ_FORWARD           = 0;
+const byte    SEQ_REVERSE           = 1;
+const byte    SEQ_PENDULUM          = 2;
+const byte    SEQ_RANDOM            = 3;
+const byte    SEQ_DIRECTION_COUNT   = 4;
+
+const byte    SEQ_MAX_LENGTH        = 64;
+
+// ============================================================================
+// Step Lanes:
+// ============================================================================
+const byte    SEQ_PROB_100          = 0x00;
+const byte    SEQ_PROB_75           = 0x01;
+const byte    SEQ_PROB_50           = 0x02;
+const byte    SEQ_PROB_25           = 0x03;
+const byte    SEQ_PROB_MASK         = 0x03;
+const byte    SEQ_RATCHET_1         = 0x00;
+const byte    SEQ_RATCHET_2         = 0x04;
+const byte    SEQ_RATCHET_3         = 0x08;
+const byte    SEQ_RATCHET_4         = 0x0C;
+const byte    SEQ_RATCHET_MASK      = 0x0C;
+const byte    SEQ_GATE_FULL         = 0x00;
+const byte    SEQ_GATE_3_4          = 0x10;
+const byte    SEQ_GATE_1_2          = 0x20;
+const byte    SEQ_GATE_1_4          = 0x30;
+const byte    SEQ_GATE_MASK         = 0x30;
+const byte    SEQ_OCT_0             = 0x00;
+const byte    SEQ_OCT_UP            = 0x40;     // +1
+const byte    SEQ_OCT_DOWN_2        = 0x80;     // -2
+const byte    SEQ_OCT_DOWN          = 0xC0;     // -1
+const byte    SEQ_OCT_MASK          = 0xC0;
+
+class ssbSequencer
+{
+    private:
+        const byte*     _pattern;       // Pattern (flash or SRAM).
+        bool            _in_ram;        // true if _pattern is in SRAM.
+        byte            _length;        // Steps in the pattern.
+        byte            _direction;     // SEQ_FORWARD ... SEQ_RANDOM.
+        byte            _step;          // Current step (index).
+        byte            _next_step;     // Step the next advance moves to.
+        bool            _rising;        // Pendulum direction of _next_step.
+        bool            _started;       // false until the first advance.
+        byte            _data;          // Current step byte.
+        const byte*     _lanes;         // Lane bytes (flash), 0 if none.
+        byte            _lane;          // Current lane byte.
+        bool            _played;        // Probability roll of the current step.
+        ssbRandom       _rand;          // Probability and random play.
+    public:
+        // Constructors
+        ssbSequencer();
+        ssbSequencer(const byte* pattern, byte length);
+        // Destructor
+        ~ssbSequencer();
+
+        // - Set the pattern (in flash) and its length. Restarts at step 0.
+        void setPattern(const byte* pattern, byte length);
+        // - As above for a pattern in SRAM. The pattern is read in place, so
+        //   it must stay in scope while it plays.
+        void setRamPattern(const byte* pattern, byte length);
+        // - Change the length with out a restart (1 - the pattern length).
+        void setLength(byte length);
+        // - Lane bytes (flash) for the pattern, one per step. 0 for none
+        //   (every step plays once, full length). Cleared by setPattern.
+        void setLanes(const byte* lanes);
+        // - Seed the probability / random play generator.
+        void seed(unsigned int seed);
+        // - SEQ_FORWARD, SEQ_REVERSE, SEQ_PENDULUM or SEQ_RANDOM.
+        void setDirection(byte direction);
+        // - Move to the next step. Call on a clock edge. Returns the step.
+        byte advance();
+        // - The next advance starts from the first step again.
+        void reset();
+
+        // - Current step (index) and the one after it.
+        byte getStep();
+        byte getNextStep();
+        byte getLength();
+        // - Current step data.
+        int getOffset();
+        bool isRest();
+        bool isTie();
+        bool isAccent();
+        // - Current step lanes.
+        byte getLane();
+        // - false if the probability roll skipped this step.
+        bool isPlayed();
+        // - Gates in the step (1 - 4).
+        byte getRatchet();
+        // - Gate length in quarters (4 is full, 1 is a quarter).
+        byte getGateQuarters();
+        // - Octave shift (-2 - 1).
+        int getOctave();
+        // - Step byte of the next step (to look ahead for ties).
+        byte peekNext();
+
+        // - Decode a step byte.
+        static int stepOffset(byte data);
+    private:
+        void _calc_next();
+        byte _read_step(byte step);
+};
+
+#endif // _ssb_sequencer_class_
@@ -0,0 +1,188 @@
+/*
+  ssbSlew.cpp - A slew limiter (portamento / glide) for ArdCore patches.
+
+  Created by Peter Fawcett, Oct 18. 2026.
+    Version 0.1: Created basic ssbSlew Obect
+    Version 0.2: Oct 18. 2026
+                    A time of 0 jumps to the target in setTarget, not on
+                    the next tick.
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#include "ssbSlew.h"
+
+// Constructors
+
+ssbSlew::ssbSlew()
+{
+    _init(0, 0);
+}
+
+ssbSlew::ssbSlew(unsigned int ms)
+{
+    _init(ms, ms);
+}
+
+ssbSlew::ssbSlew(unsigned int rise_ms, unsigned int fall_ms)
+{
+    _init(rise_ms, fall_ms);
+}
+
+// Destructor
+
+ssbSlew::~ssbSlew(){/*nothing to destruct*/}
+
+// Slew Methods
+
+void ssbSlew::setTime(unsigned int ms)
+{
+    _rise_ms = ms;
+    _fall_ms = ms;
+    _calc_rate();
+}
+
+void ssbSlew::setRiseTime(unsigned int ms)
+{
+    if (ms != _rise_ms)
+    {
+        _rise_ms = ms;
+        _calc_rate();
+    }
+}
+
+void ssbSlew::setFallTime(unsigned int ms)
+{
+    if (ms != _fall_ms)
+    {
+        _fall_ms = ms;
+        _calc_rate();
+    }
+}
+
+void ssbSlew::setConstantTime(bool is_on)
+{
+    _constant_time = is_on;
+    _calc_rate();
+}
+
+void ssbSlew::setTarget(int level)
+{
+    long target = (long)constrain(level, 0, SLEW_MAX) << SLEW_SHIFT;
+    if (target != _target)
+    {
+        _target = target;
+        _calc_rate();
+    }
+}
+
+void ssbSlew::jump(int level)
+{
+    _target = (long)constrain(level, 0, SLEW_MAX) << SLEW_SHIFT;
+    _value = _target;
+}
+
+int ssbSlew::update()
+{
+    return update(micros());
+}
+
+/* update
+ - One step per tick since the last update. A stall of more than
+   SLEW_MAX_CATCHUP ticks drops the extra ticks.
+*/
+int ssbSlew::update(unsigned long now_us)
+{
+    byte ticks = 0;
+    while ((long)(now_us - _next_tick_us) >= 0)
+    {
+        _next_tick_us += SLEW_TICK_US;
+        if (++ticks >= SLEW_MAX_CATCHUP)
+        {
+            _next_tick_us = now_us + SLEW_TICK_US;
+        }
+        if (_value < _target)
+        {
+            _value += _rate;
+            if ((_rate == 0) || (_value > _target))
+            {
+                _value = _target;
+            }
+        }
+        else if (_value > _target)
+        {
+            _value -= _rate;
+            if ((_rate == 0) || (_value < _target))
+            {
+                _value = _target;
+            }
+        }
+    }
+    return getValue();
+}
+
+int ssbSlew::getValue()
+{
+    // Round to the nearest level.
+    return (int)((_value + (1L << (SLEW_SHIFT - 1))) >> SLEW_SHIFT);
+}
+
+bool ssbSlew::isSettled()
+{
+    return (_value == _target);
+}
+
+// Private methods
+
+void ssbSlew::_init(unsigned int rise_ms, unsigned int fall_ms)
+{
+    _value = 0;
+    _target = 0;
+    _rate = 0;
+    _rise_ms = rise_ms;
+    _fall_ms = fall_ms;
+    _next_tick_us = 0;
+    _constant_time = false;
+}
+
+/* _calc_rate
+ - Move per tick for the current direction. The span is a full scale move,
+   or the distance left to the target for constant time. Never less than 1
+   so a long time still gets there. A time of 0 is no glide, go to the
+   target now so getValue is right before the next update.
+*/
+void ssbSlew::_calc_rate()
+{
+    unsigned long ticks;
+    long span = SLEW_FULL;
+    unsigned int ms = _rise_ms;
+    if (_target < _value)
+    {
+        ms = _fall_ms;
+    }
+    if (ms == 0)
+    {
+        _rate = 0;
+        _value = _target;
+        return;
+    }
+    if (_constant_time == true)
+    {
+        span = abs(_target - _value);
+    }
+    ticks = max(((unsigned long)ms * 1000UL) / SLEW_TICK_US, 1UL);
+    _rate = max(span / (long)ticks, 1L);
+}
@@ -0,0 +1,94 @@
+/*
+  ssbSlew.h - A slew limiter (portamento / glide) for ArdCore patches.
+    Sits between a quantizer and dacOutput. setTarget sets the level to
+    move to and update moves towards it at a fixed tick rate
+    (SLEW_TICK_US, counted from micros, so the glide time does not change
+    when the loop slows down). The value is kept in Q16 (value << 16), so
+    there is no float math, and each tick is one add and compare.
+
+    Rise and fall times are separate. By default a time is for a full
+    scale (0 - 1023) move, so a small interval glides faster than a large
+    one (constant rate). With setConstantTime on, every move takes the
+    rise or fall time, whatever the interval. A time of 0 is no glide.
+
+  Created by Peter Fawcett, Oct 18. 2026.
+    Version 0.1: Created basic ssbSlew Obect
+    Version 0.2: Oct 18. 2026
+                    A time of 0 jumps to the target in setTarget, not on
+                    the next tick.
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#ifndef _ssb_slew_class_
+#define _ssb_slew_class_
+
+#include <Arduino.h>
+
+// ============================================================================
+// Slew Constants:
+// ============================================================================
+const int     SLEW_MAX              = 1023;
+const byte    SLEW_SHIFT            = 16;                       // Q16 fixed point.
+const long    SLEW_FULL             = (long)SLEW_MAX << SLEW_SHIFT;
+const unsigned int SLEW_TICK_US     = 1000;                     // Tick (1ms).
+const byte    SLEW_MAX_CATCHUP      = 100;                      // Max ticks per update.
+
+class ssbSlew
+{
+    private:
+        long            _value;         // Current value (Q16).
+        long            _target;        // Target value (Q16).
+        long            _rate;          // Current move per tick (Q16), 0 is a jump.
+        unsigned int    _rise_ms;       // Rise time.
+        unsigned int    _fall_ms;       // Fall time.
+        unsigned long   _next_tick_us;  // micros() of the next tick.
+        bool            _constant_time; // Time per move (true) or per full scale.
+    public:
+        // Constructors
+        ssbSlew();
+        ssbSlew(unsigned int ms);
+        ssbSlew(unsigned int rise_ms, unsigned int fall_ms);
+        // Destructor
+        ~ssbSlew();
+
+        // - Set the rise and fall times (ms). 0 is no glide.
+        void setTime(unsigned int ms);
+        void setRiseTime(unsigned int ms);
+        void setFallTime(unsigned int ms);
+        // - true: every move takes the rise / fall time. false (default):
+        //   the times are for a full scale move.
+        void setConstantTime(bool is_on);
+        // - Set the level to move to (0 - 1023).
+        void setTarget(int level);
+        // - Jump to a level with no glide.
+        void jump(int level);
+
+        // - Move by the ticks since the last call. Call once per loop.
+        //   Returns the new value (0 - 1023).
+        int update();
+        int update(unsigned long now_us);
+
+        // - Current value (0 - 1023).
+        int getValue();
+        // - true once the target is reached.
+        bool isSettled();
+    private:
+        void _init(unsigned int rise_ms, unsigned int fall_ms);
+        void _calc_rate();
+};
+
+#endif // _ssb_slew_class_
@@ -2,6 +2,8 @@
   ssbStutterGate.cpp - A Gate Object for ArdCore patches.
   Created by Peter Fawcett, Dec 10. 2014.
     Version 0.1: Created basic ssbStutterGate Obect
+    Version 0.2: Oct 18. 2026
+                    Edge schedule, gate length.
 
 ============================================================
 
@@ -31,28 +33,23 @@ ssbStutterGate::ssbStutterGate()
     _stutter_count = 0;
     _stutter_index = 0;
     _start = 0;
+    _next = 0;
+    _length = 0;
     _ms_pad = DEFAULT_MS_PAD;
     _on = false;
+    _calc_on();
 }
 
 ssbStutterGate::ssbStutterGate(int in_dur)
 {
-    _duration = in_dur;
-    _stutter_count = 1;
-    _stutter_index = 1;
-    _start = millis();
     _ms_pad = DEFAULT_MS_PAD;
-    _on = true;
+    updateGate(in_dur, 1, 0);
 }
 
 ssbStutterGate::ssbStutterGate(int in_dur, int in_count)
 {
-    _duration = in_dur;
-    _stutter_count = in_count;
-    _stutter_index = 1;
-    _start = millis();
     _ms_pad = DEFAULT_MS_PAD;
-    _on = true;
+    updateGate(in_dur, in_count, 0);
 }
 
 
@@ -91,38 +88,35 @@ bool ssbStutterGate::isOn()
 
 /* updateState
  - Update the state of the gate. Call once per loop at either start or end
-   (end is better...).
+   (end is better...). Nothing is worked out here, the next edge is
+   either due or not.
 */
 void ssbStutterGate::updateState()
 {
-    bool tmp_on = false;
+    if ((_on == false) && (_stutter_index >= _stutter_count))
+    {
+        // gate over (or never set).
+        return;
+    }
+    if ((long)(millis() - _next) < 0)
+    {
+        // next edge not due yet.
+        return;
+    }
     if (_on == true)
     {
-        // is gate still active..?
-        if ((_start + _duration - _ms_pad) > millis())
-        {
-            // if gate duration is still active 
-            // (start plus dur is greater than now)
-            tmp_on = true;
-        }
-        if (tmp_on == false)
-        {
-            // gate is active, but over...
-            // will be set to false at end of function...
-            // are we a stutter gate? if yes, do we have
-            // another stutter to render...
-            if (_stutter_index < _stutter_count)
-            {
-                _start = _start + _duration;
-            }
-        }
+        // gate off, the next stutter (if any) starts a duration after
+        // this one did.
+        _on = false;
+        _start = _start + _duration;
+        _next = _start;
     }
-    else if ((_stutter_index < _stutter_count) && (_start <= millis()))
+    else
     {
-        tmp_on = true;
+        _on = true;
         _stutter_index += 1;
+        _next = _start + _on_ms;
     }
-    _on = tmp_on;
 }
 
 /* updateGate
@@ -132,19 +126,23 @@ void ssbStutterGate::updateState()
 
 void ssbStutterGate::updateGate(int new_dur)
 {
-    _duration = new_dur;
-    _stutter_count = 1;
-    _stutter_index = 1;
-    _start = millis();
-    _on = true;
+    updateGate(new_dur, 1, 0);
 }
 
 void ssbStutterGate::updateGate(int new_dur, int new_count)
+{
+    updateGate(new_dur, new_count, 0);
+}
+
+void ssbStutterGate::updateGate(int new_dur, int new_count, int on_ms)
 {
     _duration = new_dur;
     _stutter_count = new_count;
     _stutter_index = 1;
+    _length = on_ms;
+    _calc_on();
     _start = millis();
+    _next = _start + _on_ms;
     _on = true;
 }
 
@@ -157,15 +155,20 @@ void ssbStutterGate::unsetGate()
     _stutter_count = 0;
     _stutter_index = 0;
     _start = 0;
+    _next = 0;
+    _length = 0;
     _on = false;
+    _calc_on();
 }
 
 /* setStutterGapMS
- - Set the time (in ms) for the gap between stutters.
+ - Set the time (in ms) for the gap between stutters. Used from the next
+   stutter on.
 */
 void ssbStutterGate::setStutterGapMS(int ms_pad)
 {
     _ms_pad = ms_pad;
+    _calc_on();
 }
 
 /* render
@@ -182,3 +185,19 @@ void ssbStutterGate::render(int pin)
         digitalWrite(pin, LOW);
     }
 }
+
+// Private methods
+
+/* _calc_on
+ - High time of each stutter. The full duration less the gap, or the
+   requested length if that is shorter. May be 0 or less (a gate shorter
+   than the gap), then the gate is on for one update.
+*/
+void ssbStutterGate::_calc_on()
+{
+    _on_ms = _duration - _ms_pad;
+    if ((_length > 0) && (_length < _on_ms))
+    {
+        _on_ms = _length;
+    }
+}
@@ -1,7 +1,14 @@
 /*
   ssbStutterGate.h - A Stutter Gate Object for ArdCore patches.
+    The edges of the gate are worked out when the gate is set, so
+    updateState only compares millis() with the time of the next edge.
+
   Created by Peter Fawcett, Dec 10. 2014.
     Version 0.1: Created basic ssbStutterGate Obect
+    Version 0.2: Oct 18. 2026
+                    Edge schedule worked out in updateGate, a gate high
+                    time shorter than the stutter (gate length), and
+                    millis() roll over safe compares.
 
 ============================================================
 
@@ -29,7 +36,10 @@ class ssbStutterGate
 {
     private:
         int     _duration;      // Duration of the gate. For a stutter gate, it's the duration of a single fraction of a gate.
-        long    _start;         // Start time for the gate. From millis(). In MS.
+        unsigned long _start;   // Start time for the gate. From millis(). In MS.
+        unsigned long _next;    // Time of the next edge (on or off). From millis(). In MS.
+        int     _length;        // Requested high time, 0 is the full duration.
+        int     _on_ms;         // High time of each stutter (length less the pad).
         int     _stutter_count; // Number of stutters. default is 1
         int     _stutter_index; // Current stutter index
         int     _ms_pad;        // Default amount of of ms to pad between stutters.
@@ -56,12 +66,17 @@ class ssbStutterGate
         //     count). Will retart gate if currently active.
         void updateGate(int new_dur);
         void updateGate(int new_dur, int new_count);
+        // - As above with the high time of each stutter (ms). It is cut to
+        //     the duration less the stutter gap.
+        void updateGate(int new_dur, int new_count, int on_ms);
         // - Set the time (in ms) for the gap between stutters.
         void setStutterGapMS(int ms_pad);
         // - Unset the gate, clear it and set it to off.
         void unsetGate();
         // - Write the on/off state (HIGH/LOW) to the specified pin.
         void render(int pin);
+    private:
+        void _calc_on();
 };
 
 #endif  // _ssb_stutter_gate_class_
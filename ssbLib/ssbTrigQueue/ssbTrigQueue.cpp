@@ -0,0 +1,233 @@
+/*
+  ssbTrigQueue.cpp - Timed triggers on the ArdCore expander bits.
+
+  Created by Peter Fawcett, Oct 18. 2026.
+    Version 0.1: Created basic ssbTrigQueue Obect
+    Version 0.2: Oct 18. 2026
+                    A 0 delta, 0 mask push (or sync) re-anchors the deltas
+                    on the current tick. clear re-anchors too. Queue slots
+                    are volatile so they are stored before the tail moves.
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#include "ssbTrigQueue.h"
+
+// Interrupt state. Only one queue (there is one expander).
+static volatile unsigned long   trigq_ticks = 0;
+// The slots are volatile so the compiler can not move their stores after
+// the store to trigq_tail (the interrupt would fire a stale slot).
+static volatile unsigned long   trigq_time[TRIGQ_SIZE];
+static volatile byte            trigq_mask[TRIGQ_SIZE];
+static volatile byte            trigq_head = 0;
+static volatile byte            trigq_tail = 0;
+static volatile byte            trigq_left[TRIGQ_BITS];     // Ticks left of each trigger.
+static volatile byte            trigq_len = TRIGQ_DEFAULT_MS * TRIGQ_TICKS_PER_MS;
+static volatile byte            trigq_bits = 0;             // Bits high now.
+
+/* Timer1 compare interrupt
+ - Fire every event that is due, then count the triggers down. The port
+   is only written when a bit changes. Expander bits 0-2 are PORTD 5-7,
+   bits 3-7 are PORTB 0-4 (pins 5 - 12).
+*/
+ISR(TIMER1_COMPA_vect)
+{
+    byte bits = trigq_bits;
+    byte mask;
+    trigq_ticks++;
+    while ((trigq_head != trigq_tail) && ((long)(trigq_ticks - trigq_time[trigq_head]) >= 0))
+    {
+        mask = trigq_mask[trigq_head];
+        trigq_head = (trigq_head + 1) & (TRIGQ_SIZE - 1);
+        for (byte i = 0; i < TRIGQ_BITS; i++)
+        {
+            if ((mask & (1 << i)) != 0)
+            {
+                trigq_left[i] = trigq_len;
+            }
+        }
+        bits |= mask;
+    }
+    if (bits != 0)
+    {
+        for (byte i = 0; i < TRIGQ_BITS; i++)
+        {
+            if (trigq_left[i] > 0)
+            {
+                trigq_left[i]--;
+                if (trigq_left[i] == 0)
+                {
+                    bits &= ~(1 << i);
+                }
+            }
+        }
+    }
+    if (bits != trigq_bits)
+    {
+        PORTD = (PORTD & 0x1F) | (bits << 5);
+        PORTB = (PORTB & 0xE0) | (bits >> 3);
+        trigq_bits = bits;
+    }
+}
+
+// Constructors
+
+ssbTrigQueue::ssbTrigQueue()
+{
+    _last_time = 0;
+    _late_count = 0;
+    _full_count = 0;
+    _running = false;
+}
+
+// Destructor
+
+ssbTrigQueue::~ssbTrigQueue()
+{
+    end();
+}
+
+// Queue Methods
+
+/* begin
+ - Expander pins to output, Timer1 to CTC mode with no prescale at
+   TRIGQ_TICK_RATE and enable the compare interrupt.
+*/
+void ssbTrigQueue::begin()
+{
+    DDRD |= 0xE0;
+    DDRB |= 0x1F;
+    clear();
+    TCCR1A = 0;
+    TCCR1B = _BV(WGM12) | _BV(CS10);
+    OCR1A = (F_CPU / TRIGQ_TICK_RATE) - 1;
+    TCNT1 = 0;
+    TIMSK1 = _BV(OCIE1A);
+    _running = true;
+}
+
+void ssbTrigQueue::end()
+{
+    if (_running == true)
+    {
+        TIMSK1 = 0;
+        _running = false;
+    }
+    clear();
+}
+
+/* push
+ - The event is written before the tail moves on, so the interrupt never
+   sees a half written event. A 0 delta, 0 mask event is a sync, it only
+   re-anchors the deltas on now.
+*/
+bool ssbTrigQueue::push(unsigned int delta_ms, byte mask)
+{
+    if ((delta_ms == 0) && (mask == 0))
+    {
+        sync();
+        return true;
+    }
+    unsigned long now = getTicks();
+    unsigned long time = _last_time + ((unsigned long)delta_ms * TRIGQ_TICKS_PER_MS);
+    byte next = (trigq_tail + 1) & (TRIGQ_SIZE - 1);
+    if (next == trigq_head)
+    {
+        _full_count++;
+        return false;
+    }
+    if ((long)(time - now) <= 0)
+    {
+        // Late (or the first event), fire on the next tick.
+        time = now + 1;
+        _late_count++;
+    }
+    trigq_time[trigq_tail] = time;
+    trigq_mask[trigq_tail] = mask;
+    trigq_tail = next;
+    _last_time = time;
+    return true;
+}
+
+/* sync
+ - The next delta counts from now. Late events rebase the deltas on the
+   tick they fire, so a host should sync now and then (each bar, say) to
+   take the lost time back out.
+*/
+void ssbTrigQueue::sync()
+{
+    _last_time = getTicks();
+}
+
+/* clear
+ - Also re-anchors the deltas, or the next push would count from the last
+   event of the dropped pattern.
+*/
+void ssbTrigQueue::clear()
+{
+    uint8_t old_sreg = SREG;
+    cli();
+    trigq_head = trigq_tail;
+    _last_time = trigq_ticks;
+    for (byte i = 0; i < TRIGQ_BITS; i++)
+    {
+        trigq_left[i] = 0;
+    }
+    if (trigq_bits != 0)
+    {
+        PORTD &= 0x1F;
+        PORTB &= 0xE0;
+        trigq_bits = 0;
+    }
+    SREG = old_sreg;
+}
+
+bool ssbTrigQueue::isEmpty()
+{
+    return (trigq_head == trigq_tail);
+}
+
+void ssbTrigQueue::setTrigMs(byte trig_ms)
+{
+    trigq_len = constrain(trig_ms, 1, TRIGQ_MAX_MS) * TRIGQ_TICKS_PER_MS;
+}
+
+unsigned long ssbTrigQueue::getTicks()
+{
+    // A 32 bit read is four bytes, keep the interrupt out.
+    unsigned long ticks;
+    uint8_t old_sreg = SREG;
+    cli();
+    ticks = trigq_ticks;
+    SREG = old_sreg;
+    return ticks;
+}
+
+unsigned int ssbTrigQueue::getLateCount()
+{
+    return _late_count;
+}
+
+unsigned int ssbTrigQueue::getFullCount()
+{
+    return _full_count;
+}
+
+void ssbTrigQueue::resetStats()
+{
+    _late_count = 0;
+    _full_count = 0;
+}
@@ -0,0 +1,100 @@
+/*
+  ssbTrigQueue.h - Timed triggers on the ArdCore expander bits.
+    Events are a delta time (ms) and an 8 bit mask. They are queued ahead
+    of time (push) and fired from a Timer1 interrupt at TRIGQ_TICK_RATE,
+    so an event fires within one tick (50us) of its time, whatever the
+    main loop or the serial input is doing. Each bit in the mask is a
+    trigger of setTrigMs length on that expander bit.
+
+    The delta is from the time of the last event pushed, so a host can
+    send a pattern a few ms ahead and the spacing is kept exactly. An
+    event that would be in the past (the first one, or one sent too late)
+    fires on the next tick and the following deltas count from there, so
+    a late event pushes the rest of the pattern back. Push a 0 delta, 0
+    mask event (or call sync) to re-anchor the deltas on now, at the start
+    of a pattern and now and then after that to take out any lost time.
+    A 0 mask with a delta is a rest.
+
+    The queue is a ring of TRIGQ_SIZE events. The main loop only adds to
+    the tail and the interrupt only takes from the head, so no locking is
+    needed for the queue itself.
+
+    Do not use the DAC (dacOutput) while triggers are running, or anything
+    else that uses Timer1 (ssbOscillator, ssbProfile, Servo, PWM on pins 9
+    and 10, ...).
+
+  Created by Peter Fawcett, Oct 18. 2026.
+    Version 0.1: Created basic ssbTrigQueue Obect
+    Version 0.2: Oct 18. 2026
+                    Added sync, a 0 delta 0 mask push re-anchors the deltas.
+                    clear re-anchors the deltas.
+
+============================================================
+
+License:
+
+This software is licensed under the Creative Commons
+"Attribution-NonCommercial license. This license allows you
+to tweak and build upon the code for non-commercial purposes,
+without the requirement to license derivative works on the
+same terms. If you wish to use this (or derived) work for
+commercial work, please contact Peter Fawcett at our website
+(www.SoundSweepsBy.com).
+
+For more information on the Creative Commons CC BY-NC license,
+visit http://creativecommons.org/licenses/
+*/
+
+#ifndef _ssb_trig_queue_class_
+#define _ssb_trig_queue_class_
+
+#include <Arduino.h>
+
+// ============================================================================
+// Trigger Queue Constants:
+// ============================================================================
+const long    TRIGQ_TICK_RATE       = 20000;    // Interrupt rate (Hz), 50us a tick.
+const byte    TRIGQ_TICKS_PER_MS    = TRIGQ_TICK_RATE / 1000;
+const byte    TRIGQ_SIZE            = 16;       // Events, must be a power of 2.
+const byte    TRIGQ_BITS            = 8;
+const byte    TRIGQ_DEFAULT_MS      = 5;
+const byte    TRIGQ_MAX_MS          = 255 / TRIGQ_TICKS_PER_MS;
+
+class ssbTrigQueue
+{
+    private:
+        unsigned long   _last_time;     // Tick of the last event pushed.
+        unsigned int    _late_count;    // Events pushed after their time.
+        unsigned int    _full_count;    // Events dropped, the queue was full.
+        bool            _running;       // Is the interrupt running.
+    public:
+        // Constructors
+        ssbTrigQueue();
+        // Destructor
+        ~ssbTrigQueue();
+
+        // - Set the expander pins to output and start the interrupt. Call
+        //   in setup.
+        void begin();
+        // - Stop the interrupt and clear the queue.
+        void end();
+
+        // - Queue an event delta_ms after the last one. Returns false if
+        //   the queue is full. push(0, 0) is a sync.
+        bool push(unsigned int delta_ms, byte mask);
+        // - The next delta counts from now.
+        void sync();
+        // - Drop all queued events, set all bits low and sync.
+        void clear();
+        bool isEmpty();
+        // - Trigger length (1 - TRIGQ_MAX_MS).
+        void setTrigMs(byte trig_ms);
+        // - Interrupt ticks since begin.
+        unsigned long getTicks();
+
+        unsigned int getLateCount();
+        unsigned int getFullCount();
+        void resetStats();
+};
+
+#endif // _ssb_trig_queue_class_
@@ -1,10 +1,13 @@
 /*
 Program: ssbLogic
 Description:
-    Simple logic device. A2 and A3 are used as input. Input >= 50% are treated as 1. Input < 50% is treated as 0.
-    Input can be scaled with the A2 and A3 knobs. The analog out is the summed value (capped at min/max values).
-    Digital Gate out is a logic gate. The type of output is set by the value of A0 (Digital 0) and A1 (Digital 1).
-    The following logic types are supported on either D0 or D1; OR, AND, NOR, NAND, XOR, NXOR
+    Logic device. A2 - A5 are the inputs (A, B, C, D). Input >= 55% is treated as 1,
+    input < 45% as 0, in between keeps the last state (so a slow or noisy CV does not
+    chatter). The analog out is the summed value of A2 and A3 (capped at min/max values).
+    Digital Gate out is a logic element. The type of output is set by the value of A0
+    (Digital 0) and A1 (Digital 1).
+    Each gate is a truth table (ssbLogicGate), a mask indexed by the input bits, so
+    every type costs the same. Two input types use A2 and A3:
             A2:   0    1    0    1
             A3:   0    0    1    1
             ------------------------------
@@ -14,30 +17,50 @@ Description:
             NAND: 1    1    1    0
             XOR:  0    1    1    0
             NXOR: 1    0    0    1
+    Four input types use A2 - A5:
+            OR4:  any input high.
+            AND4: all inputs high.
+            XOR4: an odd number of inputs high.
+            MAJ4: 3 or more inputs high.
+    Stateful types:
+            SR:     set on A2, reset on A3 (reset wins).
+            D:      latch A2 on the rising edge of A3.
+            T:      toggle on the rising edge of A3 when A2 is high.
+            RISE:   trigger (TRIG_MS) on the rising edge of A2.
+            FALL:   trigger (TRIG_MS) on the falling edge of A2.
+            WINDOW: high while the A2 level is between the A4 and A5 levels.
+    The inputs are scanned with a fast ADC clock (about 16us a read) and each
+    scan does the same work (4 inputs, one of the two type knobs, both gates),
+    so the output follows the inputs within one scan, well under 150us.
 
     I/O Usage:
-        Knob A0:         Logic type for D0; OR, AND, NOR, NAND, XOR, NXOR
-        Knob A1:         Logic type for D1; OR, AND, NOR, NAND, XOR, NXOR
-        Knob/Jack A2:    Input X: < 512 = 0 || >= 512 = 1 
-        Knob/Jack A3:    Input Y: < 512 = 0 || >= 512 = 1 
+        Knob A0:         Logic type for D0 (OR, AND, NOR, NAND, XOR, NXOR, OR4, AND4,
+                         XOR4, MAJ4, SR, D, T, RISE, FALL, WINDOW)
+        Knob A1:         Logic type for D1 (as A0)
+        Knob/Jack A2:    Input A
+        Knob/Jack A3:    Input B
         Digital Out 1:   Logic Ouput 1
         Digital Out 2:   Logic Ouput 2
         Clock In:        Unused
         Analog Out:      Sum of A2 and A3 Constrained to Max/Min (0 - 5v)
     Input Expander:
-        Knob A4/Jack A4: Unused
-        Knob A5/Jack A5: Unused
+        Knob A4/Jack A4: Input C (window low for WINDOW)
+        Knob A5/Jack A5: Input D (window high for WINDOW)
     Output Expander:
         Knob
         Bits 0-7:        Unused
         Analog Out 11:   Unused
         Digital Out 13:  Unused
-    Serial:              Unused
+    Serial:              Unused (debug)
 
     Created:  May 11 2014 by Peter Fawcett (SoundSweepsBy).
         Version 1 - Original patch developement.
         Version 2 - Jan 24. 2015
                     Update to use ssbArdBase lib. Code tightened up.
+        Version 3 - Oct 18 2026
+                    Truth table logic elements (ssbLogicGate) over A2 - A5,
+                    with flip flops, edge triggers and a window comparator.
+                    Inputs have hysteresis and are read by a fast scan.
 
     ============================================================
 
@@ -55,21 +78,35 @@ Description:
     visit http://creativecommons.org/licenses/
 */
 
-#include "ssbArdBase.h"
-                                
-const   int     OR              = 0;
-const   int     AND             = 1;
-const   int     NOR             = 2;
-const   int     NAND            = 3;
-const   int     XOR             = 4;
-const   int     NXOR            = 5;
+#include <ssbArdBase.h>
+#include <ssbGate.h>
+#include <ssbLogicGate.h>
+// DEBUGGING
+// Set to SSB_LEVEL_ERROR, SSB_LEVEL_INFO or SSB_LEVEL_VERBOSE to enable debug
+// output. Debug calls above the level are not compiled in.
+#define SSB_DEBUG_LEVEL SSB_LEVEL_OFF
+#include <ssbDebugLevel.h>
 
-int             logic_types[2]  = {0, 0};
-int             input_values[2] = {0, 0};
-bool            logic_states[2] = {false, false};
-bool            gate_states[2]  = {false, false};
-int             logic_ctls[2]   = {A0_INPUT, A1_INPUT};
-int             input_ctls[2]   = {A2_INPUT, A3_INPUT};
+// EDIT THESE VALUES TO CHANGE THE INPUT THRESHOLDS AND TRIGGER LENGTH!!!!
+const   int     INPUT_ON        = 563;      // >= 55% is a 1.
+const   int     INPUT_OFF       = 460;      // < 45% is a 0.
+const   int     TRIG_MS         = 5;        // RISE / FALL trigger length.
+
+const   byte    INPUT_COUNT     = LOGIC_INPUTS;
+
+int             input_values[INPUT_COUNT]   = {0, 0, 0, 0};
+byte            input_bits                  = 0;    // Bit per input, A2 is bit 0.
+int             logic_ctls[GATE_COUNT]      = {A0_INPUT, A1_INPUT};
+int             input_ctls[INPUT_COUNT]     = {A2_INPUT, A3_INPUT, A4_INPUT, A5_INPUT};
+int             scan_ctl                    = 0;    // Type knob read this scan.
+ssbLogicGate    logic_gates[GATE_COUNT]     = {ssbLogicGate(), ssbLogicGate()};
+ssbGate         gates[GATE_COUNT]           = {ssbGate(), ssbGate()};
+// Scan time (us) of the last scan and the longest.
+unsigned long   scan_us                     = 0;
+unsigned long   scan_max_us                 = 0;
+
+//DEBUGGING:
+SSB_DEBUG(ssbDebug    DEBUG                 = ssbDebug();)
 
 
 //  ==================== setup() START ======================
@@ -91,6 +128,11 @@ void setup()
         pinMode(PIN_OFFSET + i, OUTPUT);
         digitalWrite(PIN_OFFSET + i, LOW);
     }
+    // About 16us a read, so a scan of 5 reads is about 80us.
+    setFastAdc();
+    // Debugging
+    SSB_DEBUG(DEBUG.enableSerial());
+    SSB_DEBUG(DEBUG.debugState(true));
 }
 //  ==================== setup() END =======================
 
@@ -102,60 +144,61 @@ void setup()
 //
 void loop()
 {
+    unsigned long scan_start = micros();
+    bool state = false;
+    scanInputs();
+    // Only one type knob per scan, so every scan is the same length.
+    logic_gates[scan_ctl].setType(getCtlIndex(logic_ctls[scan_ctl], LOGIC_TYPE_COUNT - 1));
+    scan_ctl = 1 - scan_ctl;
     for (int i = 0; i < GATE_COUNT; i++ )
     {
-        // Get the state of the first two controls. These set the 
-        // desired types of logic for each Digital Out.
-        logic_types[i] = getCtlIndex(logic_ctls[i], NXOR);
-        input_values[i] = analogRead(input_ctls[i]);
-        logic_states[i] = inputToBool(input_values[i]);
-    }
-    for (int i = 0; i < GATE_COUNT; i++ )
-    {
-        // Get the logic state for each output based on the type
-        // and the two init values.
-        gate_states[i] = doLogicState(logic_types[i], logic_states[0], logic_states[1]);
-        digitalWrite(DIG_PINS[i], gate_states[i]);
+        logic_gates[i].setWindow(min(input_values[2], input_values[3]),
+                                 max(input_values[2], input_values[3]));
+        state = logic_gates[i].update(input_bits, input_values[0]);
+        if (logic_gates[i].isPulse() == true)
+        {
+            // Edges are true for one scan, hold them for a trigger.
+            if (state == true)
+            {
+                gates[i].updateGate(TRIG_MS);
+            }
+            gates[i].updateState();
+        }
+        else
+        {
+            gates[i].setState(state);
+        }
+        gates[i].render(DIG_PINS[i]);
     }
     int outState = constrain((input_values[0] + input_values[1]), MIN_VAL, MAX_VAL);
     dacOutput(outState);
-}
-
-//  =================== convenience routines ===================
-
-bool doLogicState(int logicType, bool boolA, bool boolB)
-{
-    bool output = false;
-    switch (logicType)
+    scan_us = micros() - scan_start;
+    if (scan_us > scan_max_us)
     {
-        case OR:
-            output = (boolA | boolB);
-            break;
-        case AND:
-            output = (boolA & boolB);
-            break;
-        case NOR:
-            output = (!(boolA | boolB));
-            break;
-        case NAND:
-            output = (!(boolA & boolB));
-            break;
-        case XOR:
-            output = (boolA ^ boolB);
-            break;
-        case NXOR:
-            output = (!(boolA ^ boolB));
-            break;
+        scan_max_us = scan_us;
     }
-    return output;
+    SSB_DEBUG_VERBOSE(DEBUG.debugValue("Scan us:", (long)scan_us));
+    SSB_DEBUG_VERBOSE(DEBUG.debugValue("Scan max us:", (long)scan_max_us));
 }
 
-bool inputToBool(int input)
+//  =================== convenience routines ===================
+
+/* scanInputs
+ - Read A2 - A5 into input_values and input_bits. A value between
+   INPUT_OFF and INPUT_ON keeps the bit it had.
+*/
+void scanInputs()
 {
-    if (input > (MAX_VAL/2))
+    for (byte i = 0; i < INPUT_COUNT; i++)
     {
-        return true;
+        input_values[i] = analogRead(input_ctls[i]);
+        if (input_values[i] >= INPUT_ON)
+        {
+            input_bits |= (1 << i);
+        }
+        else if (input_values[i] < INPUT_OFF)
+        {
+            input_bits &= ~(1 << i);
+        }
     }
-    return false;
 }
-
@@ -19,6 +19,17 @@ Description:
     
     Use this patch with the ssbArdBits Max4Live Device.
 
+    Trigger mode (drum machine use): send [delta,mask] rather than [n]. delta is the
+    time in ms (0 - 1023) after the last event, mask is the bits (0 - 255) to trigger,
+    a 0 mask is a rest (for gaps over 1023ms). Events are queued (ssbTrigQueue) and
+    fired from a timer interrupt within 50us of their time, with a TRIG_MS trigger on
+    each bit, so they do not jitter with the serial input.
+    Send the events a few ms ahead of time. An event that arrives after its time fires
+    at once, and the deltas after it count from there. [0,0] re-syncs, the next delta
+    counts from when it arrives. Start each pattern (or bar) with a [0,0] so a late
+    event only shifts the rest of that bar.
+    A plain [n] leaves trigger mode (and drops any queued events).
+
     I/O Usage:
         Knob A0:         Unused
         Knob A1:         Unused
@@ -33,10 +44,15 @@ Description:
         Knob A5/Jack A5: Unused
     Output Expander:
         Bits 0-7:        Each bit may be set separately. See m4l device ssbArdBits.
-    Serial Input:        Input from Live (0 - 1023)
+                         In trigger mode, a TRIG_MS trigger per bit.
+    Serial Input:        Input from Live (0 - 1023) or [delta,mask] events.
 
     Created:  Jan 3 2014 by Peter Fawcett (SoundSweepsBy).
         Version 1 - Based off of serial input template
+        Version 2 - Oct 18 2026:
+          Trigger mode, timed [delta,mask] events fired from a Timer1
+          interrupt (ssbTrigQueue).
+          [0,0] re-syncs the event deltas.
 
     ============================================================
 
@@ -53,12 +69,16 @@ Description:
     For more information on the Creative Commons CC BY-NC license,
     visit http://creativecommons.org/licenses/
 */
+#include <ssbTrigQueue.h>
+
 // Max output.
 const int     MIN_VAL      = -1024;
 const int     MAX_VAL      = 1023;
 const boolean FALSE        = 0;
 const boolean TRUE         = 1;
 const int     BAUD_RATE    = 9600;
+// EDIT THIS VALUE TO CHANGE THE TRIGGER LENGTH (1 - 12 ms)!!!!
+const byte    TRIG_MS      = 5;
 
 //  constants related to the Arduino Nano pin use
 const int     pinOffset    = 5;       // DAC     -> the first DAC pin (from 5-12)
@@ -67,6 +87,9 @@ String        sample       = "";
 int           sigOut       = 0;
 int           liveInput    = 0;
 int           adjustVal    = 0;
+// Trigger mode: events are queued and fired by the timer, not the loop.
+ssbTrigQueue  trigQueue    = ssbTrigQueue();
+boolean       trigMode     = FALSE;
 
 // Debugging
 
@@ -90,6 +113,8 @@ void setup()
         pinMode(pinOffset+i, OUTPUT);
         digitalWrite(pinOffset+i, LOW);
     }
+    trigQueue.setTrigMs(TRIG_MS);
+    trigQueue.begin();
 }
 //  ==================== setup() END =======================
 
@@ -114,8 +139,24 @@ void loop()
         }
         else if(c == ']')
         {
-            // Convert input string to signal
-            sigOut = convertStringToInt(sample);
+            int sep = sample.indexOf(',');
+            if (sep >= 0)
+            {
+                // [delta,mask] event, the timer writes the bits.
+                trigMode = TRUE;
+                trigQueue.push(constrain(convertStringToInt(sample.substring(0, sep)), 0, MAX_VAL),
+                               convertStringToInt(sample.substring(sep + 1)) & 0xFF);
+            }
+            else
+            {
+                if (trigMode == TRUE)
+                {
+                    trigQueue.clear();
+                    trigMode = FALSE;
+                }
+                // Convert input string to signal
+                sigOut = convertStringToInt(sample);
+            }
         }
         else
         {
@@ -123,7 +164,10 @@ void loop()
             sample += c;
         }
     }
-    dacOutput((sigOut >> 2));
+    if (trigMode == FALSE)
+    {
+        dacOutput((sigOut >> 2));
+    }
 }
 
 //  =================== convenience routines ===================
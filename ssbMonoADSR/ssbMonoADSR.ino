@@ -32,6 +32,10 @@
  *            Jan 01 2014 - Updated code to use same methods/logic as the ADSR_EX code.
  *                        - Fixed A number of bugs.
  *                        - Updated the timing calculation code for attack, decay and release.
+ *            Oct 18 2026 - Envelope moved to ssbEnvelope (fixed point, no float math).
+ *                        - Gate on during release now restarts the attack (was a jump to sustain).
+ *                        - Attack, decay and release are times (2ms - 5s), not per loop amounts.
+ *                        - Added attack, decay and release curves (ATTACK_CURVE etc. below).
  *  ============================================================
  *
  *  License:
@@ -48,13 +52,13 @@
  *  visit http://creativecommons.org/licenses/
  */
 
-// Envelope States:
-const int     ATTACK       = 0;
-const int     DECAY        = 1;
-const int     SUSTAIN      = 2;
-const int     RELEASE      = 3;
+#include <ssbEnvelope.h>
+
+// PROFILING: uncomment to time each section of the loop. The report is
+// written to serial every 2 seconds.
+//#define SSB_PROFILE
+#include <ssbDebugLevel.h>
 
-const int     ENVELOPE_MAX = 1023;
 const boolean OFF          = 0;
 const boolean ON           = 1;
 const int     GATE_ON      = 120;  // Amount above which gate is considered on.
@@ -64,25 +68,27 @@ const int     GATE_OFF     = 100;  // Amount below which gate is considered off.
 const int     pinOffset    = 5;       // DAC     -> the first DAC pin (from 5-12)
 
 // EDIT THIS VALUE TO CHANGE SUSTAIN AMOUNT!!!!
-int           SUSTAIN_AMOUNT = 70;    // Percent value (int)  0 - 100.
+const int     SUSTAIN_AMOUNT = 70;    // Percent value (int)  0 - 100.
+const int     SUSTAIN_CTL    = (SUSTAIN_AMOUNT * 1023L) / 100;
+
+// EDIT THESE VALUES TO CHANGE THE ENVELOPE CURVES!!!!
+// ENV_CURVE_LINEAR, ENV_CURVE_EXP (slow start, fast finish),
+// ENV_CURVE_LOG (fast start, slow finish, like an analog envelope) or ENV_CURVE_S.
+const byte    ATTACK_CURVE   = ENV_CURVE_LINEAR;
+const byte    DECAY_CURVE    = ENV_CURVE_LINEAR;
+const byte    RELEASE_CURVE  = ENV_CURVE_LINEAR;
 
-// Envelope State:
-// - 0 : attack phase     [gate on       -> max envelope  (or gate off)]
-// - 1 : decay phase      [max envelope  -> sustain level (or gate off)]
-// - 2 : sustain phase    [sustain level -> gate off                   ]
-// - 3 : release phase    [gate off      -> 0             (or gate on) ]
-int envelopeState = ATTACK;
 // Current Gate State
 boolean gateState = OFF;
 
 // Current Envelope
-float envelopeVal = 0.0;
+int envelopeVal = 0;
+ssbEnvelope ENVELOPE = ssbEnvelope();
 
-// Envelope Values
-float attackValue  = 0.0;
-float decayValue   = 0.0;
-float sustainValue = 0.0;
-float releaseValue = 0.0;
+#ifdef SSB_PROFILE
+ssbDebug    DEBUG   = ssbDebug(2000);
+ssbProfile  PROFILE = ssbProfile();
+#endif
 
 /*  ==================== setup() START ======================
  *
@@ -91,7 +97,15 @@ float releaseValue = 0.0;
  */
 void setup()
 {
+#ifdef SSB_PROFILE
+    DEBUG.enableSerial();
+    DEBUG.debugState(true);
+    PROFILE.begin();
+#endif
     
+    ENVELOPE.setCurve(ENV_ATTACK, ATTACK_CURVE);
+    ENVELOPE.setCurve(ENV_DECAY, DECAY_CURVE);
+    ENVELOPE.setCurve(ENV_RELEASE, RELEASE_CURVE);
     // set up the 8-bit DAC output pins
     for (int i = 0; i < 8; i++)
     {
@@ -118,66 +132,43 @@ void loop()
        - If A2 is not connected to a gate signal.
            Knob will adjust gate amount between 0 and 1023.
     */
+    SSB_PROFILE_BEGIN(PROFILE, PROF_GATE);
     gateState = gate_state(gateState, analogRead(2));
+    SSB_PROFILE_END(PROFILE, PROF_GATE);
     /*
         get current state of controls.
-        - Note that attack, decay and release are the ammounts to add to/subtract from
-          the current envelope value.
-          Larger values on the knobs, become smaller add/subtract increments and thus
-          longer attack/decay/releases...
+        - Note that attack, decay and release are stage times, from 2ms (knob at 0)
+          to 5s (knob at max). The times are real time, so they do not change when
+          the loop slows down.
         - But sustain is not an increment. it's a fixed value to sustain at. Thus
           use the sustainBase (for now, may use gateValue in future)
     */
-    attackValue = map_float(analogRead(0), 0, 1023, 204.6, .5);
-    decayValue = map_float(analogRead(1), 0, 1023, 204.6, .5);
-    sustainValue = (int)(ENVELOPE_MAX * (float)(SUSTAIN_AMOUNT / 100.0));
-    releaseValue = map_float(analogRead(3), 0, 1023, 204.6, .5);
+    SSB_PROFILE_BEGIN(PROFILE, PROF_CTL_SCAN);
+    ENVELOPE.setAttack(analogRead(0));
+    ENVELOPE.setDecay(analogRead(1));
+    ENVELOPE.setSustain(SUSTAIN_CTL);
+    ENVELOPE.setRelease(analogRead(3));
+    SSB_PROFILE_END(PROFILE, PROF_CTL_SCAN);
     
-    int envLoopState = ATTACK;
-
-    if (gateState == ON)
-    {
-        if (envelopeState == RELEASE)
-        {
-            envLoopState = ATTACK;
-        }
-        if (envelopeState == ATTACK)     // Attack
-        {
-            envLoopState = ATTACK;
-            envelopeVal = do_attack_inc(envelopeVal, attackValue);
-        }
-        else if (envelopeState == DECAY) // Decay
-        {
-            envLoopState = DECAY;
-            envelopeVal = do_decay_dec(envelopeVal, decayValue, sustainValue);
-        }
-        else                             // Sustain
-        {
-            envLoopState = SUSTAIN;
-            envelopeVal = sustainValue;
-        }
-    }
-    else                                 // Release
-    {
-        envLoopState = RELEASE;
-        envelopeVal = do_release_dec(envelopeVal, releaseValue);
-    }
-
-    // Keep track of state based on envelope, current state and gate state.
-    envelopeState = envelope_state(envelopeState, envLoopState, envelopeVal, sustainValue);
+    SSB_PROFILE_BEGIN(PROFILE, PROF_ENVELOPE);
+    ENVELOPE.setGate(gateState);
+    envelopeVal = ENVELOPE.updateState();
+    SSB_PROFILE_END(PROFILE, PROF_ENVELOPE);
 
     // Write envelope to DAC.
-    dacOutput(((long)envelopeVal >> 2));
+    SSB_PROFILE_BEGIN(PROFILE, PROF_DAC);
+    dacOutput((envelopeVal >> 2));
+    SSB_PROFILE_END(PROFILE, PROF_DAC);
+
+#ifdef SSB_PROFILE
+    DEBUG.updateTicks();
+    DEBUG.debugProfile(&PROFILE);
+#endif
 }
 
 
 //  ==================== loop() END =======================
 
-float map_float(float x, float in_min, float in_max, float out_min, float out_max)
-{
-  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
-}
-
 boolean gate_state(boolean gate, int currentGate)
 {
     if (currentGate > GATE_ON)
@@ -191,71 +182,6 @@ boolean gate_state(boolean gate, int currentGate)
     return gate;
 }
 
-int envelope_state(int state, int currentState, float envelopeVal, float sustainVal)
-{
-    if (envelopeVal >= ENVELOPE_MAX)
-    {
-        state = DECAY;
-    }
-    else if ((state == DECAY) && (envelopeVal <= sustainVal))
-    {
-        state = SUSTAIN;
-    }
-    else if (envelopeVal <= 0)
-    {
-        state = ATTACK;
-    }
-    else if (state != currentState)
-    {
-        state = currentState;
-    }
-    return state;
-}
-
-float do_attack_inc(float envelopeVal, float attackValue)
-{
-    envelopeVal = (envelopeVal + attackValue); //step up to full level
-    if (envelopeVal >= ENVELOPE_MAX)
-    {
-        envelopeVal = ENVELOPE_MAX;
-    }
-    return envelopeVal;
-}
-
-float do_decay_dec(float envelopeVal, float decayValue, float sustainValue)
-{
-    if (envelopeVal > sustainValue) // If greater than sustain
-    {
-        // Decriment by decay value.
-        envelopeVal = (envelopeVal - decayValue);
-    }
-    // if envelope is < 0 set to 0. Shouldn't get here unless sustain is 0.
-    if (envelopeVal <= 0)
-    {
-        envelopeVal = 0;
-    }
-    else if (envelopeVal < sustainValue)
-    {
-        // if current envelope got set lower than sustain, set it to sustain.
-        envelopeVal = sustainValue;
-    }
-    return envelopeVal;
-}
-
-float do_release_dec(float envelopeVal, float releaseValue)
-{
-    if (envelopeVal > 0)
-    {
-        // calculate new value of releasse envelope.
-        envelopeVal = envelopeVal - releaseValue;
-    }
-    if (envelopeVal < 0)
-    {
-        envelopeVal = 0; // if below 0, set to 0.
-    }
-    return envelopeVal;
-}
-
 //  =================== convenience routines ===================
 
 //  dacOutput(long) - deal with the DAC output
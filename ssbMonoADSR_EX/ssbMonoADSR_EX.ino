@@ -39,6 +39,12 @@
  *                         - Refactored loop into more supportable helper functions.
  *            Jan 01 2014  - Fixed A number of bugs.
  *                         - Updated the timing calculation code for attack, decay and release.
+ *            Oct 18 2026  - Envelope state output moved behind SSB_LEVEL_VERBOSE,
+ *                           it is no longer written to serial every loop.
+ *            Oct 18 2026  - Envelope moved to ssbEnvelope (fixed point, no float math).
+ *                         - Gate on during release now restarts the attack (was a jump to sustain).
+ *                         - Attack, decay and release are times (2ms - 5s), not per loop amounts.
+ *                         - Added attack, decay and release curves (ATTACK_CURVE etc. below).
  *  ============================================================
  *
  *  License:
@@ -55,13 +61,17 @@
  *  visit http://creativecommons.org/licenses///
  */
  
-// Envelope States:
-const int     ATTACK       = 0;
-const int     DECAY        = 1;
-const int     SUSTAIN      = 2;
-const int     RELEASE      = 3;
+#include <ssbEnvelope.h>
+
+// DEBUGGING
+// Set to SSB_LEVEL_VERBOSE to write the envelope state to serial (every 2
+// seconds). Debug calls above the level are not compiled in.
+#define SSB_DEBUG_LEVEL SSB_LEVEL_OFF
+// PROFILING: uncomment to time each section of the loop. The report is
+// written to serial every 2 seconds.
+//#define SSB_PROFILE
+#include <ssbDebugLevel.h>
 
-const int     ENVELOPE_MAX = 1023;
 const boolean OFF          = 0;
 const boolean ON           = 1;
 const int     GATE_ON      = 650;  // Amount above which gate is considered on.
@@ -70,23 +80,24 @@ const int     GATE_OFF     = 600;  // Amount below which gate is considered off.
 //  constants related to the Arduino Nano pin use
 const int     pinOffset    = 5;       // DAC     -> the first DAC pin (from 5-12)
 
-// Envelope State:
-// - 0 : attack phase     [gate on       -> max envelope  (or gate off)]
-// - 1 : decay phase      [max envelope  -> sustain level (or gate off)]
-// - 2 : sustain phase    [sustain level -> gate off                   ]
-// - 3 : release phase    [gate off      -> 0             (or gate on) ]
-int envelopeState = ATTACK;
+// EDIT THESE VALUES TO CHANGE THE ENVELOPE CURVES!!!!
+// ENV_CURVE_LINEAR, ENV_CURVE_EXP (slow start, fast finish),
+// ENV_CURVE_LOG (fast start, slow finish, like an analog envelope) or ENV_CURVE_S.
+const byte    ATTACK_CURVE   = ENV_CURVE_LINEAR;
+const byte    DECAY_CURVE    = ENV_CURVE_LINEAR;
+const byte    RELEASE_CURVE  = ENV_CURVE_LINEAR;
+
 // Current Gate State
 boolean gateState = OFF;
 
 // Current Envelope
-float envelopeVal = 0.0;
+int envelopeVal = 0;
+ssbEnvelope ENVELOPE = ssbEnvelope();
 
-// Envelope Values
-float attackValue  = 0.0;
-float decayValue   = 0.0;
-float sustainValue = 0.0;
-float releaseValue = 0.0;
+SSB_DEBUG(ssbDebug    DEBUG   = ssbDebug(2000);)
+#ifdef SSB_PROFILE
+ssbProfile  PROFILE = ssbProfile();
+#endif
 
 /*  ==================== setup() START ======================
  *
@@ -95,7 +106,14 @@ float releaseValue = 0.0;
  */
 void setup()
 {
-    Serial.begin(9600);
+    SSB_DEBUG(DEBUG.enableSerial());
+    SSB_DEBUG(DEBUG.debugState(true));
+#ifdef SSB_PROFILE
+    PROFILE.begin();
+#endif
+    ENVELOPE.setCurve(ENV_ATTACK, ATTACK_CURVE);
+    ENVELOPE.setCurve(ENV_DECAY, DECAY_CURVE);
+    ENVELOPE.setCurve(ENV_RELEASE, RELEASE_CURVE);
     // set up the 8-bit DAC output pins
     for (int i = 0; i < 8; i++)
     {
@@ -116,85 +134,46 @@ void loop()
 {
     /*
         get current state of controls.
-        - Note that attack, decay and release are the ammounts to add to/subtract from
-          the current envelope value.
-          Larger values on the knobs, become smaller add/subtract increments and thus
-          longer attack/decay/releases...
+        - Note that attack, decay and release are stage times, from 2ms (knob at 0)
+          to 5s (knob at max). The times are real time, so they do not change when
+          the loop slows down.
         - But sustain is not an increment. it's a fixed value to sustain at. Thus
           use the sustainBase (for now, may use gateValue in future)
         - Gate input in A4 on Expander. To do manual trigger, feed positive signal into
           input so that the atenuator has something to attenuate (like a signal from 
           Maths out 2 or 3) 
     */
+    SSB_PROFILE_BEGIN(PROFILE, PROF_GATE);
     gateState = gate_state(gateState, analogRead(4));
-
-    attackValue = calc_rate((float)analogRead(0));
-    decayValue = calc_rate((float)analogRead(1));
-    sustainValue = calc_level(analogRead(2));
-    releaseValue = calc_rate((float)analogRead(3));
+    SSB_PROFILE_END(PROFILE, PROF_GATE);
+
+    SSB_PROFILE_BEGIN(PROFILE, PROF_CTL_SCAN);
+    ENVELOPE.setAttack(analogRead(0));
+    ENVELOPE.setDecay(analogRead(1));
+    ENVELOPE.setSustain(analogRead(2));
+    ENVELOPE.setRelease(analogRead(3));
+    SSB_PROFILE_END(PROFILE, PROF_CTL_SCAN);
     
-    int envLoopState = ATTACK;
-
-    if (gateState == ON)
-    {
-        if (envelopeState == RELEASE)
-        {
-            envLoopState = ATTACK;
-        }
-        if (envelopeState == ATTACK)     // Attack
-        {
-            envLoopState = ATTACK;
-            envelopeVal = do_attack_inc(envelopeVal, attackValue);
-            Serial.print("In Attack: ");
-            Serial.println(envelopeVal);
-        }
-        else if (envelopeState == DECAY) // Decay
-        {
-            envLoopState = DECAY;
-            envelopeVal = do_decay_dec(envelopeVal, decayValue, sustainValue);
-            Serial.print("In Decay: ");
-            Serial.println(envelopeVal);
-        }
-        else                             // Sustain
-        {
-            envLoopState = SUSTAIN;
-            envelopeVal = sustainValue;
-            Serial.print("In Sustain: ");
-            Serial.println(envelopeVal);
-        }
-    }
-    else                                 // Release
-    {
-        envLoopState = RELEASE;
-        envelopeVal = do_release_dec(envelopeVal, releaseValue);
-    }
-
-    // Keep track of state based on envelope, current state and gate state.
-    envelopeState = envelope_state(envelopeState, envLoopState, envelopeVal, sustainValue);
+    SSB_PROFILE_BEGIN(PROFILE, PROF_ENVELOPE);
+    ENVELOPE.setGate(gateState);
+    envelopeVal = ENVELOPE.updateState();
+    SSB_DEBUG_VERBOSE(DEBUG.debugValue("Envelope State: ", (int)ENVELOPE.getState()));
+    SSB_DEBUG_VERBOSE(DEBUG.debugValue("Envelope: ", envelopeVal));
+    SSB_PROFILE_END(PROFILE, PROF_ENVELOPE);
 
     // Write envelope to DAC.
-    dacOutput(((long)envelopeVal >> 2));
+    SSB_PROFILE_BEGIN(PROFILE, PROF_DAC);
+    dacOutput((envelopeVal >> 2));
+    SSB_PROFILE_END(PROFILE, PROF_DAC);
+
+    SSB_DEBUG(DEBUG.updateTicks());
+#ifdef SSB_PROFILE
+    DEBUG.debugProfile(&PROFILE);
+#endif
 }
 
 //  ==================== loop() END =======================
 
-float calc_rate(float analogIn)
-{
-    return map_float(analogIn, 0, 1023, 204.6, .5);
-}
-
-float map_float(float x, float in_min, float in_max, float out_min, float out_max)
-{
-  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
-}
-
-float calc_level(int analogIn)
-{
-    int percent;
-    percent = map(analogIn, 0, 1023, 0, 100);
-    return (ENVELOPE_MAX * (float)(percent / 100.0));
-}
-
 boolean gate_state(boolean gate, int currentGate)
 {
     if (currentGate > GATE_ON)
@@ -207,71 +186,6 @@ boolean gate_state(boolean gate, int currentGate)
     }
     return gate;
 }
-
-int envelope_state(int state, int currentState, float envelopeVal, float sustainVal)
-{
-    if (envelopeVal >= ENVELOPE_MAX)
-    {
-        state = DECAY;
-    }
-    else if ((state == DECAY) && (envelopeVal <= sustainVal))
-    {
-        state = SUSTAIN;
-    }
-    else if (envelopeVal <= 0)
-    {
-        state = ATTACK;
-    }
-    else if (state != currentState)
-    {
-        state = currentState;
-    }
-    return state;
-}
-
-float do_attack_inc(float envelopeVal, float attackValue)
-{
-    envelopeVal = (envelopeVal + attackValue); //step up to full level
-    if (envelopeVal >= ENVELOPE_MAX)
-    {
-        envelopeVal = ENVELOPE_MAX;
-    }
-    return envelopeVal;
-}
-
-float do_decay_dec(float envelopeVal, float decayValue, float sustainValue)
-{
-    if (envelopeVal > sustainValue) //stop at sustain level
-    {
-        // Decriment by decay value.
-        envelopeVal = (envelopeVal - decayValue);
-    }
-    // if envelope is < 0 set to 0. Shouldn't get here unless sustain is 0.
-    if (envelopeVal <= 0)
-    {
-        envelopeVal = 0;
-    }
-    else if (envelopeVal < sustainValue)
-    {
-        // if current envelope got set lower than sustain, set it to sustain.
-        envelopeVal = sustainValue;
-    }
-    return envelopeVal;
-}
-
-float do_release_dec(float envelopeVal, float releaseValue)
-{
-    if (envelopeVal > 0)
-    {
-        // calculate new value of releasse envelope.
-        envelopeVal = envelopeVal - releaseValue;
-    }
-    if (envelopeVal < 0)
-    {
-        envelopeVal = 0; // if below 0, set to 0.
-    }
-    return envelopeVal;
-}
     
 
 //  =================== convenience routines ===================
@@ -0,0 +1,233 @@
+/* Program: ssbMonoADSR_PWM
+ *
+ * An ADSR envelope for the Ardcore AND the Ardcore Expander, with the envelope on
+ * the expander Analog Out 11 (a Timer2 PWM, see ssbPwmDac) and the envelope stages
+ * as gates on the other expander bits. The controls are the same as ssbMonoADSR_EX.
+ *
+ * Pin 11 is also bit 6 of the DAC. While the PWM runs the timer drives the pin, so
+ * the patch masks bit 6 out of everything it writes to the DAC port (dacOutput below)
+ * and the main Analog Out is not used: it would be the stage gates plus the PWM
+ * carrier on bit 6. The PWM can be inverted with A5 (a falling envelope, for ducking
+ * or a VCA that closes on the gate).
+ *
+ * Note: Monophonic. Can handle only one note gate at a time. If it get's more than one,
+ *       it WILL produce unpredictable results.
+ *
+ *  I/O Usage:
+ *    Knob A0:         Attack
+ *    Knob A1:         Decay
+ *    Knob A2/Jack A2: Sustain Knob and/or CV
+ *    Knob A3/Jack A3: Release Knob and/or CV
+ *    Digital Out 1:   Unused
+ *    Digital Out 2:   Unused
+ *    Clock In:        Unused
+ *    Analog Out:      Unused (see above)
+ *  Input Expander:
+ *    Knob A4/Jack A4: Envelope Gate.
+ *    Knob A5/Jack A5: Analog Out 11 polarity. Below half: envelope, above: inverted.
+ *  Output Expander:
+ *    Bit 0:           Gate
+ *    Bit 1:           Attack
+ *    Bit 2:           Decay
+ *    Bit 3:           Sustain
+ *    Bit 4:           Release (till the envelope is back at 0)
+ *    Bit 5:           Envelope is above 0
+ *    Bit 6:           Unused (pin 11, the PWM)
+ *    Bit 7:           Envelope is above half
+ *    Analog Out 11:   ADSR OUT (PWM, 62.5kHz, 256 steps)
+ *    Digital Out 13:  Unused
+ *
+ *  Created:  Oct 18 2026 by Peter Fawcett, from ssbMonoADSR_EX.
+ *  ============================================================
+ *
+ *  License:
+ *
+ *  This software is licensed under the Creative Commons
+ *  "Attribution-NonCommercial license. This license allows you
+ *  to tweak and build upon the code for non-commercial purposes,
+ *  without the requirement to license derivative works on the
+ *  same terms. If you wish to use this (or derived) work for
+ *  commercial work, please contact Peter Fawcett at our website
+ *  (www.SoundSweepsBy.com).
+ *
+ *  For more information on the Creative Commons CC BY-NC license,
+ *  visit http://creativecommons.org/licenses/
+ */
+
+#include <ssbEnvelope.h>
+#include <ssbPwmDac.h>
+
+// PROFILING: uncomment to time each section of the loop. The report is
+// written to serial every 2 seconds.
+//#define SSB_PROFILE
+#include <ssbDebugLevel.h>
+
+const boolean OFF          = 0;
+const boolean ON           = 1;
+const int     GATE_ON      = 650;  // Amount above which gate is considered on.
+const int     GATE_OFF     = 600;  // Amount below which gate is considered off.
+                                   // Set Gate off lower to help prevent some jitter.
+const int     INVERT_ON    = 512;  // A5 above this inverts Analog Out 11.
+//  constants related to the Arduino Nano pin use
+const int     pinOffset    = 5;       // DAC     -> the first DAC pin (from 5-12)
+
+// Stage gate bits (expander).
+const byte    BIT_GATE     = B00000001;
+const byte    BIT_ATTACK   = B00000010;
+const byte    BIT_DECAY    = B00000100;
+const byte    BIT_SUSTAIN  = B00001000;
+const byte    BIT_RELEASE  = B00010000;
+const byte    BIT_ACTIVE   = B00100000;
+const byte    BIT_HALF     = B10000000;
+
+// EDIT THESE VALUES TO CHANGE THE ENVELOPE CURVES!!!!
+// ENV_CURVE_LINEAR, ENV_CURVE_EXP (slow start, fast finish),
+// ENV_CURVE_LOG (fast start, slow finish, like an analog envelope) or ENV_CURVE_S.
+const byte    ATTACK_CURVE   = ENV_CURVE_LINEAR;
+const byte    DECAY_CURVE    = ENV_CURVE_LINEAR;
+const byte    RELEASE_CURVE  = ENV_CURVE_LINEAR;
+
+// Current Gate State
+boolean gateState = OFF;
+
+// Current Envelope
+int envelopeVal = 0;
+ssbEnvelope ENVELOPE = ssbEnvelope();
+ssbPwmDac   PWM_OUT  = ssbPwmDac();
+
+#ifdef SSB_PROFILE
+ssbDebug    DEBUG   = ssbDebug(2000);
+ssbProfile  PROFILE = ssbProfile();
+#endif
+
+/*  ==================== setup() START ======================
+ *
+ *  Setup patch. Enable state of pins as needed.
+ *  This code will run once at start of patch, right after load.
+ */
+void setup()
+{
+#ifdef SSB_PROFILE
+    DEBUG.enableSerial();
+    DEBUG.debugState(true);
+    PROFILE.begin();
+#endif
+    ENVELOPE.setCurve(ENV_ATTACK, ATTACK_CURVE);
+    ENVELOPE.setCurve(ENV_DECAY, DECAY_CURVE);
+    ENVELOPE.setCurve(ENV_RELEASE, RELEASE_CURVE);
+    // set up the 8-bit DAC output pins
+    for (int i = 0; i < 8; i++)
+    {
+        pinMode(pinOffset+i, OUTPUT);
+        digitalWrite(pinOffset+i, LOW);
+    }
+    // Pin 11 (DAC bit 6) is the PWM from here on.
+    PWM_OUT.begin();
+}
+//  ==================== setup() END =======================
+
+
+/*  ==================== loop() START =======================
+ *
+ *  Master Loop.
+ *  Loop will be called over and over with out pause.
+ *  Main logic of patch.
+ */
+void loop()
+{
+    SSB_PROFILE_BEGIN(PROFILE, PROF_GATE);
+    gateState = gate_state(gateState, analogRead(4));
+    SSB_PROFILE_END(PROFILE, PROF_GATE);
+
+    SSB_PROFILE_BEGIN(PROFILE, PROF_CTL_SCAN);
+    ENVELOPE.setAttack(analogRead(0));
+    ENVELOPE.setDecay(analogRead(1));
+    ENVELOPE.setSustain(analogRead(2));
+    ENVELOPE.setRelease(analogRead(3));
+    SSB_PROFILE_END(PROFILE, PROF_CTL_SCAN);
+
+    SSB_PROFILE_BEGIN(PROFILE, PROF_ENVELOPE);
+    ENVELOPE.setGate(gateState);
+    envelopeVal = ENVELOPE.updateState();
+    SSB_PROFILE_END(PROFILE, PROF_ENVELOPE);
+
+    // Envelope to the PWM (one register write), stages to the expander bits.
+    SSB_PROFILE_BEGIN(PROFILE, PROF_DAC);
+    if (analogRead(5) > INVERT_ON)
+    {
+        PWM_OUT.output(ENV_MAX - envelopeVal);
+    }
+    else
+    {
+        PWM_OUT.output(envelopeVal);
+    }
+    dacOutput(stage_bits(gateState, ENVELOPE.getState(), envelopeVal));
+    SSB_PROFILE_END(PROFILE, PROF_DAC);
+
+#ifdef SSB_PROFILE
+    DEBUG.updateTicks();
+    DEBUG.debugProfile(&PROFILE);
+#endif
+}
+
+//  ==================== loop() END =======================
+
+boolean gate_state(boolean gate, int currentGate)
+{
+    if (currentGate > GATE_ON)
+    {
+        gate = ON;
+    }
+    else if (currentGate < GATE_OFF)
+    {
+        gate = OFF;
+    }
+    return gate;
+}
+
+byte stage_bits(boolean gate, byte state, int value)
+{
+    byte bits = 0;
+    if (gate == ON)
+    {
+        bits |= BIT_GATE;
+    }
+    if (state == ENV_ATTACK)
+    {
+        bits |= BIT_ATTACK;
+    }
+    else if (state == ENV_DECAY)
+    {
+        bits |= BIT_DECAY;
+    }
+    else if (state == ENV_SUSTAIN)
+    {
+        bits |= BIT_SUSTAIN;
+    }
+    else if (value > 0)
+    {
+        bits |= BIT_RELEASE;
+    }
+    if (value > 0)
+    {
+        bits |= BIT_ACTIVE;
+    }
+    if (value > (ENV_MAX / 2))
+    {
+        bits |= BIT_HALF;
+    }
+    return bits;
+}
+
+//  =================== convenience routines ===================
+
+//  dacOutput(byte) - write the expander bits, with bit 6 (pin 11) masked
+//  out. The PWM owns pin 11, and its port bit stays low so the pin is low
+//  if the PWM is stopped.
+//  ------------------------------------------
+void dacOutput(byte v)
+{
+    v &= ~PWM_DAC_BIT;
+    PORTB = (PORTB & B11100000) | (v >> 3);
+    PORTD = (PORTD & B00011111) | ((v & B00000111) << 5);
+}
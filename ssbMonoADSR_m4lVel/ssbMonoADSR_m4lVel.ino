@@ -40,6 +40,12 @@
  *                         - Refactored loop into more supportable helper functions.
  *            Jan 01 2014  - Fixed A number of bugs.
  *                         - Updated the timing calculation code for attack, decay and release.
+ *            Oct 18 2026  - Envelope moved to ssbEnvelope (fixed point, no float math).
+ *                         - Gate on during release now restarts the attack (was a jump to sustain).
+ *                         - Attack, decay and release are times (2ms - 5s), not per loop amounts.
+ *                         - Added attack, decay and release curves (ATTACK_CURVE etc. below).
+ *            Oct 18 2026  - Added velocity curves (VELOCITY_CURVE below). The peak is only
+ *                           looked up when a new velocity arrives.
  *  ============================================================
  *
  *  License:
@@ -56,11 +62,12 @@
  *  visit http://creativecommons.org/licenses///
  */
  
-// Envelope States:
-const int     ATTACK       = 0;
-const int     DECAY        = 1;
-const int     SUSTAIN      = 2;
-const int     RELEASE      = 3;
+#include <ssbEnvelope.h>
+
+// PROFILING: uncomment to time each section of the loop. The report is
+// written to serial every 2 seconds.
+//#define SSB_PROFILE
+#include <ssbDebugLevel.h>
 
 const int     ENVELOPE_MAX = 1023;
 const boolean OFF          = 0;
@@ -73,28 +80,34 @@ const int     BAUD_RATE    = 9600;
 const int     pinOffset    = 5;       // DAC     -> the first DAC pin (from 5-12)
 
 // EDIT THIS VALUE TO CHANGE SUSTAIN AMOUNT!!!!
-int           SUSTAIN_AMOUNT = 70;    // Percent value (int)  0 - 100.
+const int     SUSTAIN_AMOUNT = 70;    // Percent value (int)  0 - 100.
+const int     SUSTAIN_CTL    = (SUSTAIN_AMOUNT * 1023L) / 100;
+
+// EDIT THESE VALUES TO CHANGE THE ENVELOPE CURVES!!!!
+// ENV_CURVE_LINEAR, ENV_CURVE_EXP (slow start, fast finish),
+// ENV_CURVE_LOG (fast start, slow finish, like an analog envelope) or ENV_CURVE_S.
+const byte    ATTACK_CURVE   = ENV_CURVE_LINEAR;
+const byte    DECAY_CURVE    = ENV_CURVE_LINEAR;
+const byte    RELEASE_CURVE  = ENV_CURVE_LINEAR;
+
+// EDIT THIS VALUE TO CHANGE THE VELOCITY CURVE!!!!
+// ENV_VELOCITY_LINEAR, ENV_VELOCITY_SOFT (loud with a light touch),
+// ENV_VELOCITY_HARD (needs a hard touch) or ENV_VELOCITY_FIXED (ignore velocity).
+const byte    VELOCITY_CURVE = ENV_VELOCITY_LINEAR;
 
-// Envelope State:
-// - 0 : attack phase     [gate on       -> max envelope  (or gate off)]
-// - 1 : decay phase      [max envelope  -> sustain level (or gate off)]
-// - 2 : sustain phase    [sustain level -> gate off                   ]
-// - 3 : release phase    [gate off      -> 0             (or gate on) ]
-int envelopeState = ATTACK;
 // Current Gate State
 boolean gateState = OFF;
 
 // Current Envelope
-float envelopeVal = 0.0;
-
-// Envelope Values
-float attackValue  = 0.0;
-float decayValue   = 0.0;
-float sustainValue = 0.0;
-float releaseValue = 0.0;
+int envelopeVal = 0;
+ssbEnvelope ENVELOPE = ssbEnvelope();
 
 String rawVelStr = "";
-int currentVelocity = ENVELOPE_MAX;
+
+#ifdef SSB_PROFILE
+ssbDebug    DEBUG   = ssbDebug(2000);
+ssbProfile  PROFILE = ssbProfile();
+#endif
 
 /*  ==================== setup() START ======================
  *
@@ -103,7 +116,15 @@ int currentVelocity = ENVELOPE_MAX;
  */
 void setup()
 {
+#ifdef SSB_PROFILE
+    DEBUG.debugState(true);
+    PROFILE.begin();
+#endif
     Serial.begin(BAUD_RATE);
+    ENVELOPE.setCurve(ENV_ATTACK, ATTACK_CURVE);
+    ENVELOPE.setCurve(ENV_DECAY, DECAY_CURVE);
+    ENVELOPE.setCurve(ENV_RELEASE, RELEASE_CURVE);
+    ENVELOPE.setVelocityCurve(VELOCITY_CURVE);
     // set up the 8-bit DAC output pins
     for (int i = 0; i < 8; i++)
     {
@@ -130,68 +151,47 @@ void loop()
        - If A2 is not connected to a gate signal.
            Knob will adjust gate amount between 0 and 1023.
     */
+    SSB_PROFILE_BEGIN(PROFILE, PROF_GATE);
     gateState = gate_state(gateState, analogRead(2));
+    SSB_PROFILE_END(PROFILE, PROF_GATE);
 
     // Check the serial input to see if there in new velocity data to process.
+    SSB_PROFILE_BEGIN(PROFILE, PROF_SERIAL);
     process_velocity();
+    SSB_PROFILE_END(PROFILE, PROF_SERIAL);
     /*
         get current state of controls.
-        - Note that attack, decay and release are the ammounts to add to/subtract from
-          the current envelope value.
-          Larger values on the knobs, become smaller add/subtract increments and thus
-          longer attack/decay/releases...
+        - Note that attack, decay and release are stage times, from 2ms (knob at 0)
+          to 5s (knob at max). The times are real time, so they do not change when
+          the loop slows down.
         - But sustain is not an increment. it's a fixed value to sustain at. Thus
           use the sustainBase (for now, may use gateValue in future)
     */
-    attackValue = map_float(analogRead(0), 0, 1023, 204.6, .5);
-    decayValue = map_float(analogRead(1), 0, 1023, 204.6, .5);
-    sustainValue = (int)(currentVelocity * (float)(SUSTAIN_AMOUNT / 100.0));
-    releaseValue = map_float(analogRead(3), 0, 1023, 204.6, .5);
+    SSB_PROFILE_BEGIN(PROFILE, PROF_CTL_SCAN);
+    ENVELOPE.setAttack(analogRead(0));
+    ENVELOPE.setDecay(analogRead(1));
+    ENVELOPE.setSustain(SUSTAIN_CTL);
+    ENVELOPE.setRelease(analogRead(3));
+    SSB_PROFILE_END(PROFILE, PROF_CTL_SCAN);
     
-    int envLoopState = ATTACK;
-
-    if (gateState == ON)
-    {
-        if (envelopeState == RELEASE)
-        {
-            envLoopState = ATTACK;
-        }
-        if (envelopeState == ATTACK)     // Attack
-        {
-            envLoopState = ATTACK;
-            envelopeVal = do_attack_inc(envelopeVal, attackValue);
-        }
-        else if (envelopeState == DECAY) // Decay
-        {
-            envLoopState = DECAY;
-            envelopeVal = do_decay_dec(envelopeVal, decayValue, sustainValue);
-        }
-        else                             // Sustain
-        {
-            envLoopState = SUSTAIN;
-            envelopeVal = sustainValue;
-        }
-    }
-    else                                 // Release
-    {
-        envLoopState = RELEASE;
-        envelopeVal = do_release_dec(envelopeVal, releaseValue);
-    }
-
-    // Keep track of state based on envelope, current state and gate state.
-    envelopeState = envelope_state(envelopeState, envLoopState, envelopeVal, sustainValue);
+    SSB_PROFILE_BEGIN(PROFILE, PROF_ENVELOPE);
+    ENVELOPE.setGate(gateState);
+    envelopeVal = ENVELOPE.updateState();
+    SSB_PROFILE_END(PROFILE, PROF_ENVELOPE);
 
     // Write envelope to DAC.
-    dacOutput(((long)envelopeVal >> 2));
+    SSB_PROFILE_BEGIN(PROFILE, PROF_DAC);
+    dacOutput((envelopeVal >> 2));
+    SSB_PROFILE_END(PROFILE, PROF_DAC);
+
+#ifdef SSB_PROFILE
+    DEBUG.updateTicks();
+    DEBUG.debugProfile(&PROFILE);
+#endif
 }
 
 //  ==================== loop() END =======================
 
-float map_float(float x, float in_min, float in_max, float out_min, float out_max)
-{
-  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
-}
-
 void process_velocity()
 {
     if (Serial.available() > 0)
@@ -203,7 +203,8 @@ void process_velocity()
         }
         else if(c == ']')
         {
-            currentVelocity = convert_string_to_int(rawVelStr);
+            // Velocity is sent scaled to 0 - 1023, back to 0 - 127.
+            ENVELOPE.setVelocity(convert_string_to_int(rawVelStr) >> 3);
         }
         else
         {
@@ -231,71 +232,6 @@ boolean gate_state(boolean gate, int currentGate)
     }
     return gate;
 }
-
-int envelope_state(int state, int currentState, float envelopeVal, float sustainVal)
-{
-    if (envelopeVal >= currentVelocity)
-    {
-        state = DECAY;
-    }
-    else if ((state == DECAY) && (envelopeVal <= sustainVal))
-    {
-        state = SUSTAIN;
-    }
-    else if (envelopeVal <= 0)
-    {
-        state = ATTACK;
-    }
-    else if (state != currentState)
-    {
-        state = currentState;
-    }
-    return state;
-}
-
-float do_attack_inc(float envelopeVal, float attackValue)
-{
-    envelopeVal = (envelopeVal + attackValue); //step up to full level
-    if (envelopeVal >= currentVelocity)
-    {
-        envelopeVal = currentVelocity;
-    }
-    return envelopeVal;
-}
-
-float do_decay_dec(float envelopeVal, float decayValue, float sustainValue)
-{
-    if (envelopeVal > sustainValue) //stop at sustain level
-    {
-        // Decriment by decay value.
-        envelopeVal = (envelopeVal - decayValue);
-    }
-    // if envelope is < 0 set to 0. Shouldn't get here unless sustain is 0.
-    if (envelopeVal <= 0)
-    {
-        envelopeVal = 0;
-    }
-    else if (envelopeVal < sustainValue)
-    {
-        // if current envelope got set lower than sustain, set it to sustain.
-        envelopeVal = sustainValue;
-    }
-    return envelopeVal;
-}
-
-float do_release_dec(float envelopeVal, float releaseValue)
-{
-    if (envelopeVal > 0)
-    {
-        // calculate new value of releasse envelope.
-        envelopeVal = envelopeVal - releaseValue;
-    }
-    if (envelopeVal < 0)
-    {
-        envelopeVal = 0; // if below 0, set to 0.
-    }
-    return envelopeVal;
-}
     
 
 //  =================== convenience routines ===================
@@ -8,6 +8,11 @@
  * This data would most likely be sent by the ssbArdCoreVel.maxpat patch or the 
  * ssbArdCoreVel.amxd device. This allows scaling of notes via velocity data.
  * These patches are in the ssbArdLive folder.
+ *
+ * MIDI Input: Set MIDI_INPUT (below) to ON to skip Max/Live and read raw MIDI bytes
+ * from a USB-MIDI to serial bridge instead. The gate then follows the held note
+ * (last note priority) and the peak level follows the note velocity. A4 is unused
+ * in this mode. Set MIDI_BAUD_RATE to match the bridge.
  * 
  * Attack (A0), Decay (A1), Sustain (A2) and Release (A3).
  * Sustain and release should be CV controlable (but testing of sustain CV is on going).
@@ -33,7 +38,7 @@
  *    Clock In:        Unused
  *    Analog Out:      ADSR OUT
  *  Input Expander: 
- *    Knob A4/Jack A4: Envelope Gate.
+ *    Knob A4/Jack A4: Envelope Gate (Unused in MIDI mode).
  *    Knob A5/Jack A5: Unused
  *  Output Expander:
  *    Bits 0-7:        Each bit of the envelope
@@ -45,6 +50,13 @@
  *                         - Refactored loop into more supportable helper functions.
  *            Jan 01 2014  - Fixed A number of bugs.
  *                         - Updated the timing calculation code for attack, decay and release.
+ *            Oct 18 2026  - Added raw MIDI input mode using ssbMidiIn.
+ *            Oct 18 2026  - Envelope moved to ssbEnvelope (fixed point, no float math).
+ *                         - Gate on during release now restarts the attack (was a jump to sustain).
+ *                         - Attack, decay and release are times (2ms - 5s), not per loop amounts.
+ *                         - Added attack, decay and release curves (ATTACK_CURVE etc. below).
+ *            Oct 18 2026  - Added velocity curves (VELOCITY_CURVE below). The peak is only
+ *                           looked up when a new velocity arrives.
  *  ============================================================
  *
  *  License:
@@ -60,13 +72,16 @@
  *  For more information on the Creative Commons CC BY-NC license,
  *  visit http://creativecommons.org/licenses///
  */
- 
-// Envelope States:
-const int     ATTACK       = 0;
-const int     DECAY        = 1;
-const int     SUSTAIN      = 2;
-const int     RELEASE      = 3;
 
+#include <ssbMidiIn.h>
+
+#include <ssbEnvelope.h>
+
+// PROFILING: uncomment to time each section of the loop. The report is
+// written to serial every 2 seconds.
+//#define SSB_PROFILE
+#include <ssbDebugLevel.h>
+ 
 const int     ENVELOPE_MAX = 1023;
 const boolean OFF          = 0;
 const boolean ON           = 1;
@@ -75,31 +90,42 @@ const int     GATE_OFF     = 600;  // Amount below which gate is considered off.
                                    // Set Gate off lower to help prevent some jitter.
 const int     BAUD_RATE    = 9600;
 
+// EDIT THESE VALUES TO USE RAW MIDI INPUT!!!!
+const boolean MIDI_INPUT     = OFF;    // ON: read MIDI bytes, OFF: read [n] strings.
+const long    MIDI_BAUD_RATE = MIDI_BAUD;
+
 //  constants related to the Arduino Nano pin use
 const int     pinOffset    = 5;       // DAC     -> the first DAC pin (from 5-12)
 
-// Envelope State:
-// - 0 : attack phase     [gate on       -> max envelope  (or gate off)]
-// - 1 : decay phase      [max envelope  -> sustain level (or gate off)]
-// - 2 : sustain phase    [sustain level -> gate off                   ]
-// - 3 : release phase    [gate off      -> 0             (or gate on) ]
-int envelopeState = ATTACK;
+// EDIT THESE VALUES TO CHANGE THE ENVELOPE CURVES!!!!
+// ENV_CURVE_LINEAR, ENV_CURVE_EXP (slow start, fast finish),
+// ENV_CURVE_LOG (fast start, slow finish, like an analog envelope) or ENV_CURVE_S.
+const byte    ATTACK_CURVE   = ENV_CURVE_LINEAR;
+const byte    DECAY_CURVE    = ENV_CURVE_LINEAR;
+const byte    RELEASE_CURVE  = ENV_CURVE_LINEAR;
+
+// EDIT THIS VALUE TO CHANGE THE VELOCITY CURVE!!!!
+// ENV_VELOCITY_LINEAR, ENV_VELOCITY_SOFT (loud with a light touch),
+// ENV_VELOCITY_HARD (needs a hard touch) or ENV_VELOCITY_FIXED (ignore velocity).
+const byte    VELOCITY_CURVE = ENV_VELOCITY_LINEAR;
+
 // Current Gate State
 boolean gateState = OFF;
 
 // Current Envelope
-float envelopeVal = 0.0;
-
-// Envelope Values
-float attackValue  = 0.0;
-float decayValue   = 0.0;
-float sustainValue = 0.0;
-float releaseValue = 0.0;
+int envelopeVal = 0;
+ssbEnvelope ENVELOPE = ssbEnvelope();
 
 String rawVelStr = "";
-int currentVelocity = ENVELOPE_MAX;
 
 
+ssbMidiIn MIDI = ssbMidiIn(MIDI_OMNI);
+
+#ifdef SSB_PROFILE
+ssbDebug    DEBUG   = ssbDebug(2000);
+ssbProfile  PROFILE = ssbProfile();
+#endif
+
 /*  ==================== setup() START ======================
  *
  *  Setup patch. Enable state of pins as needed.
@@ -107,7 +133,22 @@ int currentVelocity = ENVELOPE_MAX;
  */
 void setup()
 {
-    Serial.begin(BAUD_RATE);
+#ifdef SSB_PROFILE
+    DEBUG.debugState(true);
+    PROFILE.begin();
+#endif
+    if (MIDI_INPUT == ON)
+    {
+        MIDI.enableSerial(MIDI_BAUD_RATE);
+    }
+    else
+    {
+        Serial.begin(BAUD_RATE);
+    }
+    ENVELOPE.setCurve(ENV_ATTACK, ATTACK_CURVE);
+    ENVELOPE.setCurve(ENV_DECAY, DECAY_CURVE);
+    ENVELOPE.setCurve(ENV_RELEASE, RELEASE_CURVE);
+    ENVELOPE.setVelocityCurve(VELOCITY_CURVE);
     // set up the 8-bit DAC output pins
     for (int i = 0; i < 8; i++)
     {
@@ -128,83 +169,60 @@ void loop()
 {
     /*
         get current state of controls.
-        - Note that attack, decay and release are the ammounts to add to/subtract from
-          the current envelope value.
-          Larger values on the knobs, become smaller add/subtract increments and thus
-          longer attack/decay/releases...
+        - Note that attack, decay and release are stage times, from 2ms (knob at 0)
+          to 5s (knob at max). The times are real time, so they do not change when
+          the loop slows down.
         - But sustain is not an increment. it's a fixed value to sustain at. Thus
           use the sustainBase (for now, may use gateValue in future)
         - Gate input in A4 on Expander. To do manual trigger, feed positive signal into
           input so that the atenuator has something to attenuate (like a signal from 
           Maths out 2 or 3) 
     */
-    gateState = gate_state(gateState, analogRead(4));
-
-    // Check the serial input to see if there in new velocity data to process.
-    process_velocity();
-
-    // Get the envelope pariters.
-    // Uses the envelope max data (set in process_velocity) for sustain level. 
-    attackValue = calc_rate((float)analogRead(0));
-    decayValue = calc_rate((float)analogRead(1));
-    sustainValue = calc_level(analogRead(2));
-    releaseValue = calc_rate((float)analogRead(3));
-    
-    int envLoopState = ATTACK;
-
-    if (gateState == ON)
+    if (MIDI_INPUT == ON)
     {
-        if (envelopeState == RELEASE)
-        {
-            envLoopState = ATTACK;
-        }
-        if (envelopeState == ATTACK)     // Attack
-        {
-            envLoopState = ATTACK;
-            envelopeVal = do_attack_inc(envelopeVal, attackValue);
-        }
-        else if (envelopeState == DECAY) // Decay
-        {
-            envLoopState = DECAY;
-            envelopeVal = do_decay_dec(envelopeVal, decayValue, sustainValue);
-        }
-        else                             // Sustain
-        {
-            envLoopState = SUSTAIN;
-            envelopeVal = sustainValue;
-        }
+        // Gate and velocity both come from the MIDI stream.
+        SSB_PROFILE_BEGIN(PROFILE, PROF_SERIAL);
+        process_midi();
+        SSB_PROFILE_END(PROFILE, PROF_SERIAL);
     }
-    else                                 // Release
+    else
     {
-        envLoopState = RELEASE;
-        envelopeVal = do_release_dec(envelopeVal, releaseValue);
+        SSB_PROFILE_BEGIN(PROFILE, PROF_GATE);
+        gateState = gate_state(gateState, analogRead(4));
+        SSB_PROFILE_END(PROFILE, PROF_GATE);
+
+        // Check the serial input to see if there in new velocity data to process.
+        SSB_PROFILE_BEGIN(PROFILE, PROF_SERIAL);
+        process_velocity();
+        SSB_PROFILE_END(PROFILE, PROF_SERIAL);
     }
 
-    // Keep track of state based on envelope, current state and gate state.
-    envelopeState = envelope_state(envelopeState, envLoopState, envelopeVal, sustainValue);
+    // Get the envelope pariters.
+    // Uses the envelope max data (set in process_velocity) for sustain level. 
+    SSB_PROFILE_BEGIN(PROFILE, PROF_CTL_SCAN);
+    ENVELOPE.setAttack(analogRead(0));
+    ENVELOPE.setDecay(analogRead(1));
+    ENVELOPE.setSustain(analogRead(2));
+    ENVELOPE.setRelease(analogRead(3));
+    SSB_PROFILE_END(PROFILE, PROF_CTL_SCAN);
+    
+    SSB_PROFILE_BEGIN(PROFILE, PROF_ENVELOPE);
+    ENVELOPE.setGate(gateState);
+    envelopeVal = ENVELOPE.updateState();
+    SSB_PROFILE_END(PROFILE, PROF_ENVELOPE);
 
     // Write envelope to DAC.
-    dacOutput(((long)envelopeVal >> 2));
-}
-
-//  ==================== loop() END =======================
+    SSB_PROFILE_BEGIN(PROFILE, PROF_DAC);
+    dacOutput((envelopeVal >> 2));
+    SSB_PROFILE_END(PROFILE, PROF_DAC);
 
-float calc_rate(float analogIn)
-{
-    return map_float(analogIn, 0, 1023, 204.6, .5);
-}
-
-float map_float(float x, float in_min, float in_max, float out_min, float out_max)
-{
-  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+#ifdef SSB_PROFILE
+    DEBUG.updateTicks();
+    DEBUG.debugProfile(&PROFILE);
+#endif
 }
 
-float calc_level(int analogIn)
-{
-    int percent;
-    percent = map(analogIn, 0, 1023, 0, 100);
-    return (currentVelocity * (float)(percent / 100.0));
-}
+//  ==================== loop() END =======================
 
 void process_velocity()
 {
@@ -217,7 +235,8 @@ void process_velocity()
         }
         else if(c == ']')
         {
-            currentVelocity = convert_string_to_int(rawVelStr);
+            // Velocity is sent scaled to 0 - 1023, back to 0 - 127.
+            ENVELOPE.setVelocity(convert_string_to_int(rawVelStr) >> 3);
         }
         else
         {
@@ -226,6 +245,15 @@ void process_velocity()
     }
 }
 
+void process_midi()
+{
+    if (MIDI.doRead() == MIDI_NOTE_ON)
+    {
+        ENVELOPE.setVelocity(MIDI.getVelocity());
+    }
+    gateState = MIDI.getGate();
+}
+
 int convert_string_to_int(String str)
 {
     char test[str.length() + 1];
@@ -245,71 +273,6 @@ boolean gate_state(boolean gate, int currentGate)
     }
     return gate;
 }
-
-int envelope_state(int state, int currentState, float envelopeVal, float sustainVal)
-{
-    if (envelopeVal >= currentVelocity)
-    {
-        state = DECAY;
-    }
-    else if ((state == DECAY) && (envelopeVal <= sustainVal))
-    {
-        state = SUSTAIN;
-    }
-    else if (envelopeVal <= 0)
-    {
-        state = ATTACK;
-    }
-    else if (state != currentState)
-    {
-        state = currentState;
-    }
-    return state;
-}
-
-float do_attack_inc(float envelopeVal, float attackValue)
-{
-    envelopeVal = (envelopeVal + attackValue); //step up to full level
-    if (envelopeVal >= currentVelocity)
-    {
-        envelopeVal = currentVelocity;
-    }
-    return envelopeVal;
-}
-
-float do_decay_dec(float envelopeVal, float decayValue, float sustainValue)
-{
-    if (envelopeVal > sustainValue) //stop at sustain level
-    {
-        // Decriment by decay value.
-        envelopeVal = (envelopeVal - decayValue);
-    }
-    // if envelope is < 0 set to 0. Shouldn't get here unless sustain is 0.
-    if (envelopeVal <= 0)
-    {
-        envelopeVal = 0;
-    }
-    else if (envelopeVal < sustainValue)
-    {
-        // if current envelope got set lower than sustain, set it to sustain.
-        envelopeVal = sustainValue;
-    }
-    return envelopeVal;
-}
-
-float do_release_dec(float envelopeVal, float releaseValue)
-{
-    if (envelopeVal > 0)
-    {
-        // calculate new value of releasse envelope.
-        envelopeVal = envelopeVal - releaseValue;
-    }
-    if (envelopeVal < 0)
-    {
-        envelopeVal = 0; // if below 0, set to 0.
-    }
-    return envelopeVal;
-}
     
 
 //  =================== convenience routines ===================
@@ -6,6 +6,11 @@ Description:
     on or hit the reset button on the expander. Note: the expander is required for the
     full functionality of most of these patches.
 
+    The patch and output type may also be switched live, with out a reset, by serial
+    commands (9600 baud): 'p' and the patch number (p0 - p3), or 'o' and the output
+    type number (o0 - o3). The switch is made on the next clock pulse and the step
+    counters keep running, so the new patch stays in phase with the old one.
+
     The Analog Out / Bit Outputs on the expander have 4 types of output as well. All are
     based on updated values for each clock input pulse. The four types are set by the
     position of the A1 knob on power on / when the reset button on the expander is hit.
@@ -15,8 +20,8 @@ Description:
         - Byte Counter: count bytes (0, 1, 10, 11, 100, 101, 110, 111...) on the Bit
                               Output.
                               The Analog output is stepped accordingly.
-        - Pattern Cycle: cycle through a sequence of 8 patterns on the Bit Output. The
-                              Analog output is stepped accordingly.
+        - Pattern Cycle: cycle through the sequence of patterns (PATS) on the Bit
+                              Output. The Analog output is stepped accordingly.
                               Patterns:
                                   1: x . x . x . x .
                                   2: . x . x . x . x
@@ -62,7 +67,7 @@ Description:
                              and reset.
             Analog Out 11:   Unused
             Digital Out 13:  Unused
-        Serial:              Unused (debug)
+        Serial:              Patch / output type switch (see above)
 
     Patch 2: ssbPrimeCounter
         Description:
@@ -88,7 +93,7 @@ Description:
                              and reset.
             Analog Out 11:   Unused
             Digital Out 13:  Unused
-        Serial:              Unused (debug)
+        Serial:              Patch / output type switch (see above)
 
         
     Patch 3: ssbPatter
@@ -125,14 +130,63 @@ Description:
                              and reset.
             Analog Out 11:   Unused
             Digital Out 13:  Unused
-        Serial:              Unused (debug)
+        Serial:              Patch / output type switch (see above)
         Count pulses in the clock input and for every #n pulses output a pulse on D0/D1.
 
-    Patch 4: To Be Determined
-        
+    Patch 4: ssbEuclid
+        Description:
+            Input Clock or Gate Signals on the clock input.
+            Euclidean rhythms: spread a number of hits as evenly as possible
+            over a number of steps (3 hits in 8 steps is x . . x . . x .), then
+            rotate the pattern. Each pattern is worked out once when its
+            controls change, so a clock pulse is only a bit test and a shift.
+            The expander bits are an eight lane Euclidean trigger bank. Bits 0
+            and 1 follow D0 and D1, bits 2-7 play the EUC_LANES patterns (edit
+            below). The A1 output type is not used by this patch.
+
+        I/O Usage:
+            Knob A0:         Hits for D0 (0 - steps).
+            Knob A1:         Hits for D1 (0 - steps).
+            Knob/Jack A2:    Steps for D0 (2 - 32).
+            Knob/Jack A3:    Steps for D1 (2 - 32).
+            Digital Out 1:   Gate Output 1
+            Digital Out 2:   Gate Output 2
+            Clock In:        Gate / Clock In
+            Analog Out:      Stepped Voltage (sum of the trigger bank)
+        Input Expander:
+            Knob A4/Jack A4: Rotation of D0 (0 - steps - 1).
+            Knob A5/Jack A5: Rotation of D1 (0 - steps - 1).
+        Output Expander:
+            Bits 0-7:        Euclidean trigger bank. Bit 0 is D0, bit 1 is D1,
+                             bits 2-7 are the EUC_LANES patterns.
+            Analog Out 11:   Unused
+            Digital Out 13:  Unused
+        Serial:              Patch / output type switch (see above)
         
     Created:  Oct 30 2014 by Peter Fawcett (SoundSweepsBy).
         Version 1 - Original patch developement.
+        Version 2 - Oct 18 2026:
+          Debugging uses compile time levels (ssbDebugLevel).
+        Version 3 - Oct 18 2026:
+          Patch 4 is a Euclidean rhythm generator (ssbEuclid).
+        Version 4 - Oct 18 2026:
+          Skip, prime, pattern and output steps come from a bank of countdown
+          dividers (ssbDivider), not a modulo of the step count each pulse.
+          Fixed the pulse divider output (bit 0 was a modulo by 0) and the
+          pattern start (was a bool, so only 0 or 1).
+        Version 5 - Oct 18 2026:
+          Patches are a table of update / step / release functions (PATCHES)
+          and the output types a table of render functions (DAC_RENDERS),
+          rather than a switch on each pulse. Patch and output type may be
+          switched over serial on a clock pulse, with out a reset.
+        Version 6 - Oct 18 2026:
+          The ssbSkipper random skip uses ssbRandom (xorshift) rather than
+          random(), with the weight worked out into a threshold only when the
+          expander control changes.
+        Version 7 - Oct 18 2026:
+          Patterns are one byte (bit mask) each in flash, so more may be added
+          with out using SRAM. Start and length are bit operations on the mask
+          and the pattern cycle writes the mask straight to the expander.
 
     ============================================================
 
@@ -154,8 +208,14 @@ Description:
 
 #include <ssbArdBase.h>
 #include <ssbGate.h>
+#include <ssbEuclid.h>
+#include <ssbDivider.h>
+#include <ssbRandom.h>
 // DEBUGGING
-//#include <ssbDebug.h>
+// Set to SSB_LEVEL_ERROR, SSB_LEVEL_INFO or SSB_LEVEL_VERBOSE to enable debug
+// output. Debug calls above the level are not compiled in.
+#define SSB_DEBUG_LEVEL SSB_LEVEL_OFF
+#include <ssbDebugLevel.h>
 
 
 
@@ -165,21 +225,49 @@ const int     STATE_KNOB                    = A0_INPUT;
 const int     SSB_SKIPPER                   = 0;
 const int     SSB_PRIME                     = 1;
 const int     SSB_PATT                      = 2;
-const int     SSB_TBD                       = 3;
+const int     SSB_EUCLID                    = 3;
+const int     PATCH_COUNT                   = 4;
 
 const int     DAC_KNOB                      = A1_INPUT;
 const int     SSB_DAC_SEQ_SWITCH            = 0;
 const int     SSB_DAC_BYTE_CNT              = 1;
 const int     SSB_DAC_PAT_CYCLE             = 2;
 const int     SSB_DAC_PULSE_DIV             = 3;
+const int     DAC_TYPES                     = 4;
+
+// Serial patch switch. 'p' or 'o' then the number.
+const int     BAUD_RATE                     = 9600;
+const char    CMD_PATCH                     = 'p';
+const char    CMD_DAC                       = 'o';
+const char    CMD_NONE                      = 0;
+
+// A sub-patch. Each is called through the PATCHES table, so a new patch is
+// a new set of functions and a row in the table.
+typedef void (*ssbPatchFn)();
+struct ssbSubPatch
+{
+    ssbPatchFn  update;         // Rising edge: read controls, set gate divider ratios.
+    ssbPatchFn  step;           // Rising edge, after the dividers are clocked: set gates.
+    ssbPatchFn  release;        // Falling edge.
+    bool        own_bits;       // Writes the expander bits its self (no output type).
+};
 
 // Sketch Variables:
 // ============================================================================
-// Sketch index set on load / reset.
+// Sketch index set on load / reset, or by a serial command.
 int         sketch_index                    = SSB_SKIPPER;
 int         dac_index                       = SSB_DAC_SEQ_SWITCH;
-// Ever increasing counter. Will be modded to determine correct Byte Output state.
-long        step_counter                    = -1;
+// Switch made on the next clock pulse.
+int         next_sketch_index               = SSB_SKIPPER;
+int         next_dac_index                  = SSB_DAC_SEQ_SWITCH;
+char        serial_cmd                      = CMD_NONE;
+// Divider outputs. One countdown counter each, all clocked on every pulse.
+const byte  DIV_STEP_8                      = GATE_COUNT;       // 0 - 7 step (sequential switch).
+const byte  DIV_BYTE_CNT                    = GATE_COUNT + 1;   // 0 - 1022 byte counter.
+const byte  DIV_PAT_CYCLE                   = GATE_COUNT + 2;   // 0 - (PAT_COUNT - 1) pattern cycle.
+const byte  DIV_PULSE                       = GATE_COUNT + 3;   // 8 pulse dividers, / 1 - / 8.
+const byte  DIV_OUTPUTS                     = DIV_PULSE + 8;
+ssbDivider  dividers                        = ssbDivider(DIV_OUTPUTS);
 // Clock State
 bool        clock_state                     = false;
 // Gates for D0 and D1
@@ -202,7 +290,9 @@ const int   SKIP_MAX_RAND                   = 90;
 // Variables:
 // ============================================================================
 bool        skip_step_rand_on[GATE_COUNT]   = {false, false};
-int         skip_step_rand_amt[GATE_COUNT]  = {0, 0};
+int         skip_step_rand_amt[GATE_COUNT]  = {-1, -1};
+unsigned int skip_rand_thresh[GATE_COUNT]   = {0, 0};      // Rand amt as a chance in 256.
+ssbRandom   rand_gen                        = ssbRandom();
 int         skip_step_index[GATE_COUNT]     = {0, 0};
 // ============================================================================
 
@@ -221,30 +311,63 @@ bool        prime_step_invert[GATE_COUNT]   = {false, false};
 // ============================================================================
 //ssbPatter:
 // Constants:
+// EDIT THESE VALUES TO CHANGE OR ADD PATTERNS!!!!
+// One byte per pattern, kept in flash. Bit 0 is the first step (so the
+// steps read right to left in the hex), a 1 is a gate.
 const int   PAT_COUNT                       = 8;
 const int   PAT_STEPS                       = 8;
 const int   PAT_SHIFT_MAX                   = 3;
-const int   PATS[PAT_COUNT][PAT_STEPS]      = {{1, 0, 1, 0, 1, 0, 1, 0},
-                                               {0, 1, 0, 1, 0, 1, 0, 1},
-                                               {1, 0, 0, 0, 1, 0, 0, 0},
-                                               {1, 1, 0, 0, 1, 1, 0, 0},
-                                               {1, 1, 1, 0, 1, 1, 1, 0},
-                                               {0, 0, 1, 0, 0, 0, 1, 0},
-                                               {0, 0, 0, 1, 0, 0, 0, 1},
-                                               {0, 0, 1, 1, 0, 0, 1, 1}};
+const byte  PATS[PAT_COUNT] PROGMEM         = {0x55,        // x . x . x . x .
+                                               0xAA,        // . x . x . x . x
+                                               0x11,        // x . . . x . . .
+                                               0x33,        // x x . . x x . .
+                                               0x77,        // x x x . x x x .
+                                               0x44,        // . . x . . . x .
+                                               0x88,        // . . . x . . . x
+                                               0xCC};       // . . x x . . x x
 const int   PAT_MIN_LEN                     = 4;            
 const int   PAT_MAX_LEN                     = 8;
 // Variables:
 // ============================================================================
 int         patt_index[GATE_COUNT]          = {0, 0};
 int         patt_length[GATE_COUNT]         = {8, 8};
-bool        patt_start[GATE_COUNT]          = {false, false};
-bool        byte_states[PAT_STEPS]          = {false, false, false, false, 
-                                               false, false, false, false};
+int         patt_start[GATE_COUNT]          = {0, 0};
+byte        patt_mask[GATE_COUNT]           = {0, 0};      // Pattern with the start and length.
+// ============================================================================
+
+// ============================================================================
+//ssbEuclid:
+// Constants:
+const int   EUC_MIN_STEPS                   = 2;
+const int   EUC_LANE_COUNT                  = 8;
+// EDIT THESE VALUES TO CHANGE THE TRIGGER BANK!!!!
+// {hits, steps} for expander bits 2 - 7. Bits 0 and 1 follow D0 and D1.
+const byte  EUC_LANES[EUC_LANE_COUNT - GATE_COUNT][2] = {{3, 8},
+                                                         {5, 8},
+                                                         {2, 5},
+                                                         {3, 4},
+                                                         {5, 12},
+                                                         {7, 16}};
+// Variables:
+// ============================================================================
+ssbEuclid   euc_lanes[EUC_LANE_COUNT];
+// ============================================================================
+
+// ============================================================================
+// Patch and output type tables. Index with sketch_index / dac_index.
+// ============================================================================
+const ssbSubPatch PATCHES[PATCH_COUNT]      = {{skipUpdate,   skipStep,   gatesRelease,  false},
+                                               {primeUpdate,  primeStep,  gatesRelease,  false},
+                                               {pattUpdate,   pattStep,   gatesRelease,  false},
+                                               {euclidUpdate, euclidStep, euclidRelease, true}};
+const ssbPatchFn  DAC_RENDERS[DAC_TYPES]    = {renderSeqSwitch,
+                                               renderByteCount,
+                                               renderPattCycle,
+                                               renderPulseDiv};
 // ============================================================================
 
 //DEBUGGING:
-//ssbDebug    DEBUG                           = ssbDebug();
+SSB_DEBUG(ssbDebug    DEBUG                 = ssbDebug();)
 
 //  ==================== setup() START ========================================
 //
@@ -253,13 +376,15 @@ bool        byte_states[PAT_STEPS]          = {false, false, false, false,
 //
 void setup()
 {
-    randomSeed(millis());
+    rand_gen.seedFromNoise(A5_INPUT);
 
     // Read the sketch index from A0 Input.
     sketch_index = analogRead(STATE_KNOB) >> 8;
     
     // Read the sketch index from A1 Input.
     dac_index = analogRead(DAC_KNOB) >> 8;
+    next_sketch_index = sketch_index;
+    next_dac_index = dac_index;
     
     // set up the digital outputs
     for (int i = 0; i < 2; i++)
@@ -273,10 +398,26 @@ void setup()
         pinMode(PIN_OFFSET + i, OUTPUT);
         digitalWrite(PIN_OFFSET + i, LOW);
     }
+    // Fixed dividers for the output types. Gates 0 and 1 are set per pulse.
+    dividers.setRatio(DIV_STEP_8, 8);
+    dividers.setRatio(DIV_BYTE_CNT, 1023);
+    dividers.setRatio(DIV_PAT_CYCLE, PAT_COUNT);
+    for (int i = 0; i < 8; i++)
+    {
+        dividers.setRatio(DIV_PULSE + i, i + 1);
+    }
+    // Fixed lanes of the Euclidean trigger bank.
+    for (int i = GATE_COUNT; i < EUC_LANE_COUNT; i++)
+    {
+        euc_lanes[i].setPattern(EUC_LANES[i - GATE_COUNT][0], EUC_LANES[i - GATE_COUNT][1], 0);
+    }
     setClockInterrupt();
+    // Serial patch switch.
+    Serial.begin(BAUD_RATE);
     // Debugging
-    //DEBUG.enableSerial();
-    //DEBUG.debugState(true);
+    SSB_DEBUG(DEBUG.enableSerial());
+    SSB_DEBUG(DEBUG.debugState(true));
+    SSB_DEBUG_INFO(DEBUG.debugMem());
 }
 
 //  ==================== setup() END ==========================================
@@ -295,73 +436,36 @@ void loop()
     {
         // We have a leading edge of a clock pulse.
         // trigger on the interrupt.
-        step_counter++;
-        switch (sketch_index)
+        // Switch patch / output type on the clock pulse.
+        if (next_sketch_index != sketch_index)
         {
-            case SSB_SKIPPER:
-                for (int i = 0; i < GATE_COUNT; i++)
-                {
-                    skip_step_rand_on[i] = getCtlHighLow(row_one_ctl[i]);
-                    skip_step_index[i] = getCtlIndex(row_two_ctl[i], ALL_SKIP);
-                    skip_step_rand_amt[i] = getCtlIndex(expander_ctl[i], SKIP_MIN_RAND, SKIP_MAX_RAND);
-                    if (!doSkipStep(step_counter, skip_step_index[i], skip_step_rand_on[i], skip_step_rand_amt[i]))
-                    {
-                        d_gates[i].setState(true);
-                    }
-                }
-                break;
-            case SSB_PRIME:
-                for (int i = 0; i < GATE_COUNT; i++)
-                {
-                    prime_step_index[i] = getCtlIndex(row_one_ctl[i], PRIME_23);
-                    prime_step_invert[i] = getCtlHighLow(row_two_ctl[i]);
-                    // expander_ctl unused.
-                    if (doPrimeStep(step_counter, prime_step_index[i], prime_step_invert[i]))
-                    {
-                        d_gates[i].setState(true);
-                    }
-                }
-                break;
-            case SSB_PATT:
-                for (int i = 0; i < GATE_COUNT; i++)
-                {
-                    patt_index[i] = getCtlIndex(row_one_ctl[i], (PAT_COUNT - 1));
-                    patt_start[i] = getCtlIndex(row_two_ctl[i], PAT_SHIFT_MAX);
-                    patt_length[i] = getCtlIndex(expander_ctl[i], PAT_MIN_LEN, PAT_MAX_LEN);
-                    if (doPattStep(step_counter, patt_index[i], patt_start[i], patt_length[i]))
-                    {
-                        d_gates[i].setState(true);
-                    }
-                }
-                break;
-            case SSB_TBD:
-                break;
+            PATCHES[sketch_index].release();
+            sketch_index = next_sketch_index;
         }
+        dac_index = next_dac_index;
+        // Gate ratios are set from the controls before the dividers are
+        // clocked, a change keeps the phase. The dividers run for every
+        // patch, so a switch keeps the step counts.
+        PATCHES[sketch_index].update();
+        dividers.clock();
+        PATCHES[sketch_index].step();
     }
     else if (digitalRead(CLOCK_IN) == false)
     {
         // else go low when clock/gate goes low, note falling edge is 'lazy'
         // and will only be detected on next loop, not an interrupt.
         clock_state = false;
-        switch (sketch_index)
-        {
-            case SSB_SKIPPER:
-            case SSB_PRIME:
-            case SSB_PATT:
-                for (int i = 0; i < GATE_COUNT; i++)
-                {
-                    d_gates[i].setState(false);
-                }
-                break;
-            case SSB_TBD:
-                break;
-        } 
+        PATCHES[sketch_index].release();
     }
     for (int i = 0; i < GATE_COUNT; i++)
     {
         d_gates[i].render(DIG_PINS[i]);
     }
-    render_dac_bytes(step_counter, dac_index);
+    if (PATCHES[sketch_index].own_bits == false)
+    {
+        DAC_RENDERS[dac_index]();
+    }
+    readSerialCommand();
 }
 
 //  ==================== loop() END ===========================================
@@ -369,39 +473,52 @@ void loop()
 
 //  ==================== ssbSkipper Methods START =============================
 
-boolean doSkipStep(int current_step, int skip_step_i, bool rand_enabled, int rand_amt)
+void skipUpdate()
+{
+    for (int i = 0; i < GATE_COUNT; i++)
+    {
+        skip_step_rand_on[i] = getCtlHighLow(row_one_ctl[i]);
+        skip_step_index[i] = getCtlIndex(row_two_ctl[i], ALL_SKIP);
+        setRandAmt(i, getCtlIndex(expander_ctl[i], SKIP_MIN_RAND, SKIP_MAX_RAND));
+        dividers.setRatio(i, skip_step_index[i] + 1);
+    }
+}
+
+void skipStep()
+{
+    for (int i = 0; i < GATE_COUNT; i++)
+    {
+        if (!doSkipStep(dividers.isWrap(i), skip_step_index[i], skip_step_rand_on[i], skip_rand_thresh[i]))
+        {
+            d_gates[i].setState(true);
+        }
+    }
+}
+
+void setRandAmt(int gate, int rand_amt)
 {
+    // The threshold is only worked out when the control changes.
+    if (rand_amt != skip_step_rand_amt[gate])
+    {
+        skip_step_rand_amt[gate] = rand_amt;
+        skip_rand_thresh[gate] = ssbRandom::percentToThreshold(rand_amt);
+    }
+}
+
+boolean doSkipStep(bool is_wrap, int skip_step_i, bool rand_enabled, unsigned int rand_thresh)
+{
+    // is_wrap is true every (skip_step_i + 1) pulses.
     bool do_skip = false;
-    int step_mod = 0;
     if (skip_step_i > NO_SKIP)
     {
-        if (skip_step_i == ALL_SKIP)
+        if ((skip_step_i == ALL_SKIP) || (is_wrap == true))
         {
             do_skip = true;
-            if ((rand_enabled == true) and (random(0, 100) < rand_amt))
-            {
-                do_skip = !do_skip;
-            }
-        }
-        else
-        {
-            step_mod = (current_step + 1) % (skip_step_i + 1);
-            if (step_mod == 0)
-            {
-                do_skip = true;
-            }
-            if ((rand_enabled == true) and (random(0, 100) < rand_amt))
-            {
-                do_skip = !do_skip;
-            }
         }
     }
-    else
+    if ((rand_enabled == true) and (rand_gen.chance(rand_thresh) == true))
     {
-        if ((rand_enabled == true) and (random(0, 100) < rand_amt))
-        {
-            do_skip = !do_skip;
-        }
+        do_skip = !do_skip;
     }
     return do_skip;
 }
@@ -411,15 +528,32 @@ boolean doSkipStep(int current_step, int skip_step_i, bool rand_enabled, int ran
 
 //  ==================== ssbPrimeCounter Methods START ========================
 
-boolean doPrimeStep(int current_step, int prime_index, boolean step_invert)
+void primeUpdate()
+{
+    for (int i = 0; i < GATE_COUNT; i++)
+    {
+        prime_step_index[i] = getCtlIndex(row_one_ctl[i], PRIME_23);
+        prime_step_invert[i] = getCtlHighLow(row_two_ctl[i]);
+        // expander_ctl unused.
+        dividers.setRatio(i, PRIMES[prime_step_index[i]]);
+    }
+}
+
+void primeStep()
 {
-    boolean do_skip = false;
-    int prime_value = PRIMES[prime_index];
-    int step_mod = (current_step + 1) % (prime_value);
-    if (step_mod == 0)
+    for (int i = 0; i < GATE_COUNT; i++)
     {
-        do_skip = true;
+        if (doPrimeStep(dividers.isWrap(i), prime_step_invert[i]))
+        {
+            d_gates[i].setState(true);
+        }
     }
+}
+
+boolean doPrimeStep(bool is_wrap, boolean step_invert)
+{
+    // is_wrap is true every prime pulses.
+    boolean do_skip = is_wrap;
     if (step_invert == true)
     {
       do_skip = !do_skip;
@@ -432,95 +566,190 @@ boolean doPrimeStep(int current_step, int prime_index, boolean step_invert)
 
 //  ==================== ssbPatter Methods START ==============================
 
-boolean doPattStep(int current_step, int patt_index, int patt_start, int patt_len)
+void pattUpdate()
 {
-    boolean is_on = false;
-    int patt_max = PAT_STEPS;
-    int actual_step = 0;
-    if (patt_len < patt_max)
+    for (int i = 0; i < GATE_COUNT; i++)
     {
-        patt_max = patt_len;
+        patt_index[i] = getCtlIndex(row_one_ctl[i], (PAT_COUNT - 1));
+        patt_start[i] = getCtlIndex(row_two_ctl[i], PAT_SHIFT_MAX);
+        patt_length[i] = getCtlIndex(expander_ctl[i], PAT_MIN_LEN, PAT_MAX_LEN);
+        dividers.setRatio(i, min(patt_length[i], PAT_STEPS));
+        patt_mask[i] = pattMask(patt_index[i], patt_start[i], patt_length[i]);
     }
-    actual_step = (current_step % patt_max) - 1;
-    if (actual_step < 0)
+}
+
+void pattStep()
+{
+    for (int i = 0; i < GATE_COUNT; i++)
     {
-        actual_step = (patt_max-1);
+        if (doPattStep(lastStep(i), patt_mask[i]))
+        {
+            d_gates[i].setState(true);
+        }
     }
-    actual_step += (patt_start - 1);
-    if (actual_step >= patt_max)
+}
+
+/* pattMask
+ - Pattern cut to its length, then rotated right by the start inside the
+   length, so bit n is the cell played on step n of the cycle.
+*/
+byte pattMask(int patt_index, int patt_start, int patt_len)
+{
+    byte patt = pgm_read_byte(PATS + patt_index);
+    int patt_max = min(patt_len, PAT_STEPS);
+    byte len_mask = 0xFF;
+    if (patt_max < PAT_STEPS)
     {
-        actual_step = actual_step - patt_max;
+        len_mask = (1 << patt_max) - 1;
     }
-    if (PATS[patt_index][actual_step] == 1)
+    patt &= len_mask;
+    patt_start = patt_start % patt_max;
+    if (patt_start > 0)
     {
-        is_on = true;
+        patt = ((patt >> patt_start) | (patt << (patt_max - patt_start))) & len_mask;
     }
-    return is_on;
+    return patt;
+}
+
+boolean doPattStep(int current_step, byte patt_mask)
+{
+    // current_step is 0 - (length - 1), from the gate divider.
+    return (((patt_mask >> current_step) & 1) != 0);
 }
 
 //  ==================== ssbPatter Methods END ================================
 
 
-//  ==================== render_dac_bytes START ===============================
+//  ==================== ssbEuclid Methods START ==============================
+
+void euclidUpdate()
+{
+    int euc_steps = 0;
+    for (int i = 0; i < GATE_COUNT; i++)
+    {
+        // Only works out a new mask if a control changed.
+        euc_steps = getCtlIndex(row_two_ctl[i], EUC_MIN_STEPS, EUC_MAX_STEPS);
+        euc_lanes[i].setPattern(getCtlIndex(row_one_ctl[i], 0, euc_steps),
+                                euc_steps,
+                                getCtlIndex(expander_ctl[i], 0, (euc_steps - 1)));
+    }
+}
+
+void euclidStep()
+{
+    byte lane_bits = 0;
+    for (int i = 0; i < EUC_LANE_COUNT; i++)
+    {
+        if (euc_lanes[i].step() == true)
+        {
+            lane_bits |= (1 << i);
+            if (i < GATE_COUNT)
+            {
+                d_gates[i].setState(true);
+            }
+        }
+    }
+    expanderBitsOut(lane_bits);
+}
+
+void euclidRelease()
+{
+    gatesRelease();
+    expanderBitsOut(0);
+}
+
+//  ==================== ssbEuclid Methods END ================================
+
+
+//  ==================== Shared Methods START =================================
+
+void gatesRelease()
+{
+    for (int i = 0; i < GATE_COUNT; i++)
+    {
+        d_gates[i].setState(false);
+    }
+}
 
-void render_dac_bytes(int step_count, int render_type)
+/* readSerialCommand
+ - 'p' or 'o' and then a number (one character each). The switch is made
+   on the next clock pulse.
+*/
+void readSerialCommand()
 {
-    switch (render_type)
+    int value = 0;
+    if (Serial.available() > 0)
     {
-        case SSB_DAC_SEQ_SWITCH:
-            expanderGateBang((step_count % 8));
-            break;
-        case SSB_DAC_BYTE_CNT:
-            dacOutput((step_count % 1023));
-            break;
-        case SSB_DAC_PAT_CYCLE:
-            // Note we are using the same patterns as ssbPatter but as rows rather
-            // than cells.
-            step_count = step_count % 8;
-            for (int i = 0; i < PAT_STEPS; i++)
+        char c = (char)Serial.read();
+        if ((c == CMD_PATCH) || (c == CMD_DAC))
+        {
+            serial_cmd = c;
+        }
+        else if ((c >= '0') && (c <= '9') && (serial_cmd != CMD_NONE))
+        {
+            value = c - '0';
+            if ((serial_cmd == CMD_PATCH) && (value < PATCH_COUNT))
             {
-                if (PATS[step_count][i] == 1)
-                {
-                    byte_states[i] = true;
-                }
-                else
-                {
-                    byte_states[i] = false;
-                }
+                next_sketch_index = value;
             }
-            expanderGatesOut(byte_states[0], 
-                             byte_states[1], 
-                             byte_states[2], 
-                             byte_states[3], 
-                             byte_states[4], 
-                             byte_states[5], 
-                             byte_states[6], 
-                             byte_states[7]);
-            break;
-        case SSB_DAC_PULSE_DIV:
-            int mod_index = 0;
-            for (int i = 0; i < PAT_STEPS; i++)
+            else if ((serial_cmd == CMD_DAC) && (value < DAC_TYPES))
             {
-                // only care about on bits, all are off now.
-                //
-                mod_index = step_count % i;
-                if (mod_index == 0)
-                {
-                    byte_states[i] = true;
-                }
-                else
-                {
-                    byte_states[i] = false;
-                }
+                next_dac_index = value;
             }
-            expanderGatesOut(byte_states[0], 
-                             byte_states[1], 
-                             byte_states[2], 
-                             byte_states[3], 
-                             byte_states[4], 
-                             byte_states[5], 
-                             byte_states[6], 
-                             byte_states[7]);
-            break;
+            serial_cmd = CMD_NONE;
+        }
+        else
+        {
+            serial_cmd = CMD_NONE;
+        }
     }
 }
+
+//  ==================== Shared Methods END ===================================
+
+
+//  ==================== lastStep START =======================================
+
+int lastStep(byte output)
+{
+    // Step just played, 0 on the first pulse of a cycle. The divider
+    // position is 1 on the first pulse and 0 on the last (the wrap).
+    int step_index = dividers.getPosition(output);
+    if (step_index == 0)
+    {
+        step_index = dividers.getRatio(output);
+    }
+    return (step_index - 1);
+}
+
+//  ==================== lastStep END =========================================
+
+
+//  ==================== Output Type Methods START ============================
+
+void renderSeqSwitch()
+{
+    expanderGateBang(lastStep(DIV_STEP_8));
+}
+
+void renderByteCount()
+{
+    dacOutput(lastStep(DIV_BYTE_CNT));
+}
+
+void renderPattCycle()
+{
+    // Note we are using the same patterns as ssbPatter but as rows rather
+    // than cells. Bit n of the pattern is expander bit n.
+    expanderBitsOut(pgm_read_byte(PATS + lastStep(DIV_PAT_CYCLE)));
+}
+
+void renderPulseDiv()
+{
+    // Bit i is on every (i + 1) pulses, the wrap bits of the pulse
+    // dividers are the byte.
+    unsigned int wraps = dividers.getWraps() >> DIV_PULSE;
+    expanderBitsOut(wraps & 0xFF);
+}
+
+//  ==================== Output Type Methods END ==============================
@@ -30,13 +30,22 @@ Description:
         Bits 0-7:        Step Counter. On each clcok pulse, will advance from 0 to 7 and reset.
         Analog Out 11:   Unused
         Digital Out 13:  Unused
-    Serial:              Unused (debug)
+    Serial:              Trace events (debug, see below)
 
     Created:  Feb 7 2015 by Peter Fawcett (SoundSweepsBy).
         Version 1 - Original patch developement.
         Version 2 - Sept. 7 2015:
           Updated to use ssbLib code.
           Fixed bugs.
+        Version 3 - Oct 18 2026:
+          Debugging is traced (ssbDebug trace mode) rather than printed, so
+          serial output no longer holds up the clock. Decode the output with
+          hostTest/traceDecode/traceDecode.py.
+        Version 4 - Oct 18 2026:
+          Debugging uses compile time levels (ssbDebugLevel).
+        Version 5 - Oct 18 2026:
+          The random skip uses ssbRandom (xorshift) rather than random(), with
+          the weight worked out into a threshold only when A4/A5 change.
 
     ============================================================
 
@@ -56,8 +65,21 @@ Description:
 
 #include <ssbArdBase.h>
 #include <ssbGate.h>
+#include <ssbRandom.h>
 // DEBUGGING
-//#include <ssbDebug.h>
+// Set to SSB_LEVEL_INFO or SSB_LEVEL_VERBOSE to enable debug output. Debug
+// calls above the level are not compiled in.
+#define SSB_DEBUG_LEVEL SSB_LEVEL_OFF
+#include <ssbDebugLevel.h>
+
+// Trace events (binary, over serial at 9600). Decode with:
+//   traceDecode.py /dev/ttyUSB0 --names 1=clock,2=gate0,3=gate1,4=outputs
+const byte  TRACE_CLOCK                     = 1;    // INFO. Clock edge, value: step.
+const byte  TRACE_GATE                      = 2;    // INFO. Gate 0/1 (id + gate), value:
+                                                    //   skip index << 8 | rand on << 1 | skipped.
+const byte  TRACE_OUTPUTS                   = 4;    // VERBOSE. Gate is on / active changed, value:
+                                                    //   active 1 << 3 | on 1 << 2 | active 0 << 1 | on 0.
+const byte  TRACE_SIZE                      = 32;   // Events buffered, a power of 2.
 
 const int   SKIP_TYPES                      = 8;
 const int   NO_SKIP                         = 0;
@@ -78,12 +100,16 @@ int         skip_rand_on_ctl[GATE_COUNT]    = {A0_INPUT, A1_INPUT};
 int         skip_step_ctl[GATE_COUNT]       = {A2_INPUT, A3_INPUT};
 int         skip_rand_amt_ctl[GATE_COUNT]   = {A4_INPUT, A5_INPUT};
 bool        skip_step_rand_on[GATE_COUNT]   = {false, false};
-int         skip_step_rand_amt[GATE_COUNT]  = {0, 0};
+int         skip_step_rand_amt[GATE_COUNT]  = {-1, -1};
+unsigned int skip_rand_thresh[GATE_COUNT]   = {0, 0};      // Rand amt as a chance in 256.
+ssbRandom   rand_gen                        = ssbRandom();
 int         skip_step_index[GATE_COUNT]     = {0, 0};
 ssbGate     d_gates[GATE_COUNT]             = {ssbGate(), ssbGate()};
 
 //DEBUGGING:
-//ssbDebug    DEBUG                           = ssbDebug();
+SSB_DEBUG(ssbDebug    DEBUG                 = ssbDebug();)
+SSB_DEBUG(ssbTraceEvent trace_buf[TRACE_SIZE];)
+SSB_DEBUG_VERBOSE(int last_outputs          = -1;)
 
 //  ==================== setup() START ======================
 //
@@ -92,7 +118,7 @@ ssbGate     d_gates[GATE_COUNT]             = {ssbGate(), ssbGate()};
 //
 void setup()
 {
-    randomSeed(millis());
+    rand_gen.seedFromNoise(A5_INPUT);
     // set up the digital outputs
     for (int i = 0; i < 2; i++)
     {
@@ -107,8 +133,8 @@ void setup()
     }
     setClockInterrupt();
     // Debugging
-    //DEBUG.enableSerial();
-    //DEBUG.debugState(true);
+    SSB_DEBUG(DEBUG.enableSerial());
+    SSB_DEBUG(DEBUG.enableTrace(trace_buf, TRACE_SIZE));
 }
 //  ==================== setup() END =======================
 
@@ -125,25 +151,22 @@ void loop()
     {
         // We have a leading edge of a clock pulse.
         step_counter++;
+        SSB_DEBUG_INFO(DEBUG.traceEvent(TRACE_CLOCK, (int)step_counter));
         for (int i = 0; i < GATE_COUNT; i++)
         {
+            bool skipped;
             skip_step_index[i] = getCtlIndex(skip_step_ctl[i], ALL_SKIP);
             skip_step_rand_on[i] = getCtlHighLow(skip_rand_on_ctl[i]);
-            skip_step_rand_amt[i] = getCtlIndex(skip_rand_amt_ctl[i], 10, 90);
-            if (!doSkipStep(step_counter, skip_step_index[i], skip_step_rand_on[i], skip_step_rand_amt[i]))
+            setRandAmt(i, getCtlIndex(skip_rand_amt_ctl[i], 10, 90));
+            skipped = doSkipStep(step_counter, skip_step_index[i], skip_step_rand_on[i], skip_rand_thresh[i]);
+            if (!skipped)
             {
                 d_gates[i].setState(true);
             }
             // Debugging
-            //DEBUG.debugValue("Gate Index:", i);
-            //DEBUG.debugValue("Skip Step Index:", skip_step_index[i]);
-            //DEBUG.debugValue("Skip Step Rand On:", skip_step_rand_on[i]);
-            //DEBUG.debugValue("Skip Step Rand Amt:", skip_step_rand_amt[i]);
-            //DEBUG.debugValue("Gate Is On:", d_gates[i].isOn());
-            //DEBUG.debugValue("Gate Is Active:", d_gates[i].isActive());
+            SSB_DEBUG_INFO(DEBUG.traceEvent(TRACE_GATE + i, (skip_step_index[i] << 8) |
+                                                            (skip_step_rand_on[i] << 1) | skipped));
         }
-        // Debugging
-        //DEBUG.updateTicks();
     }
     else if (digitalRead(CLOCK_IN) == false)
     {
@@ -157,12 +180,40 @@ void loop()
     {
         d_gates[i].render(DIG_PINS[i]);
     }
-    //DEBUG.debugValue("Step Counter:", step_counter);
-    //DEBUG.debugValue("Step Counter % 8:", (step_counter % 8));
     expanderGateBang((step_counter % 8));
+    // Debugging
+    SSB_DEBUG_VERBOSE(traceOutputs());
+    SSB_DEBUG(DEBUG.flushTrace());
+}
+
+#if SSB_DEBUG_LEVEL >= SSB_LEVEL_VERBOSE
+// Trace the gate states when they change (every loop would fill the buffer).
+void traceOutputs()
+{
+    int outputs = 0;
+    for (int i = 0; i < GATE_COUNT; i++)
+    {
+        outputs |= (d_gates[i].isOn() << (i * 2)) | (d_gates[i].isActive() << ((i * 2) + 1));
+    }
+    if (outputs != last_outputs)
+    {
+        last_outputs = outputs;
+        DEBUG.traceEvent(TRACE_OUTPUTS, outputs);
+    }
+}
+#endif
+
+void setRandAmt(int gate, int rand_amt)
+{
+    // The threshold is only worked out when the control changes.
+    if (rand_amt != skip_step_rand_amt[gate])
+    {
+        skip_step_rand_amt[gate] = rand_amt;
+        skip_rand_thresh[gate] = ssbRandom::percentToThreshold(rand_amt);
+    }
 }
 
-bool doSkipStep(int current_step, int skip_step_i, bool rand_enabled, int rand_amt)
+bool doSkipStep(int current_step, int skip_step_i, bool rand_enabled, unsigned int rand_thresh)
 {
     bool do_skip = false;
     int step_mod = 0;
@@ -171,7 +222,7 @@ bool doSkipStep(int current_step, int skip_step_i, bool rand_enabled, int rand_a
         if (skip_step_i == ALL_SKIP)
         {
             do_skip = true;
-            if ((rand_enabled == true) and (random(0, 100) < rand_amt))
+            if ((rand_enabled == true) and (rand_gen.chance(rand_thresh) == true))
             {
                 do_skip = !do_skip;
             }
@@ -183,7 +234,7 @@ bool doSkipStep(int current_step, int skip_step_i, bool rand_enabled, int rand_a
             {
                 do_skip = true;
             }
-            if ((rand_enabled == true) and (random(0, 100) < rand_amt))
+            if ((rand_enabled == true) and (rand_gen.chance(rand_thresh) == true))
             {
                 do_skip = !do_skip;
             }
@@ -191,7 +242,7 @@ bool doSkipStep(int current_step, int skip_step_i, bool rand_enabled, int rand_a
     }
     else
     {
-        if ((rand_enabled == true) and (random(0, 100) < rand_amt))
+        if ((rand_enabled == true) and (rand_gen.chance(rand_thresh) == true))
         {
             do_skip = !do_skip;
         }
@@ -0,0 +1,96 @@
+/*
+Program: ssbWaveOsc
+Description:
+    A wavetable oscillator. The DAC is written from a Timer1 interrupt at
+    16kHz (ssbOscillator), so the DAC out is an audio rate (lo-fi, 8 bit)
+    oscillator or, with the octave knob turned down, an LFO.
+    A2 is a 1v/oct pitch input, quantized to semitones (C3 - C8 with the
+    octave knob at 0). A0 moves the pitch down by up to 7 octaves. At 7
+    octaves down the oscillator is an LFO of about 1 - 33Hz. A1 selects
+    the wave (sine, triangle, saw, square). A rising edge on the clock
+    input restarts the wave (hard sync, or LFO reset).
+
+    Note: the interrupt owns the DAC pins and Timer1. Do not add dacOutput
+    calls or anything else that uses Timer1 (ssbProfile) to this patch.
+
+    I/O Usage:
+        Knob A0:         Octave down (0 - 7)
+        Knob A1:         Wave (sine, triangle, saw, square)
+        Knob/Jack A2:    Pitch (1v/oct, quantized)
+        Knob/Jack A3:    Unused
+        Digital Out 1:   Unused
+        Digital Out 2:   Unused
+        Clock In:        Sync / reset
+        Analog Out:      Oscillator out
+    Input Expander:
+        Knob A4/Jack A4: Unused
+        Knob A5/Jack A5: Unused
+    Output Expander:
+        Bits 0-7:        Oscillator out (the same bits as the DAC)
+        Analog Out 11:   Unused
+        Digital Out 13:  Unused (interrupt timing, see ssbOscillator.cpp)
+    Serial:              Unused
+
+    Created:  Oct 18 2026 by Peter Fawcett (SoundSweepsBy).
+        Version 1 - Original patch developement.
+
+    ============================================================
+
+    License:
+
+    This software is licensed under the Creative Commons
+    "Attribution-NonCommercial license. This license allows you
+    to tweak and build upon the code for non-commercial purposes,
+    without the requirement to license derivative works on the
+    same terms. If you wish to use this (or derived) work for
+    commercial work, please contact Peter Fawcett at our website
+    (www.SoundSweepsBy.com).
+    
+    For more information on the Creative Commons CC BY-NC license,
+    visit http://creativecommons.org/licenses/
+*/
+
+#include <ssbArdBase.h>
+#include <ssbScales.h>
+#include <ssbWaves.h>
+#include <ssbOscillator.h>
+
+ssbOscillator   OSC             = ssbOscillator(WAVE_SINE_ID);
+
+//  ==================== setup() START ======================
+//
+//  Setup patch. Enable state of pins as needed.
+//  This code will run once at start of patch, right after load.
+//
+void setup()
+{
+    // set up the digital outputs
+    for (int i = 0; i < GATE_COUNT; i++)
+    {
+        pinMode(DIG_PINS[i], OUTPUT);
+        digitalWrite(DIG_PINS[i], LOW);
+    }
+    setClockInterrupt();
+    // Sets the DAC pins to output and starts the interrupt.
+    OSC.begin();
+}
+//  ==================== setup() END =======================
+
+//  ==================== loop() START =======================
+//
+//  Master Loop.
+//  Loop will be called over and over with out pause.
+//  Main logic of patch.
+//  The interrupt writes the DAC, the loop only sets the pitch and wave.
+//
+void loop()
+{
+    if (readClockState())
+    {
+        OSC.resetPhase();
+    }
+    OSC.setOctaveDown(getCtlIndex(A0_INPUT, OSC_LFO_OCTAVES));
+    OSC.setWave(getCtlIndex(A1_INPUT, WAVE_COUNT - 1));
+    OSC.setPitch(analogRead(A2_INPUT));
+}
+//  ==================== loop() END =======================